@@ -33,6 +33,8 @@
 #include "nodegl.h"
 #include "nodes.h"
 #include "glcontext.h"
+#include "stats.h"
+#include "utils.h"
 
 struct ngl_ctx *ngl_create(void)
 {
@@ -40,6 +42,26 @@ struct ngl_ctx *ngl_create(void)
     if (!s)
         return NULL;
 
+    s->glpool.max_size = NGLI_GLPOOL_DEFAULT_MAX_SIZE;
+
+    if (ngli_updatequeue_init(&s->updatequeue) < 0) {
+        free(s);
+        return NULL;
+    }
+
+    if (ngli_drawahead_init(&s->drawahead) < 0) {
+        ngli_updatequeue_reset(&s->updatequeue);
+        free(s);
+        return NULL;
+    }
+
+    if (ngli_preload_init(&s->preload) < 0) {
+        ngli_drawahead_reset(s);
+        ngli_updatequeue_reset(&s->updatequeue);
+        free(s);
+        return NULL;
+    }
+
     LOG(INFO, "Context create in node.gl v%d.%d.%d",
         NODEGL_VERSION_MAJOR, NODEGL_VERSION_MINOR, NODEGL_VERSION_MICRO);
     return s;
@@ -65,10 +87,20 @@ int ngl_set_glcontext(struct ngl_ctx *s, void *display, void *window, void *hand
 
 int ngl_set_scene(struct ngl_ctx *s, struct ngl_node *scene)
 {
+    ngli_drawahead_wait(s);
+
+    /* The queued updates target nodes of the current scene */
+    ngli_updatequeue_apply(s);
+
     if (s->scene) {
         ngli_node_detach_ctx(s->scene);
         ngl_node_unrefp(&s->scene);
     }
+    ngli_updatequeue_purge(s);
+    s->nb_eval_nodes = 0;
+
+    if (!scene)
+        return 0;
 
     int ret = ngli_node_attach_ctx(scene, s);
     if (ret < 0)
@@ -94,15 +126,54 @@ int ngli_prepare_draw(struct ngl_ctx *s, double t)
         return -1;
     }
 
+    int ret = ngli_drawahead_wait(s);
+    if (ret < 0)
+        return ret;
+
+    /* The nodes evaluated ahead for this frame may depend on the updated parameters */
+    if (ngli_updatequeue_apply(s) > 0)
+        for (int i = 0; i < s->nb_eval_nodes; i++)
+            s->eval_nodes[i]->last_eval_time = -1.;
+
     LOG(DEBUG, "prepare scene %s @ t=%f", scene->name, t);
 
+    s->frame_start = ngli_gettime();
+    s->nb_frame_prefetches = 0;
+    s->frame_budget_stats.nb_deferred = 0;
+    s->frame_budget_stats.nb_skipped = 0;
+
+    if (s->stats.enabled)
+        ngli_stats_begin_frame(&s->stats);
+
+#ifdef CONFIG_GL_STATS
+    ngli_glstats_reset(&glcontext->stats);
+#endif
+
+    ngli_gpumem_begin_frame(&s->gpumem);
+
     ngli_glClear(gl, GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 
-    int ret = ngli_node_visit(scene, 1, t);
+    s->nb_eval_nodes = 0;
+    s->nb_started_ahead = 0;
+    ret = ngli_node_visit(scene, 1, t);
+    if (ret < 0)
+        return ret;
+
+    if (s->stats.enabled)
+        ngli_stats_end_stage(&s->stats, NGLI_STATS_STAGE_VISIT);
+
+    ret = ngli_node_honor_release_prefetch_budget(scene, t);
     if (ret < 0)
         return ret;
 
-    ret = ngli_node_honor_release_prefetch(scene, t);
+    if (ngli_gpumem_over_budget(&s->gpumem))
+        ngli_glpool_trim(s, 0);
+    ngli_gpumem_evict(&s->gpumem);
+
+    if (s->stats.enabled)
+        ngli_stats_end_stage(&s->stats, NGLI_STATS_STAGE_PREFETCH);
+
+    ret = ngli_node_evaluate_all(s, t);
     if (ret < 0)
         return ret;
 
@@ -110,17 +181,39 @@ int ngli_prepare_draw(struct ngl_ctx *s, double t)
     if (ret < 0)
         return ret;
 
+    if (s->stats.enabled)
+        ngli_stats_end_stage(&s->stats, NGLI_STATS_STAGE_UPDATE);
+
     return 0;
 }
 
 int ngl_draw(struct ngl_ctx *s, double t)
 {
+    const int64_t start = ngli_gettime();
+
     int ret = ngli_prepare_draw(s, t);
     if (ret < 0)
         goto end;
 
+    ret = ngli_drawahead_start(s, t);
+    if (ret < 0)
+        goto end;
+
     LOG(DEBUG, "draw scene %s @ t=%f", s->scene->name, t);
     ngli_node_draw(s->scene);
+    ngli_memorybarrier_flush(s);
+
+    const int64_t frame_time = ngli_gettime() - start;
+    struct ngl_frame_budget_stats *fb = &s->frame_budget_stats;
+    fb->nb_frames++;
+    fb->max_frame_time = NGLI_MAX(fb->max_frame_time, frame_time);
+    if (s->frame_budget && frame_time > s->frame_budget)
+        fb->nb_late_frames++;
+
+    if (s->stats.enabled) {
+        ngli_stats_end_stage(&s->stats, NGLI_STATS_STAGE_DRAW);
+        s->stats.frame_time = frame_time;
+    }
 
 end:
     if (ret == 0 && ngli_glcontext_check_gl_error(s->glcontext))
@@ -128,6 +221,112 @@ end:
     return ret;
 }
 
+int ngl_read_pixels(struct ngl_ctx *s, int x, int y, int width, int height, void *dst)
+{
+    struct glcontext *glcontext = s->glcontext;
+
+    if (!glcontext || !glcontext->loaded) {
+        LOG(ERROR, "glcontext not loaded");
+        return -1;
+    }
+
+    if (width <= 0 || height <= 0) {
+        LOG(ERROR, "invalid read back area %dx%d", width, height);
+        return -1;
+    }
+
+    const struct glfunctions *gl = &glcontext->funcs;
+    ngli_glReadPixels(gl, x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, dst);
+    return ngli_glcontext_check_gl_error(glcontext) ? -1 : 0;
+}
+
+int ngl_set_draw_times(struct ngl_ctx *s, const double *times, int nb_times)
+{
+    return ngli_drawahead_set_times(s, times, nb_times);
+}
+
+int ngl_set_update_threads(struct ngl_ctx *s, int nb_threads)
+{
+    if (nb_threads < 0) {
+        LOG(ERROR, "invalid number of update threads: %d", nb_threads);
+        return -1;
+    }
+    ngli_drawahead_wait(s);
+    s->nb_update_threads = nb_threads;
+    ngli_threadpool_freep(&s->threadpool);
+    return 0;
+}
+
+int ngl_set_profiling(struct ngl_ctx *s, int enable)
+{
+    s->stats.enabled = !!enable;
+    return 0;
+}
+
+int ngl_get_stats(struct ngl_ctx *s, struct ngl_stats *stats)
+{
+    return ngli_stats_get(&s->stats, stats);
+}
+
+int ngl_set_memory_budget(struct ngl_ctx *s, int64_t budget)
+{
+    if (budget < 0) {
+        LOG(ERROR, "GPU memory budget can not be negative (0 means unlimited)");
+        return -1;
+    }
+    s->gpumem.budget = budget;
+    return 0;
+}
+
+int ngl_set_resource_pool_size(struct ngl_ctx *s, int64_t max_size)
+{
+    if (max_size < 0) {
+        LOG(ERROR, "resource pool size can not be negative (0 disables the pool)");
+        return -1;
+    }
+    s->glpool.max_size = max_size;
+    if (s->glcontext)
+        ngli_glpool_trim(s, max_size);
+    return 0;
+}
+
+int ngl_get_memory_stats(struct ngl_ctx *s, struct ngl_memory_stats *stats)
+{
+    ngli_gpumem_get(&s->gpumem, stats);
+    stats->pool_size = s->glpool.size;
+    stats->nb_pooled = s->glpool.nb_entries;
+    stats->pool_hits = s->glpool.nb_hits;
+    stats->pool_misses = s->glpool.nb_misses;
+    return 0;
+}
+
+int ngl_set_frame_budget(struct ngl_ctx *s, int64_t budget, int skip)
+{
+    if (budget < 0) {
+        LOG(ERROR, "frame budget can not be negative (0 means unlimited)");
+        return -1;
+    }
+    s->frame_budget = budget;
+    s->frame_budget_skip = !!skip;
+    s->frame_budget_stats.budget = budget;
+    return 0;
+}
+
+int ngl_get_frame_budget_stats(struct ngl_ctx *s, struct ngl_frame_budget_stats *stats)
+{
+    *stats = s->frame_budget_stats;
+    return 0;
+}
+
+int ngl_get_gl_stats(struct ngl_ctx *s, struct ngl_gl_stats *stats)
+{
+    if (!s->glcontext) {
+        LOG(ERROR, "glcontext not set");
+        return -1;
+    }
+    return ngli_glcontext_get_stats(s->glcontext, stats);
+}
+
 void ngl_free(struct ngl_ctx **ss)
 {
     struct ngl_ctx *s = *ss;
@@ -135,10 +334,22 @@ void ngl_free(struct ngl_ctx **ss)
     if (!s)
         return;
 
+    ngli_drawahead_reset(s);
     if (s->scene) {
         ngli_node_detach_ctx(s->scene);
         ngl_node_unrefp(&s->scene);
     }
+    ngli_updatequeue_reset(&s->updatequeue);
+    ngli_preload_reset(s);
+    ngli_stats_reset(&s->stats);
+    if (s->glcontext) {
+        ngli_buffercache_reset(s);
+        ngli_transient_reset(s);
+        ngli_glpool_reset(s);
+    }
+    ngli_gpumem_reset(&s->gpumem);
+    ngli_threadpool_freep(&s->threadpool);
+    free(s->eval_nodes);
     ngli_glcontext_freep(&s->glcontext);
     ngli_glstate_freep(&s->glstate);
     free(*ss);
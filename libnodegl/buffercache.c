@@ -0,0 +1,124 @@
+/*
+ * Copyright 2018 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "buffercache.h"
+#include "glcontext.h"
+#include "hmap.h"
+#include "log.h"
+#include "nodes.h"
+
+/* 64-bit FNV-1a */
+static uint64_t get_data_hash(const uint8_t *data, int size)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (int i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+static void entry_free(void *user_arg, void *data)
+{
+    struct ngl_ctx *ctx = user_arg;
+    struct buffercache_entry *entry = data;
+    const struct glfunctions *gl = &ctx->glcontext->funcs;
+
+    ngli_glDeleteBuffers(gl, 1, &entry->buffer_id);
+    ngli_gpumem_free(&ctx->gpumem, NGLI_GPUMEM_BUFFER, entry->size);
+    free(entry->data);
+    free(entry);
+}
+
+struct buffercache_entry *ngli_buffercache_acquire(struct ngl_ctx *ctx, const void *data,
+                                                   int size, GLenum usage)
+{
+    if (!ctx->buffer_cache) {
+        ctx->buffer_cache = ngli_hmap_create();
+        if (!ctx->buffer_cache)
+            return NULL;
+        ngli_hmap_set_free(ctx->buffer_cache, entry_free, ctx);
+    }
+
+    struct buffercache_entry *entry;
+    char key[sizeof(entry->key)];
+    snprintf(key, sizeof(key), "%016" PRIx64 "-%d-%x", get_data_hash(data, size), size, usage);
+
+    entry = ngli_hmap_get(ctx->buffer_cache, key);
+    if (entry) {
+        /* On a hash collision, the caller falls back on a private buffer */
+        if (entry->size != size || memcmp(entry->data, data, size))
+            return NULL;
+        entry->refcount++;
+        return entry;
+    }
+
+    entry = calloc(1, sizeof(*entry));
+    if (!entry)
+        return NULL;
+
+    entry->data = malloc(size);
+    if (!entry->data) {
+        free(entry);
+        return NULL;
+    }
+    memcpy(entry->data, data, size);
+    memcpy(entry->key, key, sizeof(key));
+    entry->size = size;
+    entry->refcount = 1;
+
+    const struct glfunctions *gl = &ctx->glcontext->funcs;
+    ngli_glGenBuffers(gl, 1, &entry->buffer_id);
+    ngli_glBindBuffer(gl, GL_ARRAY_BUFFER, entry->buffer_id);
+    ngli_glBufferData(gl, GL_ARRAY_BUFFER, size, data, usage);
+    ngli_glBindBuffer(gl, GL_ARRAY_BUFFER, 0);
+    ngli_gpumem_alloc(&ctx->gpumem, NGLI_GPUMEM_BUFFER, size);
+
+    if (ngli_hmap_set(ctx->buffer_cache, key, entry) < 0) {
+        entry_free(ctx, entry);
+        return NULL;
+    }
+
+    return entry;
+}
+
+void ngli_buffercache_release(struct ngl_ctx *ctx, struct buffercache_entry **entryp)
+{
+    struct buffercache_entry *entry = *entryp;
+    if (!entry)
+        return;
+
+    if (--entry->refcount == 0)
+        ngli_hmap_set(ctx->buffer_cache, entry->key, NULL);
+    *entryp = NULL;
+}
+
+void ngli_buffercache_reset(struct ngl_ctx *ctx)
+{
+    if (ctx->buffer_cache && ngli_hmap_count(ctx->buffer_cache))
+        LOG(WARNING, "%d shared buffers still referenced", ngli_hmap_count(ctx->buffer_cache));
+    ngli_hmap_freep(&ctx->buffer_cache);
+}
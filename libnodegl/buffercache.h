@@ -0,0 +1,48 @@
+/*
+ * Copyright 2018 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef BUFFERCACHE_H
+#define BUFFERCACHE_H
+
+#include <stdint.h>
+
+#include "glincludes.h"
+
+struct ngl_ctx;
+
+/*
+ * Content-addressed cache of read-only GL buffers: buffers created with the
+ * same data and usage share the same GL buffer
+ */
+struct buffercache_entry {
+    char key[48];
+    GLuint buffer_id;
+    int refcount;
+    int size;
+    uint8_t *data;
+};
+
+struct buffercache_entry *ngli_buffercache_acquire(struct ngl_ctx *ctx, const void *data,
+                                                   int size, GLenum usage);
+void ngli_buffercache_release(struct ngl_ctx *ctx, struct buffercache_entry **entryp);
+void ngli_buffercache_reset(struct ngl_ctx *ctx);
+
+#endif /* BUFFERCACHE_H */
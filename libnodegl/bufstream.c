@@ -0,0 +1,149 @@
+/*
+ * Copyright 2018 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+
+#include "bufstream.h"
+#include "glcontext.h"
+#include "log.h"
+#include "nodes.h"
+
+/*
+ * Alignment of the regions, large enough to honor the offset alignment
+ * required when binding a region as a shader storage or uniform buffer
+ */
+#define REGION_ALIGN 256
+
+/* Maximum time waiting for the GPU to release a region, in nanoseconds */
+#define WAIT_TIMEOUT 1000000000
+
+static int64_t get_gpu_size(const struct bufstream *s)
+{
+    return s->mapped ? (int64_t)s->region_size * NGLI_BUFSTREAM_NB_REGIONS : s->size;
+}
+
+int ngli_bufstream_init(struct bufstream *s, struct ngl_ctx *ctx, GLenum target,
+                        const void *data, int size, GLenum usage)
+{
+    struct glcontext *glcontext = ctx->glcontext;
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    s->ctx = ctx;
+    s->target = target;
+    s->usage = usage;
+    s->size = size;
+
+    ngli_glGenBuffers(gl, 1, &s->buffer_id);
+    ngli_glBindBuffer(gl, target, s->buffer_id);
+
+    if (glcontext->features & NGLI_FEATURE_BUFFER_STORAGE) {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+        s->region_size = (size + REGION_ALIGN - 1) & ~(REGION_ALIGN - 1);
+        const int total_size = s->region_size * NGLI_BUFSTREAM_NB_REGIONS;
+        ngli_glBufferStorage(gl, target, total_size, NULL, flags);
+        s->mapped = ngli_glMapBufferRange(gl, target, 0, total_size, flags);
+        if (!s->mapped) {
+            LOG(ERROR, "unable to map streaming buffer");
+            ngli_glBindBuffer(gl, target, 0);
+            ngli_glDeleteBuffers(gl, 1, &s->buffer_id);
+            return -1;
+        }
+        for (int i = 0; i < NGLI_BUFSTREAM_NB_REGIONS; i++)
+            memcpy(s->mapped + i * s->region_size, data, size);
+    } else {
+        ngli_glBufferData(gl, target, size, data, usage);
+    }
+
+    ngli_glBindBuffer(gl, target, 0);
+    ngli_gpumem_alloc(&ctx->gpumem, NGLI_GPUMEM_BUFFER, get_gpu_size(s));
+
+    return 0;
+}
+
+/*
+ * The stream only leaves its current region when it is written again: the
+ * draws reading this region have all been submitted at this point, so a
+ * fence inserted now is signaled once the GPU is done with it. The region
+ * written next is the one left two writes ago, and its fence is waited on
+ * before it is overwritten, whatever the number of frames since then.
+ */
+static void write_region(struct bufstream *s, const void *data)
+{
+    const struct glfunctions *gl = &s->ctx->glcontext->funcs;
+
+    if (s->fences[s->region])
+        ngli_glDeleteSync(gl, s->fences[s->region]);
+    s->fences[s->region] = ngli_glFenceSync(gl, GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    s->region = (s->region + 1) % NGLI_BUFSTREAM_NB_REGIONS;
+
+    GLsync fence = s->fences[s->region];
+    if (fence) {
+        const GLenum ret = ngli_glClientWaitSync(gl, fence, GL_SYNC_FLUSH_COMMANDS_BIT, WAIT_TIMEOUT);
+        if (ret == GL_TIMEOUT_EXPIRED || ret == GL_WAIT_FAILED)
+            LOG(ERROR, "unable to wait for the streaming buffer region %d", s->region);
+        ngli_glDeleteSync(gl, fence);
+        s->fences[s->region] = NULL;
+    }
+
+    s->offset = s->region * s->region_size;
+    memcpy(s->mapped + s->offset, data, s->size);
+}
+
+void ngli_bufstream_write(struct bufstream *s, const void *data)
+{
+    if (s->mapped) {
+        write_region(s, data);
+        return;
+    }
+
+    /*
+     * Orphan the previous storage so the driver does not have to wait for the
+     * GPU to be done with it before uploading the new data
+     */
+    const struct glfunctions *gl = &s->ctx->glcontext->funcs;
+    ngli_glBindBuffer(gl, s->target, s->buffer_id);
+    ngli_glBufferData(gl, s->target, s->size, NULL, s->usage);
+    ngli_glBufferSubData(gl, s->target, 0, s->size, data);
+    ngli_glBindBuffer(gl, s->target, 0);
+}
+
+void ngli_bufstream_reset(struct bufstream *s)
+{
+    if (!s->ctx)
+        return;
+
+    const struct glfunctions *gl = &s->ctx->glcontext->funcs;
+
+    if (s->mapped) {
+        ngli_glBindBuffer(gl, s->target, s->buffer_id);
+        ngli_glUnmapBuffer(gl, s->target);
+        ngli_glBindBuffer(gl, s->target, 0);
+    }
+    for (int i = 0; i < NGLI_BUFSTREAM_NB_REGIONS; i++)
+        if (s->fences[i])
+            ngli_glDeleteSync(gl, s->fences[i]);
+    ngli_glDeleteBuffers(gl, 1, &s->buffer_id);
+    ngli_gpumem_free(&s->ctx->gpumem, NGLI_GPUMEM_BUFFER, get_gpu_size(s));
+
+    memset(s, 0, sizeof(*s));
+}
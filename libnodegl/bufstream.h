@@ -0,0 +1,55 @@
+/*
+ * Copyright 2018 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef BUFSTREAM_H
+#define BUFSTREAM_H
+
+#include <stdint.h>
+
+#include "glincludes.h"
+
+/*
+ * Number of regions of a persistently mapped streaming buffer: the CPU writes
+ * into one region while the GPU may still be reading the two previous ones.
+ */
+#define NGLI_BUFSTREAM_NB_REGIONS 3
+
+struct ngl_ctx;
+
+struct bufstream {
+    struct ngl_ctx *ctx;
+    GLenum target;
+    GLenum usage;
+    GLuint buffer_id;
+    int size;
+    int region_size;
+    uint8_t *mapped;    // persistent mapping, or NULL when orphaning is used
+    int region;         // region of the last written data
+    int offset;         // offset of the last written data in the GL buffer
+    GLsync fences[NGLI_BUFSTREAM_NB_REGIONS]; // signaled once the GPU is done reading each region
+};
+
+int ngli_bufstream_init(struct bufstream *s, struct ngl_ctx *ctx, GLenum target,
+                        const void *data, int size, GLenum usage);
+void ngli_bufstream_write(struct bufstream *s, const void *data);
+void ngli_bufstream_reset(struct bufstream *s);
+
+#endif /* BUFSTREAM_H */
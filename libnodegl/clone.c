@@ -0,0 +1,163 @@
+/*
+ * Copyright 2018 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hmap.h"
+#include "log.h"
+#include "nodegl.h"
+#include "nodes.h"
+#include "params.h"
+
+extern const struct node_param ngli_base_node_params[];
+extern const struct param_specs ngli_params_specs[];
+
+static struct ngl_node *clone_node(struct hmap *clones, const struct ngl_node *node);
+
+static int clone_params(struct hmap *clones, uint8_t *dst, const uint8_t *src,
+                        const struct node_param *par)
+{
+    while (par && par->key) {
+        const uint8_t *srcp = src + par->offset;
+        uint8_t *dstp = dst + par->offset;
+        int ret = 0;
+
+        switch (par->type) {
+            case PARAM_TYPE_STR: {
+                const char *str = *(const char **)srcp;
+                if (str)
+                    ret = ngli_params_vset(dst, par, str);
+                break;
+            }
+            case PARAM_TYPE_DATA:
+                ngli_params_share_data(dstp, srcp);
+                break;
+            case PARAM_TYPE_NODE: {
+                const struct ngl_node *child = *(struct ngl_node **)srcp;
+                if (child) {
+                    struct ngl_node *clone = clone_node(clones, child);
+                    if (!clone)
+                        return -1;
+                    ret = ngli_params_vset(dst, par, clone);
+                }
+                break;
+            }
+            case PARAM_TYPE_NODELIST: {
+                struct ngl_node **elems = *(struct ngl_node ***)srcp;
+                const int nb_elems = *(int *)(srcp + sizeof(struct ngl_node **));
+                if (!nb_elems)
+                    break;
+                struct ngl_node **clones_elems = calloc(nb_elems, sizeof(*clones_elems));
+                if (!clones_elems)
+                    return -1;
+                for (int i = 0; i < nb_elems; i++) {
+                    clones_elems[i] = clone_node(clones, elems[i]);
+                    if (!clones_elems[i]) {
+                        free(clones_elems);
+                        return -1;
+                    }
+                }
+                ret = ngli_params_add(dst, par, nb_elems, clones_elems);
+                free(clones_elems);
+                break;
+            }
+            case PARAM_TYPE_DBLLIST: {
+                double *elems = *(double **)srcp;
+                const int nb_elems = *(int *)(srcp + sizeof(double *));
+                if (nb_elems)
+                    ret = ngli_params_add(dst, par, nb_elems, elems);
+                break;
+            }
+            case PARAM_TYPE_NODEDICT: {
+                const struct hmap *hmap = *(struct hmap **)srcp;
+                if (!hmap)
+                    break;
+                const struct hmap_entry *entry = NULL;
+                while ((entry = ngli_hmap_next(hmap, entry))) {
+                    struct ngl_node *clone = clone_node(clones, entry->data);
+                    if (!clone)
+                        return -1;
+                    ret = ngli_params_vset(dst, par, entry->key, clone);
+                    if (ret < 0)
+                        return ret;
+                }
+                break;
+            }
+            default:
+                memcpy(dstp, srcp, ngli_params_specs[par->type].size);
+                break;
+        }
+        if (ret < 0)
+            return ret;
+        par++;
+    }
+    return 0;
+}
+
+static void free_clone(void *user_arg, void *data)
+{
+    struct ngl_node *node = data;
+    ngl_node_unrefp(&node);
+}
+
+/* The returned clone is owned by the clones map */
+static struct ngl_node *clone_node(struct hmap *clones, const struct ngl_node *node)
+{
+    char key[32];
+    snprintf(key, sizeof(key), "%p", node);
+    struct ngl_node *clone = ngli_hmap_get(clones, key);
+    if (clone)
+        return clone;
+
+    clone = ngli_node_create_noconstructor(node->class->id);
+    if (!clone)
+        return NULL;
+
+    if (ngli_hmap_set(clones, key, clone) < 0) {
+        ngl_node_unrefp(&clone);
+        return NULL;
+    }
+
+    if (clone_params(clones, (uint8_t *)clone, (const uint8_t *)node, ngli_base_node_params) < 0 ||
+        clone_params(clones, clone->priv_data, node->priv_data, node->class->params) < 0) {
+        LOG(ERROR, "unable to clone %s", node->name);
+        return NULL;
+    }
+
+    return clone;
+}
+
+struct ngl_node *ngl_node_clone(const struct ngl_node *node)
+{
+    struct hmap *clones = ngli_hmap_create();
+    if (!clones)
+        return NULL;
+    ngli_hmap_set_free(clones, free_clone, NULL);
+
+    struct ngl_node *clone = clone_node(clones, node);
+    if (clone)
+        ngl_node_ref(clone);
+
+    ngli_hmap_freep(&clones);
+    return clone;
+}
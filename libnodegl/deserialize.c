@@ -22,25 +22,34 @@
 #include <inttypes.h>
 #include <stdio.h>
 #include <string.h>
+#include <unistd.h>
 
 #include "log.h"
 #include "nodegl.h"
 #include "nodes.h"
 #include "params.h"
 
+/* Size of the chunks read from the stream, a line can span several chunks */
+#define READ_CHUNK_SIZE (1 << 20)
+
 struct serial_ctx {
     struct ngl_node **nodes;
     int nb_nodes;
+    int nodes_size;
 };
 
 static int register_node(struct serial_ctx *sctx,
                          const struct ngl_node *node)
 {
-    struct ngl_node **new_nodes = realloc(sctx->nodes, (sctx->nb_nodes + 1) * sizeof(*new_nodes));
-    if (!new_nodes)
-        return -1;
-    new_nodes[sctx->nb_nodes++] = (struct ngl_node *)node;
-    sctx->nodes = new_nodes;
+    if (sctx->nb_nodes == sctx->nodes_size) {
+        const int new_size = sctx->nodes_size ? sctx->nodes_size * 2 : 64;
+        struct ngl_node **new_nodes = realloc(sctx->nodes, new_size * sizeof(*new_nodes));
+        if (!new_nodes)
+            return -1;
+        sctx->nodes = new_nodes;
+        sctx->nodes_size = new_size;
+    }
+    sctx->nodes[sctx->nb_nodes++] = (struct ngl_node *)node;
     return 0;
 }
 
@@ -56,19 +65,79 @@ case param_type: {                                      \
     break;                                              \
 }
 
-#define DECLARE_FMT_PARSE_FUNC(type, name, fmt)         \
-static int parse_##name(const char *s, type *valp)      \
-{                                                       \
-    int len;                                            \
-    int n = sscanf(s, fmt "%n", valp, &len);            \
-    if (n != 1)                                         \
-        return -1;                                      \
-    return len;                                         \
+/*
+ * Hexadecimal digit values offset by 1, 0 being an invalid digit (including
+ * the end of the string)
+ */
+static const uint8_t hexm[256] = {
+    ['0'] = 0x1, ['1'] = 0x2, ['2'] = 0x3, ['3'] = 0x4,
+    ['4'] = 0x5, ['5'] = 0x6, ['6'] = 0x7, ['7'] = 0x8,
+    ['8'] = 0x9, ['9'] = 0xa, ['a'] = 0xb, ['b'] = 0xc,
+    ['c'] = 0xd, ['d'] = 0xe, ['e'] = 0xf, ['f'] = 0x10,
+    ['A'] = 0xb, ['B'] = 0xc, ['C'] = 0xd, ['D'] = 0xe,
+    ['E'] = 0xf, ['F'] = 0x10,
+};
+
+/*
+ * The values are parsed by hand rather than with sscanf(), which is
+ * allowed to (and with some libc does) scan the whole remaining string for
+ * each value
+ */
+static int parse_u64(const char *s, uint64_t *valp)
+{
+    const char *p = s;
+    uint64_t v = 0;
+    while (*p >= '0' && *p <= '9')
+        v = v * 10 + (*p++ - '0');
+    if (p == s)
+        return -1;
+    *valp = v;
+    return p - s;
 }
 
-DECLARE_FMT_PARSE_FUNC(int,     int,    "%d")
-DECLARE_FMT_PARSE_FUNC(int,     hexint, "%x")
-DECLARE_FMT_PARSE_FUNC(int64_t, i64,    "%"SCNd64)
+static int parse_x64(const char *s, uint64_t *valp)
+{
+    const char *p = s;
+    uint64_t v = 0;
+    int d;
+    while ((d = hexm[(uint8_t)*p]))
+        v = v << 4 | (d - 1), p++;
+    if (p == s)
+        return -1;
+    *valp = v;
+    return p - s;
+}
+
+static int parse_i64(const char *s, int64_t *valp)
+{
+    const int neg = *s == '-';
+    uint64_t v;
+    int len = parse_u64(s + neg, &v);
+    if (len < 0)
+        return -1;
+    *valp = neg ? -(int64_t)v : (int64_t)v;
+    return len + neg;
+}
+
+static int parse_int(const char *s, int *valp)
+{
+    int64_t v;
+    int len = parse_i64(s, &v);
+    if (len < 0)
+        return -1;
+    *valp = v;
+    return len;
+}
+
+static int parse_hexint(const char *s, int *valp)
+{
+    uint64_t v;
+    int len = parse_x64(s, &v);
+    if (len < 0)
+        return -1;
+    *valp = v;
+    return len;
+}
 
 static int parse_bool(const char *s, int *valp)
 {
@@ -83,7 +152,7 @@ static int parse_bool(const char *s, int *valp)
 #define DECLARE_FLT_PARSE_FUNC(type, nbit, shift_exp)                       \
 static int parse_##type(const char *s, type *valp)                          \
 {                                                                           \
-    int len, consumed = 0;                                                  \
+    int consumed = 0;                                                       \
     union { uint##nbit##_t i; type f; } u = {.i = 0};                       \
                                                                             \
     if (*s == '-') {                                                        \
@@ -91,16 +160,20 @@ static int parse_##type(const char *s, type *valp)                          \
         consumed++;                                                         \
     }                                                                       \
                                                                             \
-    uint##nbit##_t exp, mant;                                               \
-    int n = sscanf(s + consumed, "%" SCNx##nbit "z%" SCNx##nbit "%n",       \
-                   &exp, &mant, &len);                                      \
-    if (n != 2)                                                             \
+    uint64_t exp, mant;                                                     \
+    int len = parse_x64(s + consumed, &exp);                                \
+    if (len < 0 || s[consumed + len] != 'z')                                \
         return -1;                                                          \
+    consumed += len + 1;                                                    \
+    len = parse_x64(s + consumed, &mant);                                   \
+    if (len < 0)                                                            \
+        return -1;                                                          \
+    consumed += len;                                                        \
                                                                             \
-    u.i |= exp<<shift_exp | mant;                                           \
+    u.i |= (uint##nbit##_t)exp<<shift_exp | (uint##nbit##_t)mant;           \
                                                                             \
     *valp = u.f;                                                            \
-    return len + consumed;                                                  \
+    return consumed;                                                        \
 }
 
 DECLARE_FLT_PARSE_FUNC(float,  32, 23)
@@ -110,7 +183,7 @@ DECLARE_FLT_PARSE_FUNC(double, 64, 52)
 static int parse_func##s(const char *s, type **valsp, int *nb_valsp)        \
 {                                                                           \
     type *vals = NULL;                                                      \
-    int nb_vals = 0, consumed = 0, len;                                     \
+    int nb_vals = 0, vals_size = 0, consumed = 0, len;                      \
                                                                             \
     for (;;) {                                                              \
         type v;                                                             \
@@ -119,15 +192,18 @@ static int parse_func##s(const char *s, type **valsp, int *nb_valsp)        \
             consumed = -1;                                                  \
             break;                                                          \
         }                                                                   \
-        type *new_vals = realloc(vals, (nb_vals + 1) * sizeof(*new_vals));  \
-        if (!new_vals) {                                                    \
-            consumed = -1;                                                  \
-            break;                                                          \
+        if (nb_vals == vals_size) {                                         \
+            vals_size = vals_size ? vals_size * 2 : 16;                     \
+            type *new_vals = realloc(vals, vals_size * sizeof(*new_vals));  \
+            if (!new_vals) {                                                \
+                consumed = -1;                                              \
+                break;                                                      \
+            }                                                               \
+            vals = new_vals;                                                \
         }                                                                   \
         s += len;                                                           \
         consumed += len;                                                    \
-        new_vals[nb_vals++] = v;                                            \
-        vals = new_vals;                                                    \
+        vals[nb_vals++] = v;                                                \
         if (*s != ',')                                                      \
             break;                                                          \
         s++;                                                                \
@@ -165,11 +241,20 @@ static int parse_kvs(const char *s, int *nb_kvsp, char ***keysp, int **valsp)
     for (;;) {
         char key[63 + 1];
         int val;
-        int n = sscanf(s, "%63[^=]=%x" "%n", key, &val, &len);
-        if (n != 2) {
+
+        const int key_len = strcspn(s, "= \n");
+        if (!key_len || key_len >= sizeof(key) || s[key_len] != '=') {
             consumed = -1;
             break;
         }
+        memcpy(key, s, key_len);
+        key[key_len] = 0;
+        len = parse_hexint(s + key_len + 1, &val);
+        if (len < 0) {
+            consumed = -1;
+            break;
+        }
+        len += key_len + 1;
 
         char **new_keys = realloc(keys, (nb_vals + 1) * sizeof(*new_keys));
         if (!new_keys) {
@@ -207,10 +292,35 @@ static int parse_kvs(const char *s, int *nb_kvsp, char ***keysp, int **valsp)
 
 static inline int hexv(char c)
 {
-    if (c >= 'a' && c <= 'f')
-        return c - ('a' - 10);
-    if (c >= '0' && c <= '9')
-        return c - '0';
+    const int d = hexm[(uint8_t)c];
+    return d ? d - 1 : 0;
+}
+
+/*
+ * Decode size bytes of hexadecimal data, 2 bytes at a time; the decoding
+ * stops at the first invalid digit, which includes the end of the string
+ */
+static int decode_hex(uint8_t *dst, const char *src, int size)
+{
+    const uint8_t *s = (const uint8_t *)src;
+    int i = 0;
+
+    for (; i < size - 1; i += 2) {
+        const int a = hexm[s[0]], b = hexm[s[1]];
+        const int c = hexm[s[2]], d = hexm[s[3]];
+        if (!a || !b || !c || !d)
+            break;
+        dst[i]     = (a - 1) << 4 | (b - 1);
+        dst[i + 1] = (c - 1) << 4 | (d - 1);
+        s += 4;
+    }
+    for (; i < size; i++) {
+        const int a = hexm[s[0]], b = hexm[s[1]];
+        if (!a || !b)
+            return -1;
+        dst[i] = (a - 1) << 4 | (b - 1);
+        s += 2;
+    }
     return 0;
 }
 
@@ -227,10 +337,14 @@ static int parse_param(struct serial_ctx *sctx, uint8_t *base_ptr,
 
         case PARAM_TYPE_RATIONAL: {
             int r[2] = {0};
-            int ret = sscanf(str, "%d/%d%n", &r[0], &r[1], &len);
-            if (ret != 2)
+            int len0 = parse_int(str, &r[0]);
+            if (len0 < 0 || str[len0] != '/')
+                return -1;
+            int len1 = parse_int(str + len0 + 1, &r[1]);
+            if (len1 < 0)
                 return -1;
-            ret = ngli_params_vset(base_ptr, par, r[0], r[1]);
+            len = len0 + 1 + len1;
+            int ret = ngli_params_vset(base_ptr, par, r[0], r[1]);
             if (ret < 0)
                 return ret;
             break;
@@ -275,39 +389,29 @@ static int parse_param(struct serial_ctx *sctx, uint8_t *base_ptr,
         }
         case PARAM_TYPE_DATA: {
             int size = 0;
-            int consumed = 0;
-            const char *cur = str;
-            const char *end = str + strlen(str);
-            int ret = sscanf(str, "%d,%n", &size, &consumed);
-            if (ret != 1)
+            int consumed = parse_int(str, &size);
+            if (consumed < 0 || size < 0)
                 return -1;
-            if (!size)
+            if (!size) {
+                len = consumed;
                 break;
-            if (cur >= end - consumed)
+            }
+            if (str[consumed] != ',')
                 return -1;
-            cur += consumed;
-            uint8_t *data = calloc(size, sizeof(*data));
+            consumed++;
+            uint8_t *data = malloc(size);
             if (!data)
                 return -1;
-            for (int i = 0; i < size; i++) {
-                if (cur > end - 2) {
-                    free(data);
-                    return -1;
-                }
-                static const uint8_t hexm[256] = {
-                    ['0'] = 0x0, ['1'] = 0x1, ['2'] = 0x2, ['3'] = 0x3,
-                    ['4'] = 0x4, ['5'] = 0x5, ['6'] = 0x6, ['7'] = 0x7,
-                    ['8'] = 0x8, ['9'] = 0x9, ['a'] = 0xa, ['b'] = 0xb,
-                    ['c'] = 0xc, ['d'] = 0xd, ['e'] = 0xe, ['f'] = 0xf,
-                };
-                data[i] = hexm[(uint8_t)cur[0]]<<4 | hexm[(uint8_t)cur[1]];
-                cur += 2;
+            int ret = decode_hex(data, str + consumed, size);
+            if (ret < 0) {
+                free(data);
+                return -1;
             }
             ret = ngli_params_vset(base_ptr, par, size, data);
             free(data);
             if (ret < 0)
                 return ret;
-            len = cur - str;
+            len = consumed + 2 * size;
             break;
         }
 
@@ -416,6 +520,18 @@ static int parse_param(struct serial_ctx *sctx, uint8_t *base_ptr,
     return len;
 }
 
+static int end_of_param(const struct ngl_node *node, const struct node_param *par,
+                        char **strp, int len)
+{
+    char *str = *strp + len;
+    if (*str && *str != ' ') {
+        LOG(ERROR, "unexpected trailing data after %s.%s", node->name, par->key);
+        return -1;
+    }
+    *strp = *str ? str + 1 : str;
+    return 0;
+}
+
 static int set_node_params(struct serial_ctx *sctx, char *str,
                            const struct ngl_node *node)
 {
@@ -428,105 +544,195 @@ static int set_node_params(struct serial_ctx *sctx, char *str,
     for (int i = 0; params[i].key; i++) {
         const struct node_param *par = &params[i];
 
-        if (par->flags & PARAM_FLAG_CONSTRUCTOR) {
-            int ret = parse_param(sctx, base_ptr, par, str);
-            if (ret < 0)
-                break;
-
-            str += ret;
-            if (*str != ' ')
-                break;
-            str++;
-        } else {
+        if (!(par->flags & PARAM_FLAG_CONSTRUCTOR))
             break; /* assume all constructors are at the start */
+
+        int ret = parse_param(sctx, base_ptr, par, str);
+        if (ret < 0) {
+            LOG(ERROR, "unable to parse %s.%s", node->name, par->key);
+            return ret;
         }
+        ret = end_of_param(node, par, &str, ret);
+        if (ret < 0)
+            return ret;
     }
 
-    for (;;) {
+    while (*str) {
         char *eok = strchr(str, ':');
-        if (!eok)
-            break;
+        if (!eok) {
+            LOG(ERROR, "missing value for %s.%s", node->name, str);
+            return -1;
+        }
         *eok = 0;
 
         const struct node_param *par = ngli_node_param_find(node, str, &base_ptr);
-        if (!par)
-            break;
+        if (!par) {
+            LOG(ERROR, "unknown parameter %s.%s", node->name, str);
+            return -1;
+        }
 
         str = eok + 1;
         int ret = parse_param(sctx, base_ptr, par, str);
+        if (ret < 0) {
+            LOG(ERROR, "unable to parse %s.%s", node->name, par->key);
+            return ret;
+        }
+        ret = end_of_param(node, par, &str, ret);
         if (ret < 0)
-            break;
-
-        str += ret;
-        if (*str != ' ')
-            break;
-        str++;
+            return ret;
     }
 
     return 0;
 }
 
-struct ngl_node *ngl_node_deserialize(const char *str)
-{
-    struct ngl_node *node = NULL;
-    struct serial_ctx sctx = {0};
-
-    char *s = ngli_strdup(str);
-    if (!s)
-        return NULL;
-
-    char *sstart = s;
-    size_t len = strlen(str);
-    char *end = s + len;
+struct deserializer {
+    struct serial_ctx sctx;
+    struct ngl_node *node;  // last de-serialized node, the root of the graph
+    int nb_lines;
+};
 
+static int parse_header(const char *line)
+{
     int major, minor, micro;
-    int n = sscanf(s, "# Node.GL v%d.%d.%d", &major, &minor, &micro);
+    int n = sscanf(line, "# Node.GL v%d.%d.%d", &major, &minor, &micro);
     if (n != 3) {
         LOG(ERROR, "Invalid serialized scene");
-        goto end;
+        return -1;
     }
     if (NODEGL_VERSION_INT != NODEGL_GET_VERSION(major, minor, micro)) {
         LOG(ERROR, "Mismatching version: %d.%d.%d != %d.%d.%d",
             major, minor, micro,
             NODEGL_VERSION_MAJOR, NODEGL_VERSION_MINOR, NODEGL_VERSION_MICRO);
-        goto end;
+        return -1;
     }
-    s += strcspn(s, "\n");
-    if (*s == '\n')
+    return 0;
+}
+
+static int parse_line(struct deserializer *d, char *s, size_t len)
+{
+    if (d->nb_lines++ == 0)
+        return parse_header(s);
+
+    if (len < 4)
+        return 0;
+
+    const int type = NGLI_FOURCC(s[0], s[1], s[2], s[3]);
+    s += 4;
+    if (*s == ' ')
         s++;
 
-    while (s < end - 4) {
-        const int type = NGLI_FOURCC(s[0], s[1], s[2], s[3]);
-        s += 4;
-        if (*s == ' ')
-            s++;
+    struct ngl_node *node = ngli_node_create_noconstructor(type);
+    if (!node)
+        return -1;
 
-        node = ngli_node_create_noconstructor(type);
-        if (!node)
-            break;
+    int ret = register_node(&d->sctx, node);
+    if (ret < 0) {
+        ngl_node_unrefp(&node);
+        return ret;
+    }
+    d->node = node;
 
-        int ret = register_node(&sctx, node);
-        if (ret < 0) {
-            ngl_node_unrefp(&node);
-            break;
+    return set_node_params(&d->sctx, s, node);
+}
+
+struct ngl_node *ngl_node_deserialize_cb(ngl_read_func read_func, void *opaque)
+{
+    struct deserializer d = {{0}};
+    struct ngl_node *node = NULL;
+    char *buf = NULL;
+    size_t buf_size = 0;
+    size_t buf_len = 0;
+    int ret = 0;
+
+    /* Only the line being parsed is held in memory */
+    for (;;) {
+        if (buf_size - buf_len < READ_CHUNK_SIZE + 1) {
+            const size_t new_size = NGLI_MAX(buf_size * 2, buf_len + READ_CHUNK_SIZE + 1);
+            char *new_buf = realloc(buf, new_size);
+            if (!new_buf) {
+                ret = -1;
+                break;
+            }
+            buf = new_buf;
+            buf_size = new_size;
         }
 
-        size_t eol = strcspn(s, "\n");
-        s[eol] = 0;
+        const int n = read_func(opaque, buf + buf_len, READ_CHUNK_SIZE);
+        if (n < 0) {
+            LOG(ERROR, "unable to read the serialized scene");
+            ret = -1;
+            break;
+        }
 
-        set_node_params(&sctx, s, node);
+        const size_t scan_start = buf_len;
+        buf_len += n;
+
+        /* Parse the complete lines, the newline search starts where the
+         * previous one stopped so every byte is only scanned once */
+        char *line = buf;
+        char *cur = buf + scan_start;
+        char *end = buf + buf_len;
+        char *eol;
+        while (ret >= 0 && (eol = memchr(cur, '\n', end - cur))) {
+            *eol = 0;
+            ret = parse_line(&d, line, eol - line);
+            line = cur = eol + 1;
+        }
+        if (ret < 0)
+            break;
 
-        s += eol + 1;
+        buf_len = end - line;
+        if (!n) {
+            if (buf_len) {
+                line[buf_len] = 0;
+                ret = parse_line(&d, line, buf_len);
+            }
+            break;
+        }
+        memmove(buf, line, buf_len);
     }
+    free(buf);
 
-    if (node)
+    if (ret >= 0 && d.node) {
+        node = d.node;
         ngl_node_ref(node);
+    }
 
-    for (int i = 0; i < sctx.nb_nodes; i++)
-        ngl_node_unrefp(&sctx.nodes[i]);
-    free(sctx.nodes);
+    for (int i = 0; i < d.sctx.nb_nodes; i++)
+        ngl_node_unrefp(&d.sctx.nodes[i]);
+    free(d.sctx.nodes);
 
-end:
-    free(sstart);
     return node;
 }
+
+static int read_fd(void *opaque, char *buf, int size)
+{
+    const int fd = *(int *)opaque;
+    return read(fd, buf, size);
+}
+
+struct ngl_node *ngl_node_deserialize_fd(int fd)
+{
+    return ngl_node_deserialize_cb(read_fd, &fd);
+}
+
+struct string_reader {
+    const char *str;
+    size_t len;
+};
+
+static int read_string(void *opaque, char *buf, int size)
+{
+    struct string_reader *reader = opaque;
+    const int n = NGLI_MIN(reader->len, size);
+    memcpy(buf, reader->str, n);
+    reader->str += n;
+    reader->len -= n;
+    return n;
+}
+
+struct ngl_node *ngl_node_deserialize(const char *str)
+{
+    struct string_reader reader = {.str = str, .len = strlen(str)};
+    return ngl_node_deserialize_cb(read_string, &reader);
+}
@@ -0,0 +1,164 @@
+/*
+ * Copyright 2018 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "drawahead.h"
+#include "log.h"
+#include "nodegl.h"
+#include "nodes.h"
+#include "trace.h"
+#include "utils.h"
+
+static void *drawahead_thread(void *arg)
+{
+    struct ngl_ctx *s = arg;
+    struct drawahead *d = &s->drawahead;
+
+    pthread_mutex_lock(&d->lock);
+    for (;;) {
+        while (!d->stop && !d->pending)
+            pthread_cond_wait(&d->cond, &d->lock);
+        if (d->stop)
+            break;
+
+        const double t = d->t;
+        pthread_mutex_unlock(&d->lock);
+        TRACE_BEGIN("evaluate_ahead", "scene");
+        const int ret = ngli_node_evaluate_registered(s, t);
+        TRACE_END("evaluate_ahead", "scene");
+        pthread_mutex_lock(&d->lock);
+
+        d->error = ret;
+        d->pending = 0;
+        pthread_cond_broadcast(&d->cond);
+    }
+    pthread_mutex_unlock(&d->lock);
+    return NULL;
+}
+
+int ngli_drawahead_init(struct drawahead *d)
+{
+    if (pthread_mutex_init(&d->lock, NULL))
+        return -1;
+    if (pthread_cond_init(&d->cond, NULL)) {
+        pthread_mutex_destroy(&d->lock);
+        return -1;
+    }
+    return 0;
+}
+
+int ngli_drawahead_set_times(struct ngl_ctx *s, const double *times, int nb_times)
+{
+    struct drawahead *d = &s->drawahead;
+
+    ngli_drawahead_wait(s);
+
+    double *new_times = NULL;
+    if (nb_times > 0) {
+        new_times = malloc(nb_times * sizeof(*new_times));
+        if (!new_times)
+            return -1;
+        memcpy(new_times, times, nb_times * sizeof(*new_times));
+    }
+    free(d->times);
+    d->times = new_times;
+    d->nb_times = NGLI_MAX(nb_times, 0);
+    d->pos = 0;
+    return 0;
+}
+
+/* Must be called before anything else touches the scene */
+int ngli_drawahead_wait(struct ngl_ctx *s)
+{
+    struct drawahead *d = &s->drawahead;
+
+    if (!d->thread_started)
+        return 0;
+
+    pthread_mutex_lock(&d->lock);
+    while (d->pending)
+        pthread_cond_wait(&d->cond, &d->lock);
+    const int ret = d->error;
+    d->error = 0;
+    pthread_mutex_unlock(&d->lock);
+    return ret;
+}
+
+/*
+ * Called once the frame at time t is ready to be drawn: the nodes evaluated
+ * for this frame are evaluated for the next expected time while the frame is
+ * being drawn.
+ */
+int ngli_drawahead_start(struct ngl_ctx *s, double t)
+{
+    struct drawahead *d = &s->drawahead;
+
+    if (d->pos >= d->nb_times)
+        return 0;
+
+    if (d->times[d->pos] != t) {
+        LOG(DEBUG, "unexpected draw time %g (expected %g), drop the upcoming draw times",
+            t, d->times[d->pos]);
+        d->pos = d->nb_times;
+        return 0;
+    }
+
+    d->pos++;
+    if (d->pos == d->nb_times || !s->nb_eval_nodes || s->stats.enabled)
+        return 0;
+
+    if (!d->thread_started) {
+        if (pthread_create(&d->thread, NULL, drawahead_thread, s)) {
+            LOG(ERROR, "unable to create the draw-ahead thread");
+            return -1;
+        }
+        d->thread_started = 1;
+    }
+
+    pthread_mutex_lock(&d->lock);
+    d->t = d->times[d->pos];
+    d->pending = 1;
+    pthread_cond_signal(&d->cond);
+    pthread_mutex_unlock(&d->lock);
+    return 0;
+}
+
+void ngli_drawahead_reset(struct ngl_ctx *s)
+{
+    struct drawahead *d = &s->drawahead;
+
+    if (d->thread_started) {
+        pthread_mutex_lock(&d->lock);
+        d->stop = 1;
+        pthread_cond_broadcast(&d->cond);
+        pthread_mutex_unlock(&d->lock);
+        pthread_join(d->thread, NULL);
+        d->thread_started = 0;
+    }
+    pthread_cond_destroy(&d->cond);
+    pthread_mutex_destroy(&d->lock);
+    free(d->times);
+    d->times = NULL;
+    d->nb_times = d->pos = 0;
+}
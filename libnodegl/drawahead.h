@@ -0,0 +1,56 @@
+/*
+ * Copyright 2018 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef DRAWAHEAD_H
+#define DRAWAHEAD_H
+
+#include <pthread.h>
+
+struct ngl_ctx;
+
+/*
+ * Evaluation of the next frame ahead of time: when the upcoming draw times
+ * are known, the nodes evaluated for the frame being drawn are evaluated for
+ * the next time in a separate thread, while the current frame is submitted
+ * and read back by the user.
+ */
+struct drawahead {
+    double *times;          // upcoming draw times
+    int nb_times;
+    int pos;                // index of the next expected draw time
+
+    pthread_t thread;
+    int thread_started;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    int pending;            // an evaluation is requested or running
+    double t;               // time of the requested evaluation
+    int error;
+    int stop;
+};
+
+int ngli_drawahead_init(struct drawahead *d);
+int ngli_drawahead_set_times(struct ngl_ctx *s, const double *times, int nb_times);
+int ngli_drawahead_wait(struct ngl_ctx *s);
+int ngli_drawahead_start(struct ngl_ctx *s, double t);
+void ngli_drawahead_reset(struct ngl_ctx *s);
+
+#endif /* DRAWAHEAD_H */
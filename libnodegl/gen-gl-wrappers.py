@@ -45,9 +45,28 @@ cmds_optional = [
 
     #  Buffers
     'glBindBufferBase',
+    'glBindBufferRange',
+    'glBufferStorage',
+    'glMapBufferRange',
+    'glUnmapBuffer',
+
+    # Uniform buffers
+    'glGetActiveUniformBlockiv',
+    'glGetActiveUniformsiv',
+    'glUniformBlockBinding',
+
+    # Sync
+    'glClientWaitSync',
+    'glDeleteSync',
+    'glFenceSync',
 
     # Compute shaders
     'glDispatchCompute',
+    'glDispatchComputeIndirect',
+
+    # Indirect draws
+    'glDrawElementsIndirect',
+    'glMultiDrawElementsIndirect',
 
     # Shaders
     'glGetProgramResourceLocation',
@@ -59,6 +78,17 @@ cmds_optional = [
 
     # Internal format
     'glGetInternalformativ',
+
+    # Framebuffer invalidation
+    'glInvalidateFramebuffer',
+
+    # Queries
+    'glBeginQuery',
+    'glDeleteQueries',
+    'glEndQuery',
+    'glGenQueries',
+    'glGetQueryObjectui64v',
+    'glGetQueryObjectuiv',
 ]
 
 cmds = [
@@ -194,6 +224,24 @@ cmds = [
 
 ] + cmds_optional
 
+# Amount of data transferred by the calls, accounted in GL_STATS mode
+cmds_bytes = {
+    'glBufferData':    'size',
+    'glBufferSubData': 'size',
+    'glReadPixels':    'ngli_glstats_get_pixels_size(format, type, width, height, 1)',
+    'glTexImage2D':    'pixels ? ngli_glstats_get_pixels_size(format, type, width, height, 1) : 0',
+    'glTexImage3D':    'pixels ? ngli_glstats_get_pixels_size(format, type, width, height, depth) : 0',
+    'glTexSubImage2D': 'ngli_glstats_get_pixels_size(format, type, width, height, 1)',
+    'glTexSubImage3D': 'ngli_glstats_get_pixels_size(format, type, width, height, depth)',
+    'glMapBufferRange': '(access & GL_MAP_READ_BIT) ? length : 0',
+}
+
+# Calls transferring data from the GPU, the others transfer data to the GPU
+cmds_readback = [
+    'glMapBufferRange',
+    'glReadPixels',
+]
+
 def get_proto_elems(xml_node):
     elems = []
     for text in xml_node.itertext():
@@ -207,11 +255,12 @@ def gen(gl_xml):
 
     do_not_edit = '/* DO NOT EDIT - This file is autogenerated */\n'
 
-    glwrappers = do_not_edit + '''
+    glwrappers = do_not_edit + r'''
 #ifndef NGL_GL_H
 #define NGL_GL_H
 
 #include "glfunctions.h"
+#include "glstats.h"
 
 static const char * const errors_str[] = {
     [GL_INVALID_ENUM]                   = "GL_INVALID_ENUM",
@@ -239,6 +288,15 @@ static inline void check_error_code(const struct glfunctions *gl,
 #else
 # define check_error_code(gl, glfuncname) do { } while (0)
 #endif
+
+#ifdef CONFIG_GL_STATS
+# define count_call(gl, id, size) do {        \
+    (gl)->stats->nb_calls[id]++;              \
+    (gl)->stats->nb_bytes[id] += (size);      \
+} while (0)
+#else
+# define count_call(gl, id, size) do { } while (0)
+#endif
 '''
 
     glfunctions = do_not_edit + '''
@@ -253,6 +311,8 @@ static inline void check_error_code(const struct glfunctions *gl,
 #define NGLI_GL_APIENTRY
 #endif
 
+struct glstats;
+
 struct glfunctions {
 '''
 
@@ -261,13 +321,18 @@ struct glfunctions {
 
 #include "glfunctions.h"
 
-#define M (1 << 0)
+#define M (1 << 0) // mandatory function
+#define R (1 << 1) // function reading back data from the GPU
 
 static const struct gldefinition {
     const char *name;
     size_t offset;
     int flags;
 } gldefinitions[] = {
+'''
+
+    glids = '''
+enum {
 '''
 
     xml = ET.parse(gl_xml)
@@ -306,14 +371,18 @@ static const struct gldefinition {
                 'ret_assign': ret_assign,
                 'func_args': ', '.join(func_args),
                 'ret_call': ret_call,
-                'flags': '0' if funcname in cmds_optional else 'M',
+                'flags': '|'.join(flag for flag, enabled in (('M', funcname not in cmds_optional),
+                                                             ('R', funcname in cmds_readback)) if enabled) or '0',
+                'size': cmds_bytes.get(funcname, '0'),
         }
 
+        glids         += '    NGLI_GLID_%(func_name_nogl)s,\n' % data
         glfunctions   += '    NGLI_GL_APIENTRY %(func_ret)s (*%(func_name_nogl)s)(%(func_args_specs)s);\n' % data
         gldefinitions += '    {"%(func_name)s", offsetof(struct glfunctions, %(func_name_nogl)s), %(flags)s},\n' % data
         glwrappers    += '''
 static inline %(func_ret)s ngli_%(func_name)s(%(wrapper_args_specs)s)
 {
+    count_call(gl, NGLI_GLID_%(func_name_nogl)s, %(size)s);
     %(ret_assign)sgl->%(func_name_nogl)s(%(func_args)s);
     check_error_code(gl, "%(func_name)s");
 %(ret_call)s}
@@ -327,7 +396,8 @@ static inline %(func_ret)s ngli_%(func_name)s(%(wrapper_args_specs)s)
         print('WARNING: function(s) not found: ' + ', '.join(cmds))
 
     glwrappers    += '\n#endif\n'
-    glfunctions   += '};\n\n#endif\n'
+    glids         += '    NGLI_GLID_NB\n};\n'
+    glfunctions   += '\n    struct glstats *stats;\n};\n' + glids + '\n#endif\n'
     gldefinitions += '};\n'
 
     open('glfunctions.h', 'w').write(glfunctions)
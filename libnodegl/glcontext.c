@@ -20,6 +20,7 @@
  */
 
 #include <stddef.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -92,6 +93,7 @@ static struct glcontext *glcontext_new(void *display, void *window, void *handle
 
     glcontext->platform = platform;
     glcontext->api = api;
+    glcontext->funcs.stats = &glcontext->stats;
 
     if (glcontext->class->init) {
         int ret = glcontext->class->init(glcontext, display, window, handle);
@@ -174,6 +176,14 @@ static int glcontext_load_functions(struct glcontext *glcontext)
         const struct gldefinition *gldefinition = &gldefinitions[i];
 
         func = ngli_glcontext_get_proc_address(glcontext, gldefinition->name);
+
+        /* Optional functions may only be exposed by an OpenGLES extension */
+        if (!func && !(gldefinition->flags & M) && glcontext->api == NGL_GLAPI_OPENGLES2) {
+            char ext_name[64];
+            snprintf(ext_name, sizeof(ext_name), "%sEXT", gldefinition->name);
+            func = ngli_glcontext_get_proc_address(glcontext, ext_name);
+        }
+
         if ((gldefinition->flags & M) && !func) {
             LOG(ERROR, "could not find core function: %s", gldefinition->name);
             return -1;
@@ -308,7 +318,8 @@ static int glcontext_probe_extensions(struct glcontext *glcontext)
         int maj_version = es ? glfeature->maj_es_version : glfeature->maj_version;
         int min_version = es ? glfeature->min_es_version : glfeature->min_version;
 
-        if (!(glcontext->major_version >= maj_version &&
+        if (maj_version < 0 ||
+            !(glcontext->major_version >= maj_version &&
               glcontext->minor_version >= min_version)) {
             const char **extensions = es ? glfeature->es_extensions : glfeature->extensions;
             if (!glcontext_check_extensions(glcontext, extensions))
@@ -350,6 +361,11 @@ static int glcontext_probe_settings(struct glcontext *glcontext)
         }
     }
 
+    if (glcontext->features & NGLI_FEATURE_UNIFORM_BUFFER_OBJECT) {
+        ngli_glGetIntegerv(gl, GL_MAX_UNIFORM_BUFFER_BINDINGS, &glcontext->max_uniform_buffer_bindings);
+        ngli_glGetIntegerv(gl, GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &glcontext->uniform_buffer_offset_alignment);
+    }
+
     return 0;
 }
 
@@ -498,3 +514,34 @@ int ngli_glcontext_check_gl_error(struct glcontext *glcontext)
 
     return error;
 }
+
+int ngli_glcontext_get_stats(struct glcontext *glcontext, struct ngl_gl_stats *stats)
+{
+#ifdef CONFIG_GL_STATS
+    const struct glstats *glstats = &glcontext->stats;
+
+    memset(stats, 0, sizeof(*stats));
+    stats->entries = glcontext->call_stats;
+
+    for (int i = 0; i < NGLI_GLID_NB; i++) {
+        if (!glstats->nb_calls[i])
+            continue;
+
+        if (gldefinitions[i].flags & R)
+            stats->readback_bytes += glstats->nb_bytes[i];
+        else
+            stats->upload_bytes += glstats->nb_bytes[i];
+        stats->nb_calls += glstats->nb_calls[i];
+
+        struct ngl_gl_call_stats *entry = &glcontext->call_stats[stats->nb_entries++];
+        entry->name = gldefinitions[i].name;
+        entry->nb_calls = glstats->nb_calls[i];
+        entry->nb_bytes = glstats->nb_bytes[i];
+    }
+
+    return 0;
+#else
+    LOG(ERROR, "node.gl is not compiled with GL statistics support");
+    return -1;
+#endif
+}
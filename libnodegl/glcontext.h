@@ -23,6 +23,8 @@
 #define GLCONTEXT_H
 
 #include "glfunctions.h"
+#include "glstats.h"
+#include "nodegl.h"
 #include "glwrappers.h"
 
 #define NGLI_FEATURE_VERTEX_ARRAY_OBJECT          (1 << 0)
@@ -34,6 +36,12 @@
 #define NGLI_FEATURE_SHADER_STORAGE_BUFFER_OBJECT (1 << 6)
 #define NGLI_FEATURE_FRAMEBUFFER_OBJECT           (1 << 7)
 #define NGLI_FEATURE_INTERNALFORMAT_QUERY         (1 << 8)
+#define NGLI_FEATURE_TIMER_QUERY                  (1 << 9)
+#define NGLI_FEATURE_BUFFER_STORAGE               (1 << 10)
+#define NGLI_FEATURE_UNIFORM_BUFFER_OBJECT        (1 << 11)
+#define NGLI_FEATURE_INVALIDATE_SUBDATA           (1 << 12)
+#define NGLI_FEATURE_DRAW_INDIRECT                (1 << 13)
+#define NGLI_FEATURE_MULTI_DRAW_INDIRECT          (1 << 14)
 
 #define NGLI_FEATURE_COMPUTE_SHADER_ALL (NGLI_FEATURE_COMPUTE_SHADER           | \
                                          NGLI_FEATURE_PROGRAM_INTERFACE_QUERY  | \
@@ -60,12 +68,18 @@ struct glcontext {
     int features;
     int max_texture_image_units;
     int max_compute_work_group_counts[3];
+    int max_uniform_buffer_bindings;
+    int uniform_buffer_offset_alignment;
 
     GLenum gl_1comp;
     GLenum gl_2comp;
 
     /* GL functions */
     struct glfunctions funcs;
+
+    /* GL statistics */
+    struct glstats stats;
+    struct ngl_gl_call_stats call_stats[NGLI_GLID_NB];
 };
 
 struct glcontext_class {
@@ -93,5 +107,6 @@ void *ngli_glcontext_get_texture_cache(struct glcontext *glcontext);
 void ngli_glcontext_freep(struct glcontext **glcontext);
 int ngli_glcontext_check_extension(const char *extension, const char *extensions);
 int ngli_glcontext_check_gl_error(struct glcontext *glcontext);
+int ngli_glcontext_get_stats(struct glcontext *glcontext, struct ngl_gl_stats *stats);
 
 #endif /* GLCONTEXT_H */
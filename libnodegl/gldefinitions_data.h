@@ -4,7 +4,8 @@
 
 #include "glfunctions.h"
 
-#define M (1 << 0)
+#define M (1 << 0) // mandatory function
+#define R (1 << 1) // function reading back data from the GPU
 
 static const struct gldefinition {
     const char *name;
@@ -13,9 +14,11 @@ static const struct gldefinition {
 } gldefinitions[] = {
     {"glActiveTexture", offsetof(struct glfunctions, ActiveTexture), M},
     {"glAttachShader", offsetof(struct glfunctions, AttachShader), M},
+    {"glBeginQuery", offsetof(struct glfunctions, BeginQuery), 0},
     {"glBindAttribLocation", offsetof(struct glfunctions, BindAttribLocation), M},
     {"glBindBuffer", offsetof(struct glfunctions, BindBuffer), M},
     {"glBindBufferBase", offsetof(struct glfunctions, BindBufferBase), 0},
+    {"glBindBufferRange", offsetof(struct glfunctions, BindBufferRange), 0},
     {"glBindFramebuffer", offsetof(struct glfunctions, BindFramebuffer), M},
     {"glBindImageTexture", offsetof(struct glfunctions, BindImageTexture), 0},
     {"glBindRenderbuffer", offsetof(struct glfunctions, BindRenderbuffer), M},
@@ -28,10 +31,12 @@ static const struct gldefinition {
     {"glBlendFuncSeparate", offsetof(struct glfunctions, BlendFuncSeparate), M},
     {"glBlitFramebuffer", offsetof(struct glfunctions, BlitFramebuffer), 0},
     {"glBufferData", offsetof(struct glfunctions, BufferData), M},
+    {"glBufferStorage", offsetof(struct glfunctions, BufferStorage), 0},
     {"glBufferSubData", offsetof(struct glfunctions, BufferSubData), M},
     {"glCheckFramebufferStatus", offsetof(struct glfunctions, CheckFramebufferStatus), M},
     {"glClear", offsetof(struct glfunctions, Clear), M},
     {"glClearColor", offsetof(struct glfunctions, ClearColor), M},
+    {"glClientWaitSync", offsetof(struct glfunctions, ClientWaitSync), 0},
     {"glColorMask", offsetof(struct glfunctions, ColorMask), M},
     {"glCompileShader", offsetof(struct glfunctions, CompileShader), M},
     {"glCreateProgram", offsetof(struct glfunctions, CreateProgram), M},
@@ -39,8 +44,10 @@ static const struct gldefinition {
     {"glDeleteBuffers", offsetof(struct glfunctions, DeleteBuffers), M},
     {"glDeleteFramebuffers", offsetof(struct glfunctions, DeleteFramebuffers), M},
     {"glDeleteProgram", offsetof(struct glfunctions, DeleteProgram), M},
+    {"glDeleteQueries", offsetof(struct glfunctions, DeleteQueries), 0},
     {"glDeleteRenderbuffers", offsetof(struct glfunctions, DeleteRenderbuffers), M},
     {"glDeleteShader", offsetof(struct glfunctions, DeleteShader), M},
+    {"glDeleteSync", offsetof(struct glfunctions, DeleteSync), 0},
     {"glDeleteTextures", offsetof(struct glfunctions, DeleteTextures), M},
     {"glDeleteVertexArrays", offsetof(struct glfunctions, DeleteVertexArrays), 0},
     {"glDepthFunc", offsetof(struct glfunctions, DepthFunc), M},
@@ -49,18 +56,25 @@ static const struct gldefinition {
     {"glDisable", offsetof(struct glfunctions, Disable), M},
     {"glDisableVertexAttribArray", offsetof(struct glfunctions, DisableVertexAttribArray), M},
     {"glDispatchCompute", offsetof(struct glfunctions, DispatchCompute), 0},
+    {"glDispatchComputeIndirect", offsetof(struct glfunctions, DispatchComputeIndirect), 0},
     {"glDrawElements", offsetof(struct glfunctions, DrawElements), M},
+    {"glDrawElementsIndirect", offsetof(struct glfunctions, DrawElementsIndirect), 0},
     {"glEnable", offsetof(struct glfunctions, Enable), M},
     {"glEnableVertexAttribArray", offsetof(struct glfunctions, EnableVertexAttribArray), M},
+    {"glEndQuery", offsetof(struct glfunctions, EndQuery), 0},
+    {"glFenceSync", offsetof(struct glfunctions, FenceSync), 0},
     {"glFramebufferRenderbuffer", offsetof(struct glfunctions, FramebufferRenderbuffer), M},
     {"glFramebufferTexture2D", offsetof(struct glfunctions, FramebufferTexture2D), M},
     {"glGenBuffers", offsetof(struct glfunctions, GenBuffers), M},
     {"glGenFramebuffers", offsetof(struct glfunctions, GenFramebuffers), M},
+    {"glGenQueries", offsetof(struct glfunctions, GenQueries), 0},
     {"glGenRenderbuffers", offsetof(struct glfunctions, GenRenderbuffers), M},
     {"glGenTextures", offsetof(struct glfunctions, GenTextures), M},
     {"glGenVertexArrays", offsetof(struct glfunctions, GenVertexArrays), 0},
     {"glGenerateMipmap", offsetof(struct glfunctions, GenerateMipmap), M},
     {"glGetActiveUniform", offsetof(struct glfunctions, GetActiveUniform), M},
+    {"glGetActiveUniformBlockiv", offsetof(struct glfunctions, GetActiveUniformBlockiv), 0},
+    {"glGetActiveUniformsiv", offsetof(struct glfunctions, GetActiveUniformsiv), 0},
     {"glGetAttachedShaders", offsetof(struct glfunctions, GetAttachedShaders), M},
     {"glGetAttribLocation", offsetof(struct glfunctions, GetAttribLocation), M},
     {"glGetBooleanv", offsetof(struct glfunctions, GetBooleanv), M},
@@ -73,6 +87,8 @@ static const struct gldefinition {
     {"glGetProgramResourceLocation", offsetof(struct glfunctions, GetProgramResourceLocation), 0},
     {"glGetProgramResourceiv", offsetof(struct glfunctions, GetProgramResourceiv), 0},
     {"glGetProgramiv", offsetof(struct glfunctions, GetProgramiv), M},
+    {"glGetQueryObjectui64v", offsetof(struct glfunctions, GetQueryObjectui64v), 0},
+    {"glGetQueryObjectuiv", offsetof(struct glfunctions, GetQueryObjectuiv), 0},
     {"glGetRenderbufferParameteriv", offsetof(struct glfunctions, GetRenderbufferParameteriv), M},
     {"glGetShaderInfoLog", offsetof(struct glfunctions, GetShaderInfoLog), M},
     {"glGetShaderSource", offsetof(struct glfunctions, GetShaderSource), M},
@@ -80,10 +96,13 @@ static const struct gldefinition {
     {"glGetString", offsetof(struct glfunctions, GetString), M},
     {"glGetStringi", offsetof(struct glfunctions, GetStringi), M},
     {"glGetUniformLocation", offsetof(struct glfunctions, GetUniformLocation), M},
+    {"glInvalidateFramebuffer", offsetof(struct glfunctions, InvalidateFramebuffer), 0},
     {"glLinkProgram", offsetof(struct glfunctions, LinkProgram), M},
+    {"glMapBufferRange", offsetof(struct glfunctions, MapBufferRange), R},
     {"glMemoryBarrier", offsetof(struct glfunctions, MemoryBarrier), 0},
+    {"glMultiDrawElementsIndirect", offsetof(struct glfunctions, MultiDrawElementsIndirect), 0},
     {"glPolygonMode", offsetof(struct glfunctions, PolygonMode), 0},
-    {"glReadPixels", offsetof(struct glfunctions, ReadPixels), M},
+    {"glReadPixels", offsetof(struct glfunctions, ReadPixels), M|R},
     {"glReleaseShaderCompiler", offsetof(struct glfunctions, ReleaseShaderCompiler), M},
     {"glRenderbufferStorage", offsetof(struct glfunctions, RenderbufferStorage), M},
     {"glRenderbufferStorageMultisample", offsetof(struct glfunctions, RenderbufferStorageMultisample), M},
@@ -118,9 +137,11 @@ static const struct gldefinition {
     {"glUniform4fv", offsetof(struct glfunctions, Uniform4fv), M},
     {"glUniform4i", offsetof(struct glfunctions, Uniform4i), M},
     {"glUniform4iv", offsetof(struct glfunctions, Uniform4iv), M},
+    {"glUniformBlockBinding", offsetof(struct glfunctions, UniformBlockBinding), 0},
     {"glUniformMatrix2fv", offsetof(struct glfunctions, UniformMatrix2fv), M},
     {"glUniformMatrix3fv", offsetof(struct glfunctions, UniformMatrix3fv), M},
     {"glUniformMatrix4fv", offsetof(struct glfunctions, UniformMatrix4fv), M},
+    {"glUnmapBuffer", offsetof(struct glfunctions, UnmapBuffer), 0},
     {"glUseProgram", offsetof(struct glfunctions, UseProgram), M},
     {"glVertexAttribPointer", offsetof(struct glfunctions, VertexAttribPointer), M},
     {"glViewport", offsetof(struct glfunctions, Viewport), M},
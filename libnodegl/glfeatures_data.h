@@ -78,6 +78,7 @@ static const struct glfeature {
         .min_es_version = 1,
         .extensions     = (const char*[]){"GL_ARB_compute_shader", NULL},
         .funcs_offsets  = (const size_t[]){OFFSET(DispatchCompute),
+                                           OFFSET(DispatchComputeIndirect),
                                            OFFSET(MemoryBarrier),
                                            -1}
     }, {
@@ -133,5 +134,76 @@ static const struct glfeature {
         .extensions     = (const char*[]){"ARB_internalformat_query", NULL},
         .funcs_offsets  = (const size_t[]){OFFSET(GetInternalformativ),
                                            -1}
+    }, {
+        .name           = "timer_query",
+        .flag           = NGLI_FEATURE_TIMER_QUERY,
+        .maj_version    = 3,
+        .min_version    = 3,
+        .maj_es_version = -1, /* not part of any OpenGLES core version */
+        .extensions     = (const char*[]){"GL_ARB_timer_query", NULL},
+        .es_extensions  = (const char*[]){"GL_EXT_disjoint_timer_query", NULL},
+        .funcs_offsets  = (const size_t[]){OFFSET(GenQueries),
+                                           OFFSET(DeleteQueries),
+                                           OFFSET(BeginQuery),
+                                           OFFSET(EndQuery),
+                                           OFFSET(GetQueryObjectuiv),
+                                           OFFSET(GetQueryObjectui64v),
+                                           -1}
+    }, {
+        .name           = "buffer_storage",
+        .flag           = NGLI_FEATURE_BUFFER_STORAGE,
+        .maj_version    = 4,
+        .min_version    = 4,
+        .maj_es_version = -1, /* not part of any OpenGLES core version */
+        .extensions     = (const char*[]){"GL_ARB_buffer_storage", NULL},
+        .funcs_offsets  = (const size_t[]){OFFSET(BufferStorage),
+                                           OFFSET(MapBufferRange),
+                                           OFFSET(UnmapBuffer),
+                                           OFFSET(FenceSync),
+                                           OFFSET(ClientWaitSync),
+                                           OFFSET(DeleteSync),
+                                           -1}
+    }, {
+        .name           = "uniform_buffer_object",
+        .flag           = NGLI_FEATURE_UNIFORM_BUFFER_OBJECT,
+        .maj_version    = 3,
+        .min_version    = 1,
+        .maj_es_version = 3,
+        .min_es_version = 0,
+        .extensions     = (const char*[]){"GL_ARB_uniform_buffer_object", NULL},
+        .funcs_offsets  = (const size_t[]){OFFSET(GetActiveUniformBlockiv),
+                                           OFFSET(GetActiveUniformsiv),
+                                           OFFSET(UniformBlockBinding),
+                                           OFFSET(BindBufferRange),
+                                           -1}
+    }, {
+        .name           = "invalidate_subdata",
+        .flag           = NGLI_FEATURE_INVALIDATE_SUBDATA,
+        .maj_version    = 4,
+        .min_version    = 3,
+        .maj_es_version = 3,
+        .min_es_version = 0,
+        .extensions     = (const char*[]){"GL_ARB_invalidate_subdata", NULL},
+        .funcs_offsets  = (const size_t[]){OFFSET(InvalidateFramebuffer),
+                                           -1}
+    }, {
+        .name           = "draw_indirect",
+        .flag           = NGLI_FEATURE_DRAW_INDIRECT,
+        .maj_version    = 4,
+        .min_version    = 0,
+        .maj_es_version = 3,
+        .min_es_version = 1,
+        .extensions     = (const char*[]){"GL_ARB_draw_indirect", NULL},
+        .funcs_offsets  = (const size_t[]){OFFSET(DrawElementsIndirect),
+                                           -1}
+    }, {
+        .name           = "multi_draw_indirect",
+        .flag           = NGLI_FEATURE_MULTI_DRAW_INDIRECT,
+        .maj_version    = 4,
+        .min_version    = 3,
+        .maj_es_version = -1, /* not part of any OpenGLES core version */
+        .extensions     = (const char*[]){"GL_ARB_multi_draw_indirect", NULL},
+        .funcs_offsets  = (const size_t[]){OFFSET(MultiDrawElementsIndirect),
+                                           -1}
     }
 };
@@ -11,12 +11,16 @@
 #define NGLI_GL_APIENTRY
 #endif
 
+struct glstats;
+
 struct glfunctions {
     NGLI_GL_APIENTRY void (*ActiveTexture)(GLenum texture);
     NGLI_GL_APIENTRY void (*AttachShader)(GLuint program, GLuint shader);
+    NGLI_GL_APIENTRY void (*BeginQuery)(GLenum target, GLuint id);
     NGLI_GL_APIENTRY void (*BindAttribLocation)(GLuint program, GLuint index, const GLchar * name);
     NGLI_GL_APIENTRY void (*BindBuffer)(GLenum target, GLuint buffer);
     NGLI_GL_APIENTRY void (*BindBufferBase)(GLenum target, GLuint index, GLuint buffer);
+    NGLI_GL_APIENTRY void (*BindBufferRange)(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
     NGLI_GL_APIENTRY void (*BindFramebuffer)(GLenum target, GLuint framebuffer);
     NGLI_GL_APIENTRY void (*BindImageTexture)(GLuint unit, GLuint texture, GLint level, GLboolean layered, GLint layer, GLenum access, GLenum format);
     NGLI_GL_APIENTRY void (*BindRenderbuffer)(GLenum target, GLuint renderbuffer);
@@ -29,10 +33,12 @@ struct glfunctions {
     NGLI_GL_APIENTRY void (*BlendFuncSeparate)(GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha);
     NGLI_GL_APIENTRY void (*BlitFramebuffer)(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter);
     NGLI_GL_APIENTRY void (*BufferData)(GLenum target, GLsizeiptr size, const void * data, GLenum usage);
+    NGLI_GL_APIENTRY void (*BufferStorage)(GLenum target, GLsizeiptr size, const void * data, GLbitfield flags);
     NGLI_GL_APIENTRY void (*BufferSubData)(GLenum target, GLintptr offset, GLsizeiptr size, const void * data);
     NGLI_GL_APIENTRY GLenum (*CheckFramebufferStatus)(GLenum target);
     NGLI_GL_APIENTRY void (*Clear)(GLbitfield mask);
     NGLI_GL_APIENTRY void (*ClearColor)(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha);
+    NGLI_GL_APIENTRY GLenum (*ClientWaitSync)(GLsync sync, GLbitfield flags, GLuint64 timeout);
     NGLI_GL_APIENTRY void (*ColorMask)(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha);
     NGLI_GL_APIENTRY void (*CompileShader)(GLuint shader);
     NGLI_GL_APIENTRY GLuint (*CreateProgram)();
@@ -40,8 +46,10 @@ struct glfunctions {
     NGLI_GL_APIENTRY void (*DeleteBuffers)(GLsizei n, const GLuint * buffers);
     NGLI_GL_APIENTRY void (*DeleteFramebuffers)(GLsizei n, const GLuint * framebuffers);
     NGLI_GL_APIENTRY void (*DeleteProgram)(GLuint program);
+    NGLI_GL_APIENTRY void (*DeleteQueries)(GLsizei n, const GLuint * ids);
     NGLI_GL_APIENTRY void (*DeleteRenderbuffers)(GLsizei n, const GLuint * renderbuffers);
     NGLI_GL_APIENTRY void (*DeleteShader)(GLuint shader);
+    NGLI_GL_APIENTRY void (*DeleteSync)(GLsync sync);
     NGLI_GL_APIENTRY void (*DeleteTextures)(GLsizei n, const GLuint * textures);
     NGLI_GL_APIENTRY void (*DeleteVertexArrays)(GLsizei n, const GLuint * arrays);
     NGLI_GL_APIENTRY void (*DepthFunc)(GLenum func);
@@ -50,18 +58,25 @@ struct glfunctions {
     NGLI_GL_APIENTRY void (*Disable)(GLenum cap);
     NGLI_GL_APIENTRY void (*DisableVertexAttribArray)(GLuint index);
     NGLI_GL_APIENTRY void (*DispatchCompute)(GLuint num_groups_x, GLuint num_groups_y, GLuint num_groups_z);
+    NGLI_GL_APIENTRY void (*DispatchComputeIndirect)(GLintptr indirect);
     NGLI_GL_APIENTRY void (*DrawElements)(GLenum mode, GLsizei count, GLenum type, const void * indices);
+    NGLI_GL_APIENTRY void (*DrawElementsIndirect)(GLenum mode, GLenum type, const void * indirect);
     NGLI_GL_APIENTRY void (*Enable)(GLenum cap);
     NGLI_GL_APIENTRY void (*EnableVertexAttribArray)(GLuint index);
+    NGLI_GL_APIENTRY void (*EndQuery)(GLenum target);
+    NGLI_GL_APIENTRY GLsync (*FenceSync)(GLenum condition, GLbitfield flags);
     NGLI_GL_APIENTRY void (*FramebufferRenderbuffer)(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer);
     NGLI_GL_APIENTRY void (*FramebufferTexture2D)(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level);
     NGLI_GL_APIENTRY void (*GenBuffers)(GLsizei n, GLuint * buffers);
     NGLI_GL_APIENTRY void (*GenFramebuffers)(GLsizei n, GLuint * framebuffers);
+    NGLI_GL_APIENTRY void (*GenQueries)(GLsizei n, GLuint * ids);
     NGLI_GL_APIENTRY void (*GenRenderbuffers)(GLsizei n, GLuint * renderbuffers);
     NGLI_GL_APIENTRY void (*GenTextures)(GLsizei n, GLuint * textures);
     NGLI_GL_APIENTRY void (*GenVertexArrays)(GLsizei n, GLuint * arrays);
     NGLI_GL_APIENTRY void (*GenerateMipmap)(GLenum target);
     NGLI_GL_APIENTRY void (*GetActiveUniform)(GLuint program, GLuint index, GLsizei bufSize, GLsizei * length, GLint * size, GLenum * type, GLchar * name);
+    NGLI_GL_APIENTRY void (*GetActiveUniformBlockiv)(GLuint program, GLuint uniformBlockIndex, GLenum pname, GLint * params);
+    NGLI_GL_APIENTRY void (*GetActiveUniformsiv)(GLuint program, GLsizei uniformCount, const GLuint * uniformIndices, GLenum pname, GLint * params);
     NGLI_GL_APIENTRY void (*GetAttachedShaders)(GLuint program, GLsizei maxCount, GLsizei * count, GLuint * shaders);
     NGLI_GL_APIENTRY GLint (*GetAttribLocation)(GLuint program, const GLchar * name);
     NGLI_GL_APIENTRY void (*GetBooleanv)(GLenum pname, GLboolean * data);
@@ -74,6 +89,8 @@ struct glfunctions {
     NGLI_GL_APIENTRY GLint (*GetProgramResourceLocation)(GLuint program, GLenum programInterface, const GLchar * name);
     NGLI_GL_APIENTRY void (*GetProgramResourceiv)(GLuint program, GLenum programInterface, GLuint index, GLsizei propCount, const GLenum * props, GLsizei bufSize, GLsizei * length, GLint * params);
     NGLI_GL_APIENTRY void (*GetProgramiv)(GLuint program, GLenum pname, GLint * params);
+    NGLI_GL_APIENTRY void (*GetQueryObjectui64v)(GLuint id, GLenum pname, GLuint64 * params);
+    NGLI_GL_APIENTRY void (*GetQueryObjectuiv)(GLuint id, GLenum pname, GLuint * params);
     NGLI_GL_APIENTRY void (*GetRenderbufferParameteriv)(GLenum target, GLenum pname, GLint * params);
     NGLI_GL_APIENTRY void (*GetShaderInfoLog)(GLuint shader, GLsizei bufSize, GLsizei * length, GLchar * infoLog);
     NGLI_GL_APIENTRY void (*GetShaderSource)(GLuint shader, GLsizei bufSize, GLsizei * length, GLchar * source);
@@ -81,8 +98,11 @@ struct glfunctions {
     NGLI_GL_APIENTRY const GLubyte * (*GetString)(GLenum name);
     NGLI_GL_APIENTRY const GLubyte * (*GetStringi)(GLenum name, GLuint index);
     NGLI_GL_APIENTRY GLint (*GetUniformLocation)(GLuint program, const GLchar * name);
+    NGLI_GL_APIENTRY void (*InvalidateFramebuffer)(GLenum target, GLsizei numAttachments, const GLenum * attachments);
     NGLI_GL_APIENTRY void (*LinkProgram)(GLuint program);
+    NGLI_GL_APIENTRY void * (*MapBufferRange)(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
     NGLI_GL_APIENTRY void (*MemoryBarrier)(GLbitfield barriers);
+    NGLI_GL_APIENTRY void (*MultiDrawElementsIndirect)(GLenum mode, GLenum type, const void * indirect, GLsizei drawcount, GLsizei stride);
     NGLI_GL_APIENTRY void (*PolygonMode)(GLenum face, GLenum mode);
     NGLI_GL_APIENTRY void (*ReadPixels)(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void * pixels);
     NGLI_GL_APIENTRY void (*ReleaseShaderCompiler)();
@@ -119,12 +139,153 @@ struct glfunctions {
     NGLI_GL_APIENTRY void (*Uniform4fv)(GLint location, GLsizei count, const GLfloat * value);
     NGLI_GL_APIENTRY void (*Uniform4i)(GLint location, GLint v0, GLint v1, GLint v2, GLint v3);
     NGLI_GL_APIENTRY void (*Uniform4iv)(GLint location, GLsizei count, const GLint * value);
+    NGLI_GL_APIENTRY void (*UniformBlockBinding)(GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding);
     NGLI_GL_APIENTRY void (*UniformMatrix2fv)(GLint location, GLsizei count, GLboolean transpose, const GLfloat * value);
     NGLI_GL_APIENTRY void (*UniformMatrix3fv)(GLint location, GLsizei count, GLboolean transpose, const GLfloat * value);
     NGLI_GL_APIENTRY void (*UniformMatrix4fv)(GLint location, GLsizei count, GLboolean transpose, const GLfloat * value);
+    NGLI_GL_APIENTRY GLboolean (*UnmapBuffer)(GLenum target);
     NGLI_GL_APIENTRY void (*UseProgram)(GLuint program);
     NGLI_GL_APIENTRY void (*VertexAttribPointer)(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void * pointer);
     NGLI_GL_APIENTRY void (*Viewport)(GLint x, GLint y, GLsizei width, GLsizei height);
+
+    struct glstats *stats;
+};
+
+enum {
+    NGLI_GLID_ActiveTexture,
+    NGLI_GLID_AttachShader,
+    NGLI_GLID_BeginQuery,
+    NGLI_GLID_BindAttribLocation,
+    NGLI_GLID_BindBuffer,
+    NGLI_GLID_BindBufferBase,
+    NGLI_GLID_BindBufferRange,
+    NGLI_GLID_BindFramebuffer,
+    NGLI_GLID_BindImageTexture,
+    NGLI_GLID_BindRenderbuffer,
+    NGLI_GLID_BindTexture,
+    NGLI_GLID_BindVertexArray,
+    NGLI_GLID_BlendColor,
+    NGLI_GLID_BlendEquation,
+    NGLI_GLID_BlendEquationSeparate,
+    NGLI_GLID_BlendFunc,
+    NGLI_GLID_BlendFuncSeparate,
+    NGLI_GLID_BlitFramebuffer,
+    NGLI_GLID_BufferData,
+    NGLI_GLID_BufferStorage,
+    NGLI_GLID_BufferSubData,
+    NGLI_GLID_CheckFramebufferStatus,
+    NGLI_GLID_Clear,
+    NGLI_GLID_ClearColor,
+    NGLI_GLID_ClientWaitSync,
+    NGLI_GLID_ColorMask,
+    NGLI_GLID_CompileShader,
+    NGLI_GLID_CreateProgram,
+    NGLI_GLID_CreateShader,
+    NGLI_GLID_DeleteBuffers,
+    NGLI_GLID_DeleteFramebuffers,
+    NGLI_GLID_DeleteProgram,
+    NGLI_GLID_DeleteQueries,
+    NGLI_GLID_DeleteRenderbuffers,
+    NGLI_GLID_DeleteShader,
+    NGLI_GLID_DeleteSync,
+    NGLI_GLID_DeleteTextures,
+    NGLI_GLID_DeleteVertexArrays,
+    NGLI_GLID_DepthFunc,
+    NGLI_GLID_DepthMask,
+    NGLI_GLID_DetachShader,
+    NGLI_GLID_Disable,
+    NGLI_GLID_DisableVertexAttribArray,
+    NGLI_GLID_DispatchCompute,
+    NGLI_GLID_DispatchComputeIndirect,
+    NGLI_GLID_DrawElements,
+    NGLI_GLID_DrawElementsIndirect,
+    NGLI_GLID_Enable,
+    NGLI_GLID_EnableVertexAttribArray,
+    NGLI_GLID_EndQuery,
+    NGLI_GLID_FenceSync,
+    NGLI_GLID_FramebufferRenderbuffer,
+    NGLI_GLID_FramebufferTexture2D,
+    NGLI_GLID_GenBuffers,
+    NGLI_GLID_GenFramebuffers,
+    NGLI_GLID_GenQueries,
+    NGLI_GLID_GenRenderbuffers,
+    NGLI_GLID_GenTextures,
+    NGLI_GLID_GenVertexArrays,
+    NGLI_GLID_GenerateMipmap,
+    NGLI_GLID_GetActiveUniform,
+    NGLI_GLID_GetActiveUniformBlockiv,
+    NGLI_GLID_GetActiveUniformsiv,
+    NGLI_GLID_GetAttachedShaders,
+    NGLI_GLID_GetAttribLocation,
+    NGLI_GLID_GetBooleanv,
+    NGLI_GLID_GetError,
+    NGLI_GLID_GetIntegeri_v,
+    NGLI_GLID_GetIntegerv,
+    NGLI_GLID_GetInternalformativ,
+    NGLI_GLID_GetProgramInfoLog,
+    NGLI_GLID_GetProgramResourceIndex,
+    NGLI_GLID_GetProgramResourceLocation,
+    NGLI_GLID_GetProgramResourceiv,
+    NGLI_GLID_GetProgramiv,
+    NGLI_GLID_GetQueryObjectui64v,
+    NGLI_GLID_GetQueryObjectuiv,
+    NGLI_GLID_GetRenderbufferParameteriv,
+    NGLI_GLID_GetShaderInfoLog,
+    NGLI_GLID_GetShaderSource,
+    NGLI_GLID_GetShaderiv,
+    NGLI_GLID_GetString,
+    NGLI_GLID_GetStringi,
+    NGLI_GLID_GetUniformLocation,
+    NGLI_GLID_InvalidateFramebuffer,
+    NGLI_GLID_LinkProgram,
+    NGLI_GLID_MapBufferRange,
+    NGLI_GLID_MemoryBarrier,
+    NGLI_GLID_MultiDrawElementsIndirect,
+    NGLI_GLID_PolygonMode,
+    NGLI_GLID_ReadPixels,
+    NGLI_GLID_ReleaseShaderCompiler,
+    NGLI_GLID_RenderbufferStorage,
+    NGLI_GLID_RenderbufferStorageMultisample,
+    NGLI_GLID_ShaderBinary,
+    NGLI_GLID_ShaderSource,
+    NGLI_GLID_StencilFunc,
+    NGLI_GLID_StencilFuncSeparate,
+    NGLI_GLID_StencilMask,
+    NGLI_GLID_StencilMaskSeparate,
+    NGLI_GLID_StencilOp,
+    NGLI_GLID_StencilOpSeparate,
+    NGLI_GLID_TexImage2D,
+    NGLI_GLID_TexImage3D,
+    NGLI_GLID_TexParameteri,
+    NGLI_GLID_TexStorage2D,
+    NGLI_GLID_TexStorage3D,
+    NGLI_GLID_TexSubImage2D,
+    NGLI_GLID_TexSubImage3D,
+    NGLI_GLID_Uniform1f,
+    NGLI_GLID_Uniform1fv,
+    NGLI_GLID_Uniform1i,
+    NGLI_GLID_Uniform1iv,
+    NGLI_GLID_Uniform2f,
+    NGLI_GLID_Uniform2fv,
+    NGLI_GLID_Uniform2i,
+    NGLI_GLID_Uniform2iv,
+    NGLI_GLID_Uniform3f,
+    NGLI_GLID_Uniform3fv,
+    NGLI_GLID_Uniform3i,
+    NGLI_GLID_Uniform3iv,
+    NGLI_GLID_Uniform4f,
+    NGLI_GLID_Uniform4fv,
+    NGLI_GLID_Uniform4i,
+    NGLI_GLID_Uniform4iv,
+    NGLI_GLID_UniformBlockBinding,
+    NGLI_GLID_UniformMatrix2fv,
+    NGLI_GLID_UniformMatrix3fv,
+    NGLI_GLID_UniformMatrix4fv,
+    NGLI_GLID_UnmapBuffer,
+    NGLI_GLID_UseProgram,
+    NGLI_GLID_VertexAttribPointer,
+    NGLI_GLID_Viewport,
+    NGLI_GLID_NB
 };
 
 #endif
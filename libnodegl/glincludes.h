@@ -62,6 +62,14 @@
 #if NGL_OGL3_COMPAT_INCLUDES
 # define GL_LUMINANCE                          0x1909
 # define GL_LUMINANCE_ALPHA                    0x190A
+# ifndef GL_MAP_PERSISTENT_BIT
+#  define GL_MAP_PERSISTENT_BIT                0x0040
+#  define GL_MAP_COHERENT_BIT                  0x0080
+# endif
+#endif
+
+#ifndef GL_GPU_DISJOINT_EXT
+# define GL_GPU_DISJOINT_EXT                   0x8FBB
 #endif
 
 #if NGL_GLES2_COMPAT_INCLUDES
@@ -138,6 +146,28 @@
 # define GL_TEXTURE_WRAP_R                     0x8072
 # define GL_MIN                                0x8007
 # define GL_MAX                                0x8008
+# define GL_QUERY_RESULT                       0x8866
+# define GL_QUERY_RESULT_AVAILABLE             0x8867
+# define GL_TIME_ELAPSED                       0x88BF
+# define GL_MAP_READ_BIT                       0x0001
+# define GL_MAP_WRITE_BIT                      0x0002
+# define GL_MAP_INVALIDATE_BUFFER_BIT          0x0008
+# define GL_MAP_PERSISTENT_BIT                 0x0040
+# define GL_MAP_COHERENT_BIT                   0x0080
+# define GL_SYNC_GPU_COMMANDS_COMPLETE         0x9117
+# define GL_SYNC_FLUSH_COMMANDS_BIT            0x00000001
+# define GL_ALREADY_SIGNALED                   0x911A
+# define GL_TIMEOUT_EXPIRED                    0x911B
+# define GL_CONDITION_SATISFIED                0x911C
+# define GL_WAIT_FAILED                        0x911D
+# define GL_UNIFORM_BUFFER                     0x8A11
+# define GL_MAX_UNIFORM_BUFFER_BINDINGS        0x8A2F
+# define GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT    0x8A34
+# define GL_UNIFORM_BLOCK_INDEX                0x8A3A
+# define GL_UNIFORM_OFFSET                     0x8A3B
+# define GL_UNIFORM_ARRAY_STRIDE               0x8A3C
+# define GL_UNIFORM_MATRIX_STRIDE              0x8A3D
+# define GL_UNIFORM_BLOCK_DATA_SIZE            0x8A40
 #endif
 
 #if NGL_CS_COMPAT_INCLUDES
@@ -164,6 +194,9 @@
 # define GL_FRAMEBUFFER_BARRIER_BIT            0x00000400
 # define GL_TRANSFORM_FEEDBACK_BARRIER_BIT     0x00000800
 # define GL_ATOMIC_COUNTER_BARRIER_BIT         0x00001000
+# define GL_SHADER_STORAGE_BARRIER_BIT         0x00002000
+# define GL_DISPATCH_INDIRECT_BUFFER           0x90EE
+# define GL_DRAW_INDIRECT_BUFFER               0x8F3F
 # define GL_ALL_BARRIER_BITS                   0xFFFFFFFF
 #endif
 
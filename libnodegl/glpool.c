@@ -0,0 +1,137 @@
+/*
+ * Copyright 2018 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "glcontext.h"
+#include "glpool.h"
+#include "log.h"
+#include "nodes.h"
+
+/* Maximum number of pooled objects, framebuffers have no storage */
+#define MAX_ENTRIES 64
+
+static const int gpumem_types[] = {
+    [NGLI_GLPOOL_TEXTURE]      = NGLI_GPUMEM_TEXTURE,
+    [NGLI_GLPOOL_RENDERBUFFER] = NGLI_GPUMEM_RENDERBUFFER,
+    [NGLI_GLPOOL_FRAMEBUFFER]  = -1,
+};
+
+static void delete_object(struct ngl_ctx *ctx, const struct glpool_entry *entry)
+{
+    const struct glfunctions *gl = &ctx->glcontext->funcs;
+
+    switch (entry->key.type) {
+    case NGLI_GLPOOL_TEXTURE:      ngli_glDeleteTextures(gl, 1, &entry->id);      break;
+    case NGLI_GLPOOL_RENDERBUFFER: ngli_glDeleteRenderbuffers(gl, 1, &entry->id); break;
+    case NGLI_GLPOOL_FRAMEBUFFER:  ngli_glDeleteFramebuffers(gl, 1, &entry->id);  break;
+    }
+
+    const int gpumem_type = gpumem_types[entry->key.type];
+    if (gpumem_type >= 0)
+        ngli_gpumem_free(&ctx->gpumem, gpumem_type, entry->size);
+}
+
+static void remove_entry(struct glpool *s, int i)
+{
+    s->size -= s->entries[i].size;
+    memmove(&s->entries[i], &s->entries[i + 1], (s->nb_entries - i - 1) * sizeof(*s->entries));
+    s->nb_entries--;
+}
+
+GLuint ngli_glpool_acquire(struct ngl_ctx *ctx, const struct glpool_key *key, int64_t *sizep)
+{
+    struct glpool *s = &ctx->glpool;
+
+    /* Look for the most recently released object first */
+    for (int i = s->nb_entries - 1; i >= 0; i--) {
+        const struct glpool_entry *entry = &s->entries[i];
+        if (memcmp(&entry->key, key, sizeof(*key)))
+            continue;
+        const GLuint id = entry->id;
+        *sizep = entry->size;
+        remove_entry(s, i);
+        s->nb_hits++;
+        return id;
+    }
+
+    s->nb_misses++;
+    return 0;
+}
+
+void ngli_glpool_release(struct ngl_ctx *ctx, const struct glpool_key *key, GLuint id, int64_t size)
+{
+    struct glpool *s = &ctx->glpool;
+
+    if (!id)
+        return;
+
+    struct glpool_entry entry = {.id = id, .size = size};
+    memcpy(&entry.key, key, sizeof(entry.key));
+
+    if (size > s->max_size) {
+        delete_object(ctx, &entry);
+        return;
+    }
+
+    ngli_glpool_trim(ctx, s->max_size - size);
+    if (s->nb_entries == MAX_ENTRIES) {
+        delete_object(ctx, &s->entries[0]);
+        remove_entry(s, 0);
+    }
+
+    if (s->nb_entries == s->entries_size) {
+        const int new_size = s->entries_size ? s->entries_size * 2 : 8;
+        struct glpool_entry *new_entries = realloc(s->entries, new_size * sizeof(*new_entries));
+        if (!new_entries) {
+            delete_object(ctx, &entry);
+            return;
+        }
+        s->entries = new_entries;
+        s->entries_size = new_size;
+    }
+
+    s->entries[s->nb_entries++] = entry;
+    s->size += size;
+}
+
+void ngli_glpool_trim(struct ngl_ctx *ctx, int64_t max_size)
+{
+    struct glpool *s = &ctx->glpool;
+
+    while (s->nb_entries && s->size > max_size) {
+        delete_object(ctx, &s->entries[0]);
+        remove_entry(s, 0);
+    }
+}
+
+void ngli_glpool_reset(struct ngl_ctx *ctx)
+{
+    struct glpool *s = &ctx->glpool;
+
+    for (int i = 0; i < s->nb_entries; i++)
+        delete_object(ctx, &s->entries[i]);
+    free(s->entries);
+    s->entries = NULL;
+    s->nb_entries = s->entries_size = 0;
+    s->size = 0;
+}
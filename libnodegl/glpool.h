@@ -0,0 +1,78 @@
+/*
+ * Copyright 2018 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef GLPOOL_H
+#define GLPOOL_H
+
+#include <stdint.h>
+
+#include "glincludes.h"
+
+#define NGLI_GLPOOL_DEFAULT_MAX_SIZE (64 << 20)
+
+struct ngl_ctx;
+
+enum {
+    NGLI_GLPOOL_TEXTURE,
+    NGLI_GLPOOL_RENDERBUFFER,
+    NGLI_GLPOOL_FRAMEBUFFER,
+    NGLI_GLPOOL_NB_TYPES
+};
+
+/*
+ * Description of a pooled GL object: only an object with the exact same
+ * description can be recycled
+ */
+struct glpool_key {
+    int type;
+    GLenum target;
+    GLenum internal_format;
+    GLenum data_type;   // pixel data type, for the contexts without sized formats
+    int width;
+    int height;
+    int depth;
+    int samples;
+    int immutable;
+};
+
+struct glpool_entry {
+    struct glpool_key key;
+    GLuint id;
+    int64_t size;       // estimated size of the object storage
+};
+
+/* Pool of released GL objects waiting to be recycled */
+struct glpool {
+    int64_t max_size;
+    int64_t size;
+    struct glpool_entry *entries;   // from the least to the most recently released
+    int nb_entries;
+    int entries_size;
+    int64_t nb_hits;
+    int64_t nb_misses;
+};
+
+GLuint ngli_glpool_acquire(struct ngl_ctx *ctx, const struct glpool_key *key, int64_t *sizep);
+void ngli_glpool_release(struct ngl_ctx *ctx, const struct glpool_key *key, GLuint id, int64_t size);
+void ngli_glpool_trim(struct ngl_ctx *ctx, int64_t max_size);
+void ngli_glpool_reset(struct ngl_ctx *ctx);
+
+#endif /* GLPOOL_H */
@@ -0,0 +1,70 @@
+/*
+ * Copyright 2018 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+
+#include "glstats.h"
+
+static int get_nb_comp(GLenum format)
+{
+    switch (format) {
+    case GL_RED:
+    case GL_RED_INTEGER:
+    case GL_ALPHA:
+    case GL_LUMINANCE:
+    case GL_DEPTH_COMPONENT:    return 1;
+    case GL_RG:
+    case GL_RG_INTEGER:
+    case GL_LUMINANCE_ALPHA:    return 2;
+    case GL_RGB:
+    case GL_RGB_INTEGER:        return 3;
+    case GL_RGBA:
+    case GL_RGBA_INTEGER:
+    case GL_BGRA:               return 4;
+    }
+    return 0;
+}
+
+int64_t ngli_glstats_get_pixels_size(GLenum format, GLenum type,
+                                     GLsizei width, GLsizei height, GLsizei depth)
+{
+    int pixel_size = 0;
+
+    switch (type) {
+    case GL_BYTE:
+    case GL_UNSIGNED_BYTE:      pixel_size = 1 * get_nb_comp(format); break;
+    case GL_SHORT:
+    case GL_UNSIGNED_SHORT:
+    case GL_HALF_FLOAT:         pixel_size = 2 * get_nb_comp(format); break;
+    case GL_INT:
+    case GL_UNSIGNED_INT:
+    case GL_FLOAT:              pixel_size = 4 * get_nb_comp(format); break;
+    case GL_UNSIGNED_INT_24_8:  pixel_size = 4; break;
+    case GL_FLOAT_32_UNSIGNED_INT_24_8_REV: pixel_size = 8; break;
+    }
+
+    return (int64_t)pixel_size * width * height * depth;
+}
+
+void ngli_glstats_reset(struct glstats *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+}
@@ -0,0 +1,38 @@
+/*
+ * Copyright 2018 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef GLSTATS_H
+#define GLSTATS_H
+
+#include <stdint.h>
+
+#include "glfunctions.h"
+
+struct glstats {
+    int64_t nb_calls[NGLI_GLID_NB];
+    int64_t nb_bytes[NGLI_GLID_NB];
+};
+
+int64_t ngli_glstats_get_pixels_size(GLenum format, GLenum type,
+                                     GLsizei width, GLsizei height, GLsizei depth);
+void ngli_glstats_reset(struct glstats *stats);
+
+#endif /* GLSTATS_H */
@@ -4,6 +4,7 @@
 #define NGL_GL_H
 
 #include "glfunctions.h"
+#include "glstats.h"
 
 static const char * const errors_str[] = {
     [GL_INVALID_ENUM]                   = "GL_INVALID_ENUM",
@@ -32,116 +33,165 @@ static inline void check_error_code(const struct glfunctions *gl,
 # define check_error_code(gl, glfuncname) do { } while (0)
 #endif
 
+#ifdef CONFIG_GL_STATS
+# define count_call(gl, id, size) do {        \
+    (gl)->stats->nb_calls[id]++;              \
+    (gl)->stats->nb_bytes[id] += (size);      \
+} while (0)
+#else
+# define count_call(gl, id, size) do { } while (0)
+#endif
+
 static inline void ngli_glActiveTexture(const struct glfunctions *gl, GLenum texture)
 {
+    count_call(gl, NGLI_GLID_ActiveTexture, 0);
     gl->ActiveTexture(texture);
     check_error_code(gl, "glActiveTexture");
 }
 
 static inline void ngli_glAttachShader(const struct glfunctions *gl, GLuint program, GLuint shader)
 {
+    count_call(gl, NGLI_GLID_AttachShader, 0);
     gl->AttachShader(program, shader);
     check_error_code(gl, "glAttachShader");
 }
 
+static inline void ngli_glBeginQuery(const struct glfunctions *gl, GLenum target, GLuint id)
+{
+    count_call(gl, NGLI_GLID_BeginQuery, 0);
+    gl->BeginQuery(target, id);
+    check_error_code(gl, "glBeginQuery");
+}
+
 static inline void ngli_glBindAttribLocation(const struct glfunctions *gl, GLuint program, GLuint index, const GLchar * name)
 {
+    count_call(gl, NGLI_GLID_BindAttribLocation, 0);
     gl->BindAttribLocation(program, index, name);
     check_error_code(gl, "glBindAttribLocation");
 }
 
 static inline void ngli_glBindBuffer(const struct glfunctions *gl, GLenum target, GLuint buffer)
 {
+    count_call(gl, NGLI_GLID_BindBuffer, 0);
     gl->BindBuffer(target, buffer);
     check_error_code(gl, "glBindBuffer");
 }
 
 static inline void ngli_glBindBufferBase(const struct glfunctions *gl, GLenum target, GLuint index, GLuint buffer)
 {
+    count_call(gl, NGLI_GLID_BindBufferBase, 0);
     gl->BindBufferBase(target, index, buffer);
     check_error_code(gl, "glBindBufferBase");
 }
 
+static inline void ngli_glBindBufferRange(const struct glfunctions *gl, GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size)
+{
+    count_call(gl, NGLI_GLID_BindBufferRange, 0);
+    gl->BindBufferRange(target, index, buffer, offset, size);
+    check_error_code(gl, "glBindBufferRange");
+}
+
 static inline void ngli_glBindFramebuffer(const struct glfunctions *gl, GLenum target, GLuint framebuffer)
 {
+    count_call(gl, NGLI_GLID_BindFramebuffer, 0);
     gl->BindFramebuffer(target, framebuffer);
     check_error_code(gl, "glBindFramebuffer");
 }
 
 static inline void ngli_glBindImageTexture(const struct glfunctions *gl, GLuint unit, GLuint texture, GLint level, GLboolean layered, GLint layer, GLenum access, GLenum format)
 {
+    count_call(gl, NGLI_GLID_BindImageTexture, 0);
     gl->BindImageTexture(unit, texture, level, layered, layer, access, format);
     check_error_code(gl, "glBindImageTexture");
 }
 
 static inline void ngli_glBindRenderbuffer(const struct glfunctions *gl, GLenum target, GLuint renderbuffer)
 {
+    count_call(gl, NGLI_GLID_BindRenderbuffer, 0);
     gl->BindRenderbuffer(target, renderbuffer);
     check_error_code(gl, "glBindRenderbuffer");
 }
 
 static inline void ngli_glBindTexture(const struct glfunctions *gl, GLenum target, GLuint texture)
 {
+    count_call(gl, NGLI_GLID_BindTexture, 0);
     gl->BindTexture(target, texture);
     check_error_code(gl, "glBindTexture");
 }
 
 static inline void ngli_glBindVertexArray(const struct glfunctions *gl, GLuint array)
 {
+    count_call(gl, NGLI_GLID_BindVertexArray, 0);
     gl->BindVertexArray(array);
     check_error_code(gl, "glBindVertexArray");
 }
 
 static inline void ngli_glBlendColor(const struct glfunctions *gl, GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)
 {
+    count_call(gl, NGLI_GLID_BlendColor, 0);
     gl->BlendColor(red, green, blue, alpha);
     check_error_code(gl, "glBlendColor");
 }
 
 static inline void ngli_glBlendEquation(const struct glfunctions *gl, GLenum mode)
 {
+    count_call(gl, NGLI_GLID_BlendEquation, 0);
     gl->BlendEquation(mode);
     check_error_code(gl, "glBlendEquation");
 }
 
 static inline void ngli_glBlendEquationSeparate(const struct glfunctions *gl, GLenum modeRGB, GLenum modeAlpha)
 {
+    count_call(gl, NGLI_GLID_BlendEquationSeparate, 0);
     gl->BlendEquationSeparate(modeRGB, modeAlpha);
     check_error_code(gl, "glBlendEquationSeparate");
 }
 
 static inline void ngli_glBlendFunc(const struct glfunctions *gl, GLenum sfactor, GLenum dfactor)
 {
+    count_call(gl, NGLI_GLID_BlendFunc, 0);
     gl->BlendFunc(sfactor, dfactor);
     check_error_code(gl, "glBlendFunc");
 }
 
 static inline void ngli_glBlendFuncSeparate(const struct glfunctions *gl, GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha)
 {
+    count_call(gl, NGLI_GLID_BlendFuncSeparate, 0);
     gl->BlendFuncSeparate(sfactorRGB, dfactorRGB, sfactorAlpha, dfactorAlpha);
     check_error_code(gl, "glBlendFuncSeparate");
 }
 
 static inline void ngli_glBlitFramebuffer(const struct glfunctions *gl, GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter)
 {
+    count_call(gl, NGLI_GLID_BlitFramebuffer, 0);
     gl->BlitFramebuffer(srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter);
     check_error_code(gl, "glBlitFramebuffer");
 }
 
 static inline void ngli_glBufferData(const struct glfunctions *gl, GLenum target, GLsizeiptr size, const void * data, GLenum usage)
 {
+    count_call(gl, NGLI_GLID_BufferData, size);
     gl->BufferData(target, size, data, usage);
     check_error_code(gl, "glBufferData");
 }
 
+static inline void ngli_glBufferStorage(const struct glfunctions *gl, GLenum target, GLsizeiptr size, const void * data, GLbitfield flags)
+{
+    count_call(gl, NGLI_GLID_BufferStorage, 0);
+    gl->BufferStorage(target, size, data, flags);
+    check_error_code(gl, "glBufferStorage");
+}
+
 static inline void ngli_glBufferSubData(const struct glfunctions *gl, GLenum target, GLintptr offset, GLsizeiptr size, const void * data)
 {
+    count_call(gl, NGLI_GLID_BufferSubData, size);
     gl->BufferSubData(target, offset, size, data);
     check_error_code(gl, "glBufferSubData");
 }
 
 static inline GLenum ngli_glCheckFramebufferStatus(const struct glfunctions *gl, GLenum target)
 {
+    count_call(gl, NGLI_GLID_CheckFramebufferStatus, 0);
     GLenum ret = gl->CheckFramebufferStatus(target);
     check_error_code(gl, "glCheckFramebufferStatus");
     return ret;
@@ -149,30 +199,43 @@ static inline GLenum ngli_glCheckFramebufferStatus(const struct glfunctions *gl,
 
 static inline void ngli_glClear(const struct glfunctions *gl, GLbitfield mask)
 {
+    count_call(gl, NGLI_GLID_Clear, 0);
     gl->Clear(mask);
     check_error_code(gl, "glClear");
 }
 
 static inline void ngli_glClearColor(const struct glfunctions *gl, GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)
 {
+    count_call(gl, NGLI_GLID_ClearColor, 0);
     gl->ClearColor(red, green, blue, alpha);
     check_error_code(gl, "glClearColor");
 }
 
+static inline GLenum ngli_glClientWaitSync(const struct glfunctions *gl, GLsync sync, GLbitfield flags, GLuint64 timeout)
+{
+    count_call(gl, NGLI_GLID_ClientWaitSync, 0);
+    GLenum ret = gl->ClientWaitSync(sync, flags, timeout);
+    check_error_code(gl, "glClientWaitSync");
+    return ret;
+}
+
 static inline void ngli_glColorMask(const struct glfunctions *gl, GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha)
 {
+    count_call(gl, NGLI_GLID_ColorMask, 0);
     gl->ColorMask(red, green, blue, alpha);
     check_error_code(gl, "glColorMask");
 }
 
 static inline void ngli_glCompileShader(const struct glfunctions *gl, GLuint shader)
 {
+    count_call(gl, NGLI_GLID_CompileShader, 0);
     gl->CompileShader(shader);
     check_error_code(gl, "glCompileShader");
 }
 
 static inline GLuint ngli_glCreateProgram(const struct glfunctions *gl)
 {
+    count_call(gl, NGLI_GLID_CreateProgram, 0);
     GLuint ret = gl->CreateProgram();
     check_error_code(gl, "glCreateProgram");
     return ret;
@@ -180,6 +243,7 @@ static inline GLuint ngli_glCreateProgram(const struct glfunctions *gl)
 
 static inline GLuint ngli_glCreateShader(const struct glfunctions *gl, GLenum type)
 {
+    count_call(gl, NGLI_GLID_CreateShader, 0);
     GLuint ret = gl->CreateShader(type);
     check_error_code(gl, "glCreateShader");
     return ret;
@@ -187,162 +251,253 @@ static inline GLuint ngli_glCreateShader(const struct glfunctions *gl, GLenum ty
 
 static inline void ngli_glDeleteBuffers(const struct glfunctions *gl, GLsizei n, const GLuint * buffers)
 {
+    count_call(gl, NGLI_GLID_DeleteBuffers, 0);
     gl->DeleteBuffers(n, buffers);
     check_error_code(gl, "glDeleteBuffers");
 }
 
 static inline void ngli_glDeleteFramebuffers(const struct glfunctions *gl, GLsizei n, const GLuint * framebuffers)
 {
+    count_call(gl, NGLI_GLID_DeleteFramebuffers, 0);
     gl->DeleteFramebuffers(n, framebuffers);
     check_error_code(gl, "glDeleteFramebuffers");
 }
 
 static inline void ngli_glDeleteProgram(const struct glfunctions *gl, GLuint program)
 {
+    count_call(gl, NGLI_GLID_DeleteProgram, 0);
     gl->DeleteProgram(program);
     check_error_code(gl, "glDeleteProgram");
 }
 
+static inline void ngli_glDeleteQueries(const struct glfunctions *gl, GLsizei n, const GLuint * ids)
+{
+    count_call(gl, NGLI_GLID_DeleteQueries, 0);
+    gl->DeleteQueries(n, ids);
+    check_error_code(gl, "glDeleteQueries");
+}
+
 static inline void ngli_glDeleteRenderbuffers(const struct glfunctions *gl, GLsizei n, const GLuint * renderbuffers)
 {
+    count_call(gl, NGLI_GLID_DeleteRenderbuffers, 0);
     gl->DeleteRenderbuffers(n, renderbuffers);
     check_error_code(gl, "glDeleteRenderbuffers");
 }
 
 static inline void ngli_glDeleteShader(const struct glfunctions *gl, GLuint shader)
 {
+    count_call(gl, NGLI_GLID_DeleteShader, 0);
     gl->DeleteShader(shader);
     check_error_code(gl, "glDeleteShader");
 }
 
+static inline void ngli_glDeleteSync(const struct glfunctions *gl, GLsync sync)
+{
+    count_call(gl, NGLI_GLID_DeleteSync, 0);
+    gl->DeleteSync(sync);
+    check_error_code(gl, "glDeleteSync");
+}
+
 static inline void ngli_glDeleteTextures(const struct glfunctions *gl, GLsizei n, const GLuint * textures)
 {
+    count_call(gl, NGLI_GLID_DeleteTextures, 0);
     gl->DeleteTextures(n, textures);
     check_error_code(gl, "glDeleteTextures");
 }
 
 static inline void ngli_glDeleteVertexArrays(const struct glfunctions *gl, GLsizei n, const GLuint * arrays)
 {
+    count_call(gl, NGLI_GLID_DeleteVertexArrays, 0);
     gl->DeleteVertexArrays(n, arrays);
     check_error_code(gl, "glDeleteVertexArrays");
 }
 
 static inline void ngli_glDepthFunc(const struct glfunctions *gl, GLenum func)
 {
+    count_call(gl, NGLI_GLID_DepthFunc, 0);
     gl->DepthFunc(func);
     check_error_code(gl, "glDepthFunc");
 }
 
 static inline void ngli_glDepthMask(const struct glfunctions *gl, GLboolean flag)
 {
+    count_call(gl, NGLI_GLID_DepthMask, 0);
     gl->DepthMask(flag);
     check_error_code(gl, "glDepthMask");
 }
 
 static inline void ngli_glDetachShader(const struct glfunctions *gl, GLuint program, GLuint shader)
 {
+    count_call(gl, NGLI_GLID_DetachShader, 0);
     gl->DetachShader(program, shader);
     check_error_code(gl, "glDetachShader");
 }
 
 static inline void ngli_glDisable(const struct glfunctions *gl, GLenum cap)
 {
+    count_call(gl, NGLI_GLID_Disable, 0);
     gl->Disable(cap);
     check_error_code(gl, "glDisable");
 }
 
 static inline void ngli_glDisableVertexAttribArray(const struct glfunctions *gl, GLuint index)
 {
+    count_call(gl, NGLI_GLID_DisableVertexAttribArray, 0);
     gl->DisableVertexAttribArray(index);
     check_error_code(gl, "glDisableVertexAttribArray");
 }
 
 static inline void ngli_glDispatchCompute(const struct glfunctions *gl, GLuint num_groups_x, GLuint num_groups_y, GLuint num_groups_z)
 {
+    count_call(gl, NGLI_GLID_DispatchCompute, 0);
     gl->DispatchCompute(num_groups_x, num_groups_y, num_groups_z);
     check_error_code(gl, "glDispatchCompute");
 }
 
+static inline void ngli_glDispatchComputeIndirect(const struct glfunctions *gl, GLintptr indirect)
+{
+    count_call(gl, NGLI_GLID_DispatchComputeIndirect, 0);
+    gl->DispatchComputeIndirect(indirect);
+    check_error_code(gl, "glDispatchComputeIndirect");
+}
+
 static inline void ngli_glDrawElements(const struct glfunctions *gl, GLenum mode, GLsizei count, GLenum type, const void * indices)
 {
+    count_call(gl, NGLI_GLID_DrawElements, 0);
     gl->DrawElements(mode, count, type, indices);
     check_error_code(gl, "glDrawElements");
 }
 
+static inline void ngli_glDrawElementsIndirect(const struct glfunctions *gl, GLenum mode, GLenum type, const void * indirect)
+{
+    count_call(gl, NGLI_GLID_DrawElementsIndirect, 0);
+    gl->DrawElementsIndirect(mode, type, indirect);
+    check_error_code(gl, "glDrawElementsIndirect");
+}
+
 static inline void ngli_glEnable(const struct glfunctions *gl, GLenum cap)
 {
+    count_call(gl, NGLI_GLID_Enable, 0);
     gl->Enable(cap);
     check_error_code(gl, "glEnable");
 }
 
 static inline void ngli_glEnableVertexAttribArray(const struct glfunctions *gl, GLuint index)
 {
+    count_call(gl, NGLI_GLID_EnableVertexAttribArray, 0);
     gl->EnableVertexAttribArray(index);
     check_error_code(gl, "glEnableVertexAttribArray");
 }
 
+static inline void ngli_glEndQuery(const struct glfunctions *gl, GLenum target)
+{
+    count_call(gl, NGLI_GLID_EndQuery, 0);
+    gl->EndQuery(target);
+    check_error_code(gl, "glEndQuery");
+}
+
+static inline GLsync ngli_glFenceSync(const struct glfunctions *gl, GLenum condition, GLbitfield flags)
+{
+    count_call(gl, NGLI_GLID_FenceSync, 0);
+    GLsync ret = gl->FenceSync(condition, flags);
+    check_error_code(gl, "glFenceSync");
+    return ret;
+}
+
 static inline void ngli_glFramebufferRenderbuffer(const struct glfunctions *gl, GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer)
 {
+    count_call(gl, NGLI_GLID_FramebufferRenderbuffer, 0);
     gl->FramebufferRenderbuffer(target, attachment, renderbuffertarget, renderbuffer);
     check_error_code(gl, "glFramebufferRenderbuffer");
 }
 
 static inline void ngli_glFramebufferTexture2D(const struct glfunctions *gl, GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level)
 {
+    count_call(gl, NGLI_GLID_FramebufferTexture2D, 0);
     gl->FramebufferTexture2D(target, attachment, textarget, texture, level);
     check_error_code(gl, "glFramebufferTexture2D");
 }
 
 static inline void ngli_glGenBuffers(const struct glfunctions *gl, GLsizei n, GLuint * buffers)
 {
+    count_call(gl, NGLI_GLID_GenBuffers, 0);
     gl->GenBuffers(n, buffers);
     check_error_code(gl, "glGenBuffers");
 }
 
 static inline void ngli_glGenFramebuffers(const struct glfunctions *gl, GLsizei n, GLuint * framebuffers)
 {
+    count_call(gl, NGLI_GLID_GenFramebuffers, 0);
     gl->GenFramebuffers(n, framebuffers);
     check_error_code(gl, "glGenFramebuffers");
 }
 
+static inline void ngli_glGenQueries(const struct glfunctions *gl, GLsizei n, GLuint * ids)
+{
+    count_call(gl, NGLI_GLID_GenQueries, 0);
+    gl->GenQueries(n, ids);
+    check_error_code(gl, "glGenQueries");
+}
+
 static inline void ngli_glGenRenderbuffers(const struct glfunctions *gl, GLsizei n, GLuint * renderbuffers)
 {
+    count_call(gl, NGLI_GLID_GenRenderbuffers, 0);
     gl->GenRenderbuffers(n, renderbuffers);
     check_error_code(gl, "glGenRenderbuffers");
 }
 
 static inline void ngli_glGenTextures(const struct glfunctions *gl, GLsizei n, GLuint * textures)
 {
+    count_call(gl, NGLI_GLID_GenTextures, 0);
     gl->GenTextures(n, textures);
     check_error_code(gl, "glGenTextures");
 }
 
 static inline void ngli_glGenVertexArrays(const struct glfunctions *gl, GLsizei n, GLuint * arrays)
 {
+    count_call(gl, NGLI_GLID_GenVertexArrays, 0);
     gl->GenVertexArrays(n, arrays);
     check_error_code(gl, "glGenVertexArrays");
 }
 
 static inline void ngli_glGenerateMipmap(const struct glfunctions *gl, GLenum target)
 {
+    count_call(gl, NGLI_GLID_GenerateMipmap, 0);
     gl->GenerateMipmap(target);
     check_error_code(gl, "glGenerateMipmap");
 }
 
 static inline void ngli_glGetActiveUniform(const struct glfunctions *gl, GLuint program, GLuint index, GLsizei bufSize, GLsizei * length, GLint * size, GLenum * type, GLchar * name)
 {
+    count_call(gl, NGLI_GLID_GetActiveUniform, 0);
     gl->GetActiveUniform(program, index, bufSize, length, size, type, name);
     check_error_code(gl, "glGetActiveUniform");
 }
 
+static inline void ngli_glGetActiveUniformBlockiv(const struct glfunctions *gl, GLuint program, GLuint uniformBlockIndex, GLenum pname, GLint * params)
+{
+    count_call(gl, NGLI_GLID_GetActiveUniformBlockiv, 0);
+    gl->GetActiveUniformBlockiv(program, uniformBlockIndex, pname, params);
+    check_error_code(gl, "glGetActiveUniformBlockiv");
+}
+
+static inline void ngli_glGetActiveUniformsiv(const struct glfunctions *gl, GLuint program, GLsizei uniformCount, const GLuint * uniformIndices, GLenum pname, GLint * params)
+{
+    count_call(gl, NGLI_GLID_GetActiveUniformsiv, 0);
+    gl->GetActiveUniformsiv(program, uniformCount, uniformIndices, pname, params);
+    check_error_code(gl, "glGetActiveUniformsiv");
+}
+
 static inline void ngli_glGetAttachedShaders(const struct glfunctions *gl, GLuint program, GLsizei maxCount, GLsizei * count, GLuint * shaders)
 {
+    count_call(gl, NGLI_GLID_GetAttachedShaders, 0);
     gl->GetAttachedShaders(program, maxCount, count, shaders);
     check_error_code(gl, "glGetAttachedShaders");
 }
 
 static inline GLint ngli_glGetAttribLocation(const struct glfunctions *gl, GLuint program, const GLchar * name)
 {
+    count_call(gl, NGLI_GLID_GetAttribLocation, 0);
     GLint ret = gl->GetAttribLocation(program, name);
     check_error_code(gl, "glGetAttribLocation");
     return ret;
@@ -350,12 +505,14 @@ static inline GLint ngli_glGetAttribLocation(const struct glfunctions *gl, GLuin
 
 static inline void ngli_glGetBooleanv(const struct glfunctions *gl, GLenum pname, GLboolean * data)
 {
+    count_call(gl, NGLI_GLID_GetBooleanv, 0);
     gl->GetBooleanv(pname, data);
     check_error_code(gl, "glGetBooleanv");
 }
 
 static inline GLenum ngli_glGetError(const struct glfunctions *gl)
 {
+    count_call(gl, NGLI_GLID_GetError, 0);
     GLenum ret = gl->GetError();
     check_error_code(gl, "glGetError");
     return ret;
@@ -363,30 +520,35 @@ static inline GLenum ngli_glGetError(const struct glfunctions *gl)
 
 static inline void ngli_glGetIntegeri_v(const struct glfunctions *gl, GLenum target, GLuint index, GLint * data)
 {
+    count_call(gl, NGLI_GLID_GetIntegeri_v, 0);
     gl->GetIntegeri_v(target, index, data);
     check_error_code(gl, "glGetIntegeri_v");
 }
 
 static inline void ngli_glGetIntegerv(const struct glfunctions *gl, GLenum pname, GLint * data)
 {
+    count_call(gl, NGLI_GLID_GetIntegerv, 0);
     gl->GetIntegerv(pname, data);
     check_error_code(gl, "glGetIntegerv");
 }
 
 static inline void ngli_glGetInternalformativ(const struct glfunctions *gl, GLenum target, GLenum internalformat, GLenum pname, GLsizei bufSize, GLint * params)
 {
+    count_call(gl, NGLI_GLID_GetInternalformativ, 0);
     gl->GetInternalformativ(target, internalformat, pname, bufSize, params);
     check_error_code(gl, "glGetInternalformativ");
 }
 
 static inline void ngli_glGetProgramInfoLog(const struct glfunctions *gl, GLuint program, GLsizei bufSize, GLsizei * length, GLchar * infoLog)
 {
+    count_call(gl, NGLI_GLID_GetProgramInfoLog, 0);
     gl->GetProgramInfoLog(program, bufSize, length, infoLog);
     check_error_code(gl, "glGetProgramInfoLog");
 }
 
 static inline GLuint ngli_glGetProgramResourceIndex(const struct glfunctions *gl, GLuint program, GLenum programInterface, const GLchar * name)
 {
+    count_call(gl, NGLI_GLID_GetProgramResourceIndex, 0);
     GLuint ret = gl->GetProgramResourceIndex(program, programInterface, name);
     check_error_code(gl, "glGetProgramResourceIndex");
     return ret;
@@ -394,6 +556,7 @@ static inline GLuint ngli_glGetProgramResourceIndex(const struct glfunctions *gl
 
 static inline GLint ngli_glGetProgramResourceLocation(const struct glfunctions *gl, GLuint program, GLenum programInterface, const GLchar * name)
 {
+    count_call(gl, NGLI_GLID_GetProgramResourceLocation, 0);
     GLint ret = gl->GetProgramResourceLocation(program, programInterface, name);
     check_error_code(gl, "glGetProgramResourceLocation");
     return ret;
@@ -401,42 +564,63 @@ static inline GLint ngli_glGetProgramResourceLocation(const struct glfunctions *
 
 static inline void ngli_glGetProgramResourceiv(const struct glfunctions *gl, GLuint program, GLenum programInterface, GLuint index, GLsizei propCount, const GLenum * props, GLsizei bufSize, GLsizei * length, GLint * params)
 {
+    count_call(gl, NGLI_GLID_GetProgramResourceiv, 0);
     gl->GetProgramResourceiv(program, programInterface, index, propCount, props, bufSize, length, params);
     check_error_code(gl, "glGetProgramResourceiv");
 }
 
 static inline void ngli_glGetProgramiv(const struct glfunctions *gl, GLuint program, GLenum pname, GLint * params)
 {
+    count_call(gl, NGLI_GLID_GetProgramiv, 0);
     gl->GetProgramiv(program, pname, params);
     check_error_code(gl, "glGetProgramiv");
 }
 
+static inline void ngli_glGetQueryObjectui64v(const struct glfunctions *gl, GLuint id, GLenum pname, GLuint64 * params)
+{
+    count_call(gl, NGLI_GLID_GetQueryObjectui64v, 0);
+    gl->GetQueryObjectui64v(id, pname, params);
+    check_error_code(gl, "glGetQueryObjectui64v");
+}
+
+static inline void ngli_glGetQueryObjectuiv(const struct glfunctions *gl, GLuint id, GLenum pname, GLuint * params)
+{
+    count_call(gl, NGLI_GLID_GetQueryObjectuiv, 0);
+    gl->GetQueryObjectuiv(id, pname, params);
+    check_error_code(gl, "glGetQueryObjectuiv");
+}
+
 static inline void ngli_glGetRenderbufferParameteriv(const struct glfunctions *gl, GLenum target, GLenum pname, GLint * params)
 {
+    count_call(gl, NGLI_GLID_GetRenderbufferParameteriv, 0);
     gl->GetRenderbufferParameteriv(target, pname, params);
     check_error_code(gl, "glGetRenderbufferParameteriv");
 }
 
 static inline void ngli_glGetShaderInfoLog(const struct glfunctions *gl, GLuint shader, GLsizei bufSize, GLsizei * length, GLchar * infoLog)
 {
+    count_call(gl, NGLI_GLID_GetShaderInfoLog, 0);
     gl->GetShaderInfoLog(shader, bufSize, length, infoLog);
     check_error_code(gl, "glGetShaderInfoLog");
 }
 
 static inline void ngli_glGetShaderSource(const struct glfunctions *gl, GLuint shader, GLsizei bufSize, GLsizei * length, GLchar * source)
 {
+    count_call(gl, NGLI_GLID_GetShaderSource, 0);
     gl->GetShaderSource(shader, bufSize, length, source);
     check_error_code(gl, "glGetShaderSource");
 }
 
 static inline void ngli_glGetShaderiv(const struct glfunctions *gl, GLuint shader, GLenum pname, GLint * params)
 {
+    count_call(gl, NGLI_GLID_GetShaderiv, 0);
     gl->GetShaderiv(shader, pname, params);
     check_error_code(gl, "glGetShaderiv");
 }
 
 static inline const GLubyte * ngli_glGetString(const struct glfunctions *gl, GLenum name)
 {
+    count_call(gl, NGLI_GLID_GetString, 0);
     const GLubyte * ret = gl->GetString(name);
     check_error_code(gl, "glGetString");
     return ret;
@@ -444,6 +628,7 @@ static inline const GLubyte * ngli_glGetString(const struct glfunctions *gl, GLe
 
 static inline const GLubyte * ngli_glGetStringi(const struct glfunctions *gl, GLenum name, GLuint index)
 {
+    count_call(gl, NGLI_GLID_GetStringi, 0);
     const GLubyte * ret = gl->GetStringi(name, index);
     check_error_code(gl, "glGetStringi");
     return ret;
@@ -451,271 +636,353 @@ static inline const GLubyte * ngli_glGetStringi(const struct glfunctions *gl, GL
 
 static inline GLint ngli_glGetUniformLocation(const struct glfunctions *gl, GLuint program, const GLchar * name)
 {
+    count_call(gl, NGLI_GLID_GetUniformLocation, 0);
     GLint ret = gl->GetUniformLocation(program, name);
     check_error_code(gl, "glGetUniformLocation");
     return ret;
 }
 
+static inline void ngli_glInvalidateFramebuffer(const struct glfunctions *gl, GLenum target, GLsizei numAttachments, const GLenum * attachments)
+{
+    count_call(gl, NGLI_GLID_InvalidateFramebuffer, 0);
+    gl->InvalidateFramebuffer(target, numAttachments, attachments);
+    check_error_code(gl, "glInvalidateFramebuffer");
+}
+
 static inline void ngli_glLinkProgram(const struct glfunctions *gl, GLuint program)
 {
+    count_call(gl, NGLI_GLID_LinkProgram, 0);
     gl->LinkProgram(program);
     check_error_code(gl, "glLinkProgram");
 }
 
+static inline void * ngli_glMapBufferRange(const struct glfunctions *gl, GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+    count_call(gl, NGLI_GLID_MapBufferRange, (access & GL_MAP_READ_BIT) ? length : 0);
+    void * ret = gl->MapBufferRange(target, offset, length, access);
+    check_error_code(gl, "glMapBufferRange");
+    return ret;
+}
+
 static inline void ngli_glMemoryBarrier(const struct glfunctions *gl, GLbitfield barriers)
 {
+    count_call(gl, NGLI_GLID_MemoryBarrier, 0);
     gl->MemoryBarrier(barriers);
     check_error_code(gl, "glMemoryBarrier");
 }
 
+static inline void ngli_glMultiDrawElementsIndirect(const struct glfunctions *gl, GLenum mode, GLenum type, const void * indirect, GLsizei drawcount, GLsizei stride)
+{
+    count_call(gl, NGLI_GLID_MultiDrawElementsIndirect, 0);
+    gl->MultiDrawElementsIndirect(mode, type, indirect, drawcount, stride);
+    check_error_code(gl, "glMultiDrawElementsIndirect");
+}
+
 static inline void ngli_glPolygonMode(const struct glfunctions *gl, GLenum face, GLenum mode)
 {
+    count_call(gl, NGLI_GLID_PolygonMode, 0);
     gl->PolygonMode(face, mode);
     check_error_code(gl, "glPolygonMode");
 }
 
 static inline void ngli_glReadPixels(const struct glfunctions *gl, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void * pixels)
 {
+    count_call(gl, NGLI_GLID_ReadPixels, ngli_glstats_get_pixels_size(format, type, width, height, 1));
     gl->ReadPixels(x, y, width, height, format, type, pixels);
     check_error_code(gl, "glReadPixels");
 }
 
 static inline void ngli_glReleaseShaderCompiler(const struct glfunctions *gl)
 {
+    count_call(gl, NGLI_GLID_ReleaseShaderCompiler, 0);
     gl->ReleaseShaderCompiler();
     check_error_code(gl, "glReleaseShaderCompiler");
 }
 
 static inline void ngli_glRenderbufferStorage(const struct glfunctions *gl, GLenum target, GLenum internalformat, GLsizei width, GLsizei height)
 {
+    count_call(gl, NGLI_GLID_RenderbufferStorage, 0);
     gl->RenderbufferStorage(target, internalformat, width, height);
     check_error_code(gl, "glRenderbufferStorage");
 }
 
 static inline void ngli_glRenderbufferStorageMultisample(const struct glfunctions *gl, GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height)
 {
+    count_call(gl, NGLI_GLID_RenderbufferStorageMultisample, 0);
     gl->RenderbufferStorageMultisample(target, samples, internalformat, width, height);
     check_error_code(gl, "glRenderbufferStorageMultisample");
 }
 
 static inline void ngli_glShaderBinary(const struct glfunctions *gl, GLsizei count, const GLuint * shaders, GLenum binaryformat, const void * binary, GLsizei length)
 {
+    count_call(gl, NGLI_GLID_ShaderBinary, 0);
     gl->ShaderBinary(count, shaders, binaryformat, binary, length);
     check_error_code(gl, "glShaderBinary");
 }
 
 static inline void ngli_glShaderSource(const struct glfunctions *gl, GLuint shader, GLsizei count, const GLchar *const* string, const GLint * length)
 {
+    count_call(gl, NGLI_GLID_ShaderSource, 0);
     gl->ShaderSource(shader, count, string, length);
     check_error_code(gl, "glShaderSource");
 }
 
 static inline void ngli_glStencilFunc(const struct glfunctions *gl, GLenum func, GLint ref, GLuint mask)
 {
+    count_call(gl, NGLI_GLID_StencilFunc, 0);
     gl->StencilFunc(func, ref, mask);
     check_error_code(gl, "glStencilFunc");
 }
 
 static inline void ngli_glStencilFuncSeparate(const struct glfunctions *gl, GLenum face, GLenum func, GLint ref, GLuint mask)
 {
+    count_call(gl, NGLI_GLID_StencilFuncSeparate, 0);
     gl->StencilFuncSeparate(face, func, ref, mask);
     check_error_code(gl, "glStencilFuncSeparate");
 }
 
 static inline void ngli_glStencilMask(const struct glfunctions *gl, GLuint mask)
 {
+    count_call(gl, NGLI_GLID_StencilMask, 0);
     gl->StencilMask(mask);
     check_error_code(gl, "glStencilMask");
 }
 
 static inline void ngli_glStencilMaskSeparate(const struct glfunctions *gl, GLenum face, GLuint mask)
 {
+    count_call(gl, NGLI_GLID_StencilMaskSeparate, 0);
     gl->StencilMaskSeparate(face, mask);
     check_error_code(gl, "glStencilMaskSeparate");
 }
 
 static inline void ngli_glStencilOp(const struct glfunctions *gl, GLenum fail, GLenum zfail, GLenum zpass)
 {
+    count_call(gl, NGLI_GLID_StencilOp, 0);
     gl->StencilOp(fail, zfail, zpass);
     check_error_code(gl, "glStencilOp");
 }
 
 static inline void ngli_glStencilOpSeparate(const struct glfunctions *gl, GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass)
 {
+    count_call(gl, NGLI_GLID_StencilOpSeparate, 0);
     gl->StencilOpSeparate(face, sfail, dpfail, dppass);
     check_error_code(gl, "glStencilOpSeparate");
 }
 
 static inline void ngli_glTexImage2D(const struct glfunctions *gl, GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void * pixels)
 {
+    count_call(gl, NGLI_GLID_TexImage2D, pixels ? ngli_glstats_get_pixels_size(format, type, width, height, 1) : 0);
     gl->TexImage2D(target, level, internalformat, width, height, border, format, type, pixels);
     check_error_code(gl, "glTexImage2D");
 }
 
 static inline void ngli_glTexImage3D(const struct glfunctions *gl, GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type, const void * pixels)
 {
+    count_call(gl, NGLI_GLID_TexImage3D, pixels ? ngli_glstats_get_pixels_size(format, type, width, height, depth) : 0);
     gl->TexImage3D(target, level, internalformat, width, height, depth, border, format, type, pixels);
     check_error_code(gl, "glTexImage3D");
 }
 
 static inline void ngli_glTexParameteri(const struct glfunctions *gl, GLenum target, GLenum pname, GLint param)
 {
+    count_call(gl, NGLI_GLID_TexParameteri, 0);
     gl->TexParameteri(target, pname, param);
     check_error_code(gl, "glTexParameteri");
 }
 
 static inline void ngli_glTexStorage2D(const struct glfunctions *gl, GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height)
 {
+    count_call(gl, NGLI_GLID_TexStorage2D, 0);
     gl->TexStorage2D(target, levels, internalformat, width, height);
     check_error_code(gl, "glTexStorage2D");
 }
 
 static inline void ngli_glTexStorage3D(const struct glfunctions *gl, GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth)
 {
+    count_call(gl, NGLI_GLID_TexStorage3D, 0);
     gl->TexStorage3D(target, levels, internalformat, width, height, depth);
     check_error_code(gl, "glTexStorage3D");
 }
 
 static inline void ngli_glTexSubImage2D(const struct glfunctions *gl, GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void * pixels)
 {
+    count_call(gl, NGLI_GLID_TexSubImage2D, ngli_glstats_get_pixels_size(format, type, width, height, 1));
     gl->TexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, pixels);
     check_error_code(gl, "glTexSubImage2D");
 }
 
 static inline void ngli_glTexSubImage3D(const struct glfunctions *gl, GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void * pixels)
 {
+    count_call(gl, NGLI_GLID_TexSubImage3D, ngli_glstats_get_pixels_size(format, type, width, height, depth));
     gl->TexSubImage3D(target, level, xoffset, yoffset, zoffset, width, height, depth, format, type, pixels);
     check_error_code(gl, "glTexSubImage3D");
 }
 
 static inline void ngli_glUniform1f(const struct glfunctions *gl, GLint location, GLfloat v0)
 {
+    count_call(gl, NGLI_GLID_Uniform1f, 0);
     gl->Uniform1f(location, v0);
     check_error_code(gl, "glUniform1f");
 }
 
 static inline void ngli_glUniform1fv(const struct glfunctions *gl, GLint location, GLsizei count, const GLfloat * value)
 {
+    count_call(gl, NGLI_GLID_Uniform1fv, 0);
     gl->Uniform1fv(location, count, value);
     check_error_code(gl, "glUniform1fv");
 }
 
 static inline void ngli_glUniform1i(const struct glfunctions *gl, GLint location, GLint v0)
 {
+    count_call(gl, NGLI_GLID_Uniform1i, 0);
     gl->Uniform1i(location, v0);
     check_error_code(gl, "glUniform1i");
 }
 
 static inline void ngli_glUniform1iv(const struct glfunctions *gl, GLint location, GLsizei count, const GLint * value)
 {
+    count_call(gl, NGLI_GLID_Uniform1iv, 0);
     gl->Uniform1iv(location, count, value);
     check_error_code(gl, "glUniform1iv");
 }
 
 static inline void ngli_glUniform2f(const struct glfunctions *gl, GLint location, GLfloat v0, GLfloat v1)
 {
+    count_call(gl, NGLI_GLID_Uniform2f, 0);
     gl->Uniform2f(location, v0, v1);
     check_error_code(gl, "glUniform2f");
 }
 
 static inline void ngli_glUniform2fv(const struct glfunctions *gl, GLint location, GLsizei count, const GLfloat * value)
 {
+    count_call(gl, NGLI_GLID_Uniform2fv, 0);
     gl->Uniform2fv(location, count, value);
     check_error_code(gl, "glUniform2fv");
 }
 
 static inline void ngli_glUniform2i(const struct glfunctions *gl, GLint location, GLint v0, GLint v1)
 {
+    count_call(gl, NGLI_GLID_Uniform2i, 0);
     gl->Uniform2i(location, v0, v1);
     check_error_code(gl, "glUniform2i");
 }
 
 static inline void ngli_glUniform2iv(const struct glfunctions *gl, GLint location, GLsizei count, const GLint * value)
 {
+    count_call(gl, NGLI_GLID_Uniform2iv, 0);
     gl->Uniform2iv(location, count, value);
     check_error_code(gl, "glUniform2iv");
 }
 
 static inline void ngli_glUniform3f(const struct glfunctions *gl, GLint location, GLfloat v0, GLfloat v1, GLfloat v2)
 {
+    count_call(gl, NGLI_GLID_Uniform3f, 0);
     gl->Uniform3f(location, v0, v1, v2);
     check_error_code(gl, "glUniform3f");
 }
 
 static inline void ngli_glUniform3fv(const struct glfunctions *gl, GLint location, GLsizei count, const GLfloat * value)
 {
+    count_call(gl, NGLI_GLID_Uniform3fv, 0);
     gl->Uniform3fv(location, count, value);
     check_error_code(gl, "glUniform3fv");
 }
 
 static inline void ngli_glUniform3i(const struct glfunctions *gl, GLint location, GLint v0, GLint v1, GLint v2)
 {
+    count_call(gl, NGLI_GLID_Uniform3i, 0);
     gl->Uniform3i(location, v0, v1, v2);
     check_error_code(gl, "glUniform3i");
 }
 
 static inline void ngli_glUniform3iv(const struct glfunctions *gl, GLint location, GLsizei count, const GLint * value)
 {
+    count_call(gl, NGLI_GLID_Uniform3iv, 0);
     gl->Uniform3iv(location, count, value);
     check_error_code(gl, "glUniform3iv");
 }
 
 static inline void ngli_glUniform4f(const struct glfunctions *gl, GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3)
 {
+    count_call(gl, NGLI_GLID_Uniform4f, 0);
     gl->Uniform4f(location, v0, v1, v2, v3);
     check_error_code(gl, "glUniform4f");
 }
 
 static inline void ngli_glUniform4fv(const struct glfunctions *gl, GLint location, GLsizei count, const GLfloat * value)
 {
+    count_call(gl, NGLI_GLID_Uniform4fv, 0);
     gl->Uniform4fv(location, count, value);
     check_error_code(gl, "glUniform4fv");
 }
 
 static inline void ngli_glUniform4i(const struct glfunctions *gl, GLint location, GLint v0, GLint v1, GLint v2, GLint v3)
 {
+    count_call(gl, NGLI_GLID_Uniform4i, 0);
     gl->Uniform4i(location, v0, v1, v2, v3);
     check_error_code(gl, "glUniform4i");
 }
 
 static inline void ngli_glUniform4iv(const struct glfunctions *gl, GLint location, GLsizei count, const GLint * value)
 {
+    count_call(gl, NGLI_GLID_Uniform4iv, 0);
     gl->Uniform4iv(location, count, value);
     check_error_code(gl, "glUniform4iv");
 }
 
+static inline void ngli_glUniformBlockBinding(const struct glfunctions *gl, GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding)
+{
+    count_call(gl, NGLI_GLID_UniformBlockBinding, 0);
+    gl->UniformBlockBinding(program, uniformBlockIndex, uniformBlockBinding);
+    check_error_code(gl, "glUniformBlockBinding");
+}
+
 static inline void ngli_glUniformMatrix2fv(const struct glfunctions *gl, GLint location, GLsizei count, GLboolean transpose, const GLfloat * value)
 {
+    count_call(gl, NGLI_GLID_UniformMatrix2fv, 0);
     gl->UniformMatrix2fv(location, count, transpose, value);
     check_error_code(gl, "glUniformMatrix2fv");
 }
 
 static inline void ngli_glUniformMatrix3fv(const struct glfunctions *gl, GLint location, GLsizei count, GLboolean transpose, const GLfloat * value)
 {
+    count_call(gl, NGLI_GLID_UniformMatrix3fv, 0);
     gl->UniformMatrix3fv(location, count, transpose, value);
     check_error_code(gl, "glUniformMatrix3fv");
 }
 
 static inline void ngli_glUniformMatrix4fv(const struct glfunctions *gl, GLint location, GLsizei count, GLboolean transpose, const GLfloat * value)
 {
+    count_call(gl, NGLI_GLID_UniformMatrix4fv, 0);
     gl->UniformMatrix4fv(location, count, transpose, value);
     check_error_code(gl, "glUniformMatrix4fv");
 }
 
+static inline GLboolean ngli_glUnmapBuffer(const struct glfunctions *gl, GLenum target)
+{
+    count_call(gl, NGLI_GLID_UnmapBuffer, 0);
+    GLboolean ret = gl->UnmapBuffer(target);
+    check_error_code(gl, "glUnmapBuffer");
+    return ret;
+}
+
 static inline void ngli_glUseProgram(const struct glfunctions *gl, GLuint program)
 {
+    count_call(gl, NGLI_GLID_UseProgram, 0);
     gl->UseProgram(program);
     check_error_code(gl, "glUseProgram");
 }
 
 static inline void ngli_glVertexAttribPointer(const struct glfunctions *gl, GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void * pointer)
 {
+    count_call(gl, NGLI_GLID_VertexAttribPointer, 0);
     gl->VertexAttribPointer(index, size, type, normalized, stride, pointer);
     check_error_code(gl, "glVertexAttribPointer");
 }
 
 static inline void ngli_glViewport(const struct glfunctions *gl, GLint x, GLint y, GLsizei width, GLsizei height)
 {
+    count_call(gl, NGLI_GLID_Viewport, 0);
     gl->Viewport(x, y, width, height);
     check_error_code(gl, "glViewport");
 }
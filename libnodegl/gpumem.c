@@ -0,0 +1,134 @@
+/*
+ * Copyright 2018 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gpumem.h"
+#include "log.h"
+#include "utils.h"
+
+void ngli_gpumem_alloc(struct gpumem *s, int type, int64_t size)
+{
+    s->sizes[type] += size;
+    s->nb_resources[type]++;
+    s->total += size;
+    s->peak = NGLI_MAX(s->peak, s->total);
+}
+
+void ngli_gpumem_free(struct gpumem *s, int type, int64_t size)
+{
+    s->sizes[type] -= size;
+    s->nb_resources[type]--;
+    s->total -= size;
+}
+
+int ngli_gpumem_over_budget(const struct gpumem *s)
+{
+    return s->budget > 0 && s->total > s->budget;
+}
+
+void ngli_gpumem_begin_frame(struct gpumem *s)
+{
+    s->frame_id++;
+    s->nb_residencies = 0;
+}
+
+void ngli_gpumem_use(struct gpumem *s, struct gpumem_residency *residency)
+{
+    residency->last_use = s->frame_id;
+    residency->evicted = 0;
+}
+
+int ngli_gpumem_keep(struct gpumem *s, struct gpumem_residency *residency)
+{
+    if (!s->budget)
+        return 1;
+
+    if (residency->evicted)
+        return 0;
+
+    if (s->nb_residencies == s->residencies_size) {
+        const int new_size = s->residencies_size ? s->residencies_size * 2 : 16;
+        struct gpumem_residency **new_residencies = realloc(s->residencies, new_size * sizeof(*new_residencies));
+        if (!new_residencies)
+            return 1;
+        s->residencies = new_residencies;
+        s->residencies_size = new_size;
+    }
+    s->residencies[s->nb_residencies++] = residency;
+    return 1;
+}
+
+/*
+ * Evict the least recently used idle resources. The resources are actually
+ * released during the next frame prefetch stage, so only one of them is
+ * evicted per frame to avoid releasing more than needed to honor the budget.
+ */
+void ngli_gpumem_evict(struct gpumem *s)
+{
+    if (!ngli_gpumem_over_budget(s))
+        return;
+
+    struct gpumem_residency *lru = NULL;
+    for (int i = 0; i < s->nb_residencies; i++) {
+        struct gpumem_residency *residency = s->residencies[i];
+        if (residency->evicted)
+            continue;
+        if (!lru || residency->last_use < lru->last_use)
+            lru = residency;
+    }
+
+    if (!lru) {
+        LOG(DEBUG, "GPU memory budget exceeded (%" PRId64 " > %" PRId64 ") "
+            "but no idle resources can be evicted", s->total, s->budget);
+        return;
+    }
+
+    LOG(DEBUG, "GPU memory budget exceeded (%" PRId64 " > %" PRId64 "), "
+        "evict resources last used %" PRId64 " frames ago",
+        s->total, s->budget, s->frame_id - lru->last_use);
+    lru->evicted = 1;
+    s->nb_evictions++;
+}
+
+void ngli_gpumem_get(const struct gpumem *s, struct ngl_memory_stats *out)
+{
+    out->budget = s->budget;
+    out->total = s->total;
+    out->peak = s->peak;
+    out->textures = s->sizes[NGLI_GPUMEM_TEXTURE];
+    out->buffers = s->sizes[NGLI_GPUMEM_BUFFER];
+    out->renderbuffers = s->sizes[NGLI_GPUMEM_RENDERBUFFER];
+    out->nb_textures = s->nb_resources[NGLI_GPUMEM_TEXTURE];
+    out->nb_buffers = s->nb_resources[NGLI_GPUMEM_BUFFER];
+    out->nb_renderbuffers = s->nb_resources[NGLI_GPUMEM_RENDERBUFFER];
+    out->nb_evictions = s->nb_evictions;
+}
+
+void ngli_gpumem_reset(struct gpumem *s)
+{
+    if (s->total)
+        LOG(WARNING, "%" PRId64 " bytes of GPU memory still allocated", s->total);
+    free(s->residencies);
+    memset(s, 0, sizeof(*s));
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2018 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef GPUMEM_H
+#define GPUMEM_H
+
+#include <stdint.h>
+
+#include "nodegl.h"
+
+enum {
+    NGLI_GPUMEM_TEXTURE,
+    NGLI_GPUMEM_BUFFER,
+    NGLI_GPUMEM_RENDERBUFFER,
+    NGLI_GPUMEM_NB_TYPES
+};
+
+/*
+ * Residency state of resources kept alive while they are not used, such as
+ * the children of a TimeRangeFilter prefetched ahead of time or kept around
+ * for their next use
+ */
+struct gpumem_residency {
+    int64_t last_use;   // frame in which the resources were last used
+    int evicted;        // the resources must not be kept alive until their next use
+};
+
+/* Per context GPU memory accounting */
+struct gpumem {
+    int64_t budget;     // 0 if unlimited
+    int64_t sizes[NGLI_GPUMEM_NB_TYPES];
+    int nb_resources[NGLI_GPUMEM_NB_TYPES];
+    int64_t total;
+    int64_t peak;
+    int64_t nb_evictions;
+    int64_t frame_id;
+
+    struct gpumem_residency **residencies;  // idle resources kept alive during the current frame
+    int nb_residencies;
+    int residencies_size;
+};
+
+void ngli_gpumem_alloc(struct gpumem *s, int type, int64_t size);
+void ngli_gpumem_free(struct gpumem *s, int type, int64_t size);
+int ngli_gpumem_over_budget(const struct gpumem *s);
+void ngli_gpumem_begin_frame(struct gpumem *s);
+void ngli_gpumem_use(struct gpumem *s, struct gpumem_residency *residency);
+int ngli_gpumem_keep(struct gpumem *s, struct gpumem_residency *residency);
+void ngli_gpumem_evict(struct gpumem *s);
+void ngli_gpumem_get(const struct gpumem *s, struct ngl_memory_stats *out);
+void ngli_gpumem_reset(struct gpumem *s);
+
+#endif /* GPUMEM_H */
@@ -93,6 +93,7 @@ int ngli_hmap_set(struct hmap *hm, const char *key, void *data)
                 b->nb_entries--;
                 if (!b->nb_entries) {
                     free(b->entries);
+                    b->entries = NULL;
                 } else {
                     memmove(e, e + 1, (b->nb_entries - i) * sizeof(*b->entries));
                     struct hmap_entry *entries =
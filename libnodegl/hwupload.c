@@ -39,6 +39,7 @@
 #include "math_utils.h"
 #include "nodegl.h"
 #include "nodes.h"
+#include "trace.h"
 
 enum {
     HWUPLOAD_FMT_NONE,
@@ -722,14 +723,6 @@ static int upload_vt_frame(struct ngl_node *node, struct hwupload_config *config
         ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, s->mag_filter);
         ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, s->wrap_s);
         ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, s->wrap_t);
-        switch (s->min_filter) {
-        case GL_NEAREST_MIPMAP_NEAREST:
-        case GL_NEAREST_MIPMAP_LINEAR:
-        case GL_LINEAR_MIPMAP_NEAREST:
-        case GL_LINEAR_MIPMAP_LINEAR:
-            ngli_glGenerateMipmap(gl, GL_TEXTURE_2D);
-            break;
-        }
         ngli_glBindTexture(gl, GL_TEXTURE_2D, 0);
         break;
     }
@@ -813,7 +806,10 @@ int ngli_hwupload_upload_frame(struct ngl_node *node, struct sxplayer_frame *fra
     if (ret < 0)
         return ret;
 
-    return hwupload_upload_frame(node, &config, frame);
+    TRACE_BEGIN("hwupload", node->name);
+    ret = hwupload_upload_frame(node, &config, frame);
+    TRACE_END("hwupload", node->name);
+    return ret;
 }
 
 void ngli_hwupload_uninit(struct ngl_node *node)
@@ -63,12 +63,12 @@ static void default_callback(void *arg, int level, const char *filename, int ln,
 static struct {
     void *user_arg;
     ngl_log_callback_type callback;
-    int min_level;
 } log_ctx = {
     .callback  = default_callback,
-    .min_level = NGL_LOG_INFO,
 };
 
+int ngli_log_min_level = NGL_LOG_INFO;
+
 void ngl_log_set_callback(void *arg, ngl_log_callback_type callback)
 {
     log_ctx.user_arg = arg;
@@ -77,7 +77,7 @@ void ngl_log_set_callback(void *arg, ngl_log_callback_type callback)
 
 void ngl_log_set_min_level(int level)
 {
-    log_ctx.min_level = level;
+    ngli_log_min_level = level;
 }
 
 void ngli_log_print(int log_level, const char *filename,
@@ -85,7 +85,7 @@ void ngli_log_print(int log_level, const char *filename,
 {
     va_list arg_list;
 
-    if (log_level < log_ctx.min_level)
+    if (log_level < ngli_log_min_level)
         return;
 
     va_start(arg_list, fmt);
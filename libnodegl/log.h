@@ -25,7 +25,25 @@
 #include "nodegl.h"
 #include "utils.h"
 
-#define LOG(log_level, ...) ngli_log_print(NGL_LOG_##log_level, __FILE__, __LINE__, __FUNCTION__, __VA_ARGS__)
+/*
+ * Messages below this level are removed at compile time. It is controlled by
+ * the LOG_LEVEL build option.
+ */
+#ifndef CONFIG_LOG_LEVEL
+#define CONFIG_LOG_LEVEL NGL_LOG_VERBOSE
+#endif
+
+extern int ngli_log_min_level;
+
+/*
+ * The level checks are done before the call so the arguments are not even
+ * evaluated when the message is discarded.
+ */
+#define LOG(log_level, ...) do {                                                            \
+    if (NGL_LOG_##log_level >= CONFIG_LOG_LEVEL &&                                          \
+        NGL_LOG_##log_level >= ngli_log_min_level)                                          \
+        ngli_log_print(NGL_LOG_##log_level, __FILE__, __LINE__, __FUNCTION__, __VA_ARGS__); \
+} while (0)
 
 void ngli_log_print(int log_level, const char *filename,
                     int ln, const char *fn, const char *fmt, ...) ngli_printf_format(5, 6);
@@ -0,0 +1,53 @@
+/*
+ * Copyright 2018 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stddef.h>
+
+#include "glcontext.h"
+#include "memorybarrier.h"
+#include "nodes.h"
+
+void ngli_memorybarrier_write(struct ngl_ctx *ctx, int64_t *write_seq, GLbitfield barriers)
+{
+    struct memorybarrier *s = &ctx->memorybarrier;
+
+    /* A resource without known consumer may still be read back by the
+     * application or consumed by a node initialized later on */
+    s->pending |= barriers ? barriers : GL_ALL_BARRIER_BITS;
+    *write_seq = s->seq + 1;
+}
+
+int ngli_memorybarrier_is_pending(const struct ngl_ctx *ctx, int64_t write_seq)
+{
+    return write_seq > ctx->memorybarrier.seq;
+}
+
+void ngli_memorybarrier_flush(struct ngl_ctx *ctx)
+{
+    struct memorybarrier *s = &ctx->memorybarrier;
+    if (!s->pending)
+        return;
+
+    const struct glfunctions *gl = &ctx->glcontext->funcs;
+    ngli_glMemoryBarrier(gl, s->pending);
+    s->pending = 0;
+    s->seq++;
+}
@@ -0,0 +1,47 @@
+/*
+ * Copyright 2018 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef MEMORYBARRIER_H
+#define MEMORYBARRIER_H
+
+#include <stdint.h>
+
+#include "glincludes.h"
+
+struct ngl_ctx;
+
+/*
+ * Deferred memory barriers for the resources written by the compute
+ * shaders: the barrier is only issued when a resource written since the
+ * last barrier is about to be consumed, with the bits matching the way the
+ * written resources are consumed. Dispatches working on independent
+ * resources are thus not serialized.
+ */
+struct memorybarrier {
+    GLbitfield pending;     // barrier bits required by the pending writes
+    int64_t seq;            // number of barriers issued so far
+};
+
+void ngli_memorybarrier_write(struct ngl_ctx *ctx, int64_t *write_seq, GLbitfield barriers);
+int ngli_memorybarrier_is_pending(const struct ngl_ctx *ctx, int64_t write_seq);
+void ngli_memorybarrier_flush(struct ngl_ctx *ctx);
+
+#endif /* MEMORYBARRIER_H */
@@ -49,12 +49,12 @@ static int get_kf_id(struct ngl_node **animkf, int nb_animkf, int start, double
 
 #define MIX(x, y, a) ((x)*(1.-(a)) + (y)*(a))
 
-static int animatedbuffer_update(struct ngl_node *node, double t)
+static int animatedbuffer_evaluate(struct ngl_node *node, double t)
 {
     struct buffer *s = node->priv_data;
     struct ngl_node **animkf = s->animkf;
     const int nb_animkf = s->nb_animkf;
-    float *dst = (float *)s->data;
+    float *dst = (float *)s->data_ptr;
 
     if (!nb_animkf)
         return 0;
@@ -83,14 +83,16 @@ static int animatedbuffer_update(struct ngl_node *node, double t)
         memcpy(dst, kf->data, s->data_size);
     }
 
-    struct ngl_ctx *ctx = node->ctx;
-    struct glcontext *glcontext = ctx->glcontext;
-    const struct glfunctions *gl = &glcontext->funcs;
+    return 0;
+}
+
+static int animatedbuffer_update(struct ngl_node *node, double t)
+{
+    struct buffer *s = node->priv_data;
 
     if (s->generate_gl_buffer) {
-        ngli_glBindBuffer(gl, GL_ARRAY_BUFFER, s->buffer_id);
-        ngli_glBufferSubData(gl, GL_ARRAY_BUFFER, 0, s->data_size, s->data);
-        ngli_glBindBuffer(gl, GL_ARRAY_BUFFER, 0);
+        ngli_bufstream_write(&s->stream, s->data_ptr);
+        s->buffer_offset = s->stream.offset;
     }
 
     return 0;
@@ -99,9 +101,6 @@ static int animatedbuffer_update(struct ngl_node *node, double t)
 static int animatedbuffer_init(struct ngl_node *node)
 {
     struct buffer *s = node->priv_data;
-    struct ngl_ctx *ctx = node->ctx;
-    struct glcontext *glcontext = ctx->glcontext;
-    const struct glfunctions *gl = &glcontext->funcs;
     double prev_time = 0;
 
     s->data_comp = node->class->id - NGL_NODE_ANIMATEDBUFFERFLOAT + 1;
@@ -136,9 +135,10 @@ static int animatedbuffer_init(struct ngl_node *node)
     if (!s->count)
         return -1;
 
-    s->data = calloc(s->count, s->data_stride);
-    if (!s->data)
+    s->own_buf = calloc(s->count, s->data_stride);
+    if (!s->own_buf)
         return -1;
+    s->data_ptr = s->own_buf;
 
     s->usage  = GL_DYNAMIC_DRAW;
     s->data_comp_type = GL_FLOAT;
@@ -146,10 +146,11 @@ static int animatedbuffer_init(struct ngl_node *node)
     s->data_size = s->count * s->data_stride;
 
     if (s->generate_gl_buffer) {
-        ngli_glGenBuffers(gl, 1, &s->buffer_id);
-        ngli_glBindBuffer(gl, GL_ARRAY_BUFFER, s->buffer_id);
-        ngli_glBufferData(gl, GL_ARRAY_BUFFER, s->data_size, s->data, s->usage);
-        ngli_glBindBuffer(gl, GL_ARRAY_BUFFER, 0);
+        int ret = ngli_bufstream_init(&s->stream, node->ctx, GL_ARRAY_BUFFER,
+                                      s->data_ptr, s->data_size, s->usage);
+        if (ret < 0)
+            return ret;
+        s->buffer_id = s->stream.buffer_id;
     }
 
     return 0;
@@ -157,22 +158,22 @@ static int animatedbuffer_init(struct ngl_node *node)
 
 static void animatedbuffer_uninit(struct ngl_node *node)
 {
-    struct ngl_ctx *ctx = node->ctx;
-    struct glcontext *glcontext = ctx->glcontext;
-    const struct glfunctions *gl = &glcontext->funcs;
-
     struct buffer *s = node->priv_data;
 
-    ngli_glDeleteBuffers(gl, 1, &s->buffer_id);
+    ngli_bufstream_reset(&s->stream);
+    s->buffer_id = 0;
+    s->buffer_offset = 0;
 
-    free(s->data);
-    s->data = NULL;
+    free(s->own_buf);
+    s->own_buf = NULL;
+    s->data_ptr = NULL;
 }
 
 const struct node_class ngli_animatedbufferfloat_class = {
     .id        = NGL_NODE_ANIMATEDBUFFERFLOAT,
     .name      = "AnimatedBufferFloat",
     .init      = animatedbuffer_init,
+    .evaluate  = animatedbuffer_evaluate,
     .update    = animatedbuffer_update,
     .uninit    = animatedbuffer_uninit,
     .priv_size = sizeof(struct buffer),
@@ -184,6 +185,7 @@ const struct node_class ngli_animatedbuffervec2_class = {
     .id        = NGL_NODE_ANIMATEDBUFFERVEC2,
     .name      = "AnimatedBufferVec2",
     .init      = animatedbuffer_init,
+    .evaluate  = animatedbuffer_evaluate,
     .update    = animatedbuffer_update,
     .uninit    = animatedbuffer_uninit,
     .priv_size = sizeof(struct buffer),
@@ -195,6 +197,7 @@ const struct node_class ngli_animatedbuffervec3_class = {
     .id        = NGL_NODE_ANIMATEDBUFFERVEC3,
     .name      = "AnimatedBufferVec3",
     .init      = animatedbuffer_init,
+    .evaluate  = animatedbuffer_evaluate,
     .update    = animatedbuffer_update,
     .uninit    = animatedbuffer_uninit,
     .priv_size = sizeof(struct buffer),
@@ -206,6 +209,7 @@ const struct node_class ngli_animatedbuffervec4_class = {
     .id        = NGL_NODE_ANIMATEDBUFFERVEC4,
     .name      = "AnimatedBufferVec4",
     .init      = animatedbuffer_init,
+    .evaluate  = animatedbuffer_evaluate,
     .update    = animatedbuffer_update,
     .uninit    = animatedbuffer_uninit,
     .priv_size = sizeof(struct buffer),
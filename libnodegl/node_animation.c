@@ -132,8 +132,14 @@ int ngl_anim_evaluate(struct ngl_node *node, void *dst, double t)
         }
     }
 
+    return ngli_animation_evaluate(node, dst, t, &s->eval_current_kf);
+}
+
+int ngli_animation_evaluate(const struct ngl_node *node, void *dst, double t, int *current_kf)
+{
+    const struct animation *s = node->priv_data;
     const int len = node->class->id - NGL_NODE_ANIMATEDFLOAT + 1;
-    return animation_update(s, t, len, dst, &s->eval_current_kf);
+    return animation_update(s, t, len, dst, current_kf);
 }
 
 static int animation_init(struct ngl_node *node)
@@ -155,29 +161,29 @@ static int animation_init(struct ngl_node *node)
     return 0;
 }
 
-static int animatedfloat_update(struct ngl_node *node, double t)
+static int animatedfloat_evaluate(struct ngl_node *node, double t)
 {
     struct animation *s = node->priv_data;
     return animation_update(s, t, 1, &s->scalar, &s->current_kf);
 }
 
-#define UPDATE_FUNC(type, len)                                          \
-static int animated##type##_update(struct ngl_node *node, double t)     \
+#define EVALUATE_FUNC(type, len)                                        \
+static int animated##type##_evaluate(struct ngl_node *node, double t)   \
 {                                                                       \
     struct animation *s = node->priv_data;                              \
     return animation_update(s, t, len, s->values, &s->current_kf);      \
 }
 
-UPDATE_FUNC(vec2,   2);
-UPDATE_FUNC(vec3,   3);
-UPDATE_FUNC(vec4,   4);
-UPDATE_FUNC(quat,   5); /* quaternion (4) + slerp (1) */
+EVALUATE_FUNC(vec2,   2);
+EVALUATE_FUNC(vec3,   3);
+EVALUATE_FUNC(vec4,   4);
+EVALUATE_FUNC(quat,   5); /* quaternion (4) + slerp (1) */
 
 const struct node_class ngli_animatedfloat_class = {
     .id        = NGL_NODE_ANIMATEDFLOAT,
     .name      = "AnimatedFloat",
     .init      = animation_init,
-    .update    = animatedfloat_update,
+    .evaluate  = animatedfloat_evaluate,
     .priv_size = sizeof(struct animation),
     .params    = animatedfloat_params,
     .file      = __FILE__,
@@ -187,7 +193,7 @@ const struct node_class ngli_animatedvec2_class = {
     .id        = NGL_NODE_ANIMATEDVEC2,
     .name      = "AnimatedVec2",
     .init      = animation_init,
-    .update    = animatedvec2_update,
+    .evaluate  = animatedvec2_evaluate,
     .priv_size = sizeof(struct animation),
     .params    = animatedvec2_params,
     .file      = __FILE__,
@@ -197,7 +203,7 @@ const struct node_class ngli_animatedvec3_class = {
     .id        = NGL_NODE_ANIMATEDVEC3,
     .name      = "AnimatedVec3",
     .init      = animation_init,
-    .update    = animatedvec3_update,
+    .evaluate  = animatedvec3_evaluate,
     .priv_size = sizeof(struct animation),
     .params    = animatedvec3_params,
     .file      = __FILE__,
@@ -207,7 +213,7 @@ const struct node_class ngli_animatedvec4_class = {
     .id        = NGL_NODE_ANIMATEDVEC4,
     .name      = "AnimatedVec4",
     .init      = animation_init,
-    .update    = animatedvec4_update,
+    .evaluate  = animatedvec4_evaluate,
     .priv_size = sizeof(struct animation),
     .params    = animatedvec4_params,
     .file      = __FILE__,
@@ -217,7 +223,7 @@ const struct node_class ngli_animatedquat_class = {
     .id        = NGL_NODE_ANIMATEDQUAT,
     .name      = "AnimatedQuat",
     .init      = animation_init,
-    .update    = animatedquat_update,
+    .evaluate  = animatedquat_evaluate,
     .priv_size = sizeof(struct animation),
     .params    = animatedquat_params,
     .file      = __FILE__,
@@ -115,11 +115,11 @@ static int buffer_init_from_filename(struct ngl_node *node)
         return -1;
     }
 
-    s->data = calloc(s->count, s->data_stride);
-    if (!s->data)
+    s->own_buf = calloc(s->count, s->data_stride);
+    if (!s->own_buf)
         return -1;
 
-    ssize_t n = read(s->fd, s->data, s->data_size);
+    ssize_t n = read(s->fd, s->own_buf, s->data_size);
     if (n < 0) {
         LOG(ERROR, "could not read '%s': %zd", s->filename, n);
         return -1;
@@ -139,13 +139,24 @@ static int buffer_init_from_count(struct ngl_node *node)
 
     s->count = s->count ? s->count : 1;
     s->data_size = s->count * s->data_stride;
-    s->data = calloc(s->count, s->data_stride);
-    if (!s->data)
+    s->own_buf = calloc(s->count, s->data_stride);
+    if (!s->own_buf)
         return -1;
 
     return 0;
 }
 
+/*
+ * The data parameter is refcounted and only ever holds the data set by the
+ * user: the data allocated by the node lives in its own field.
+ */
+static void free_own_data(struct buffer *s)
+{
+    free(s->own_buf);
+    s->own_buf = NULL;
+    s->data_ptr = NULL;
+}
+
 static int buffer_init(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
@@ -210,14 +221,26 @@ static int buffer_init(struct ngl_node *node)
         ret = buffer_init_from_filename(node);
     else
         ret = buffer_init_from_count(node);
-    if (ret < 0)
+    if (ret < 0) {
+        free_own_data(s);
         return ret;
+    }
+    s->data_ptr = s->own_buf ? s->own_buf : s->data;
+
+    if (s->generate_gl_buffer && s->share_gl_buffer) {
+        s->cache_entry = ngli_buffercache_acquire(ctx, s->data_ptr, s->data_size, s->usage);
+        if (s->cache_entry) {
+            s->buffer_id = s->cache_entry->buffer_id;
+            return 0;
+        }
+    }
 
     if (s->generate_gl_buffer) {
         ngli_glGenBuffers(gl, 1, &s->buffer_id);
         ngli_glBindBuffer(gl, GL_ARRAY_BUFFER, s->buffer_id);
-        ngli_glBufferData(gl, GL_ARRAY_BUFFER, s->data_size, s->data, s->usage);
+        ngli_glBufferData(gl, GL_ARRAY_BUFFER, s->data_size, s->data_ptr, s->usage);
         ngli_glBindBuffer(gl, GL_ARRAY_BUFFER, 0);
+        ngli_gpumem_alloc(&ctx->gpumem, NGLI_GPUMEM_BUFFER, s->data_size);
     }
 
     return 0;
@@ -238,7 +261,16 @@ static void buffer_uninit(struct ngl_node *node)
         }
     }
 
-    ngli_glDeleteBuffers(gl, 1, &s->buffer_id);
+    if (s->cache_entry) {
+        ngli_buffercache_release(ctx, &s->cache_entry);
+        s->buffer_id = 0;
+    } else if (s->buffer_id) {
+        ngli_glDeleteBuffers(gl, 1, &s->buffer_id);
+        ngli_gpumem_free(&ctx->gpumem, NGLI_GPUMEM_BUFFER, s->data_size);
+        s->buffer_id = 0;
+    }
+
+    free_own_data(s);
 }
 
 #define DEFINE_BUFFER_CLASS(class_id, class_name, type)     \
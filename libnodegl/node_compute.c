@@ -75,6 +75,11 @@ static const struct node_param compute_params[] = {
                    .desc=NGLI_DOCSTRING("uniforms made accessible to the compute `program`")},
     {"buffers",    PARAM_TYPE_NODEDICT, OFFSET(buffers),    .node_types=BUFFERS_TYPES_LIST,
                    .desc=NGLI_DOCSTRING("input and output buffers made accessible to the compute `program`")},
+    {"indirect_buffer", PARAM_TYPE_NODE, OFFSET(indirect_buffer),
+                   .node_types=(const int[]){NGL_NODE_BUFFERUINT, -1},
+                   .desc=NGLI_DOCSTRING("buffer holding the number of work groups in the x, y and z dimensions, "
+                                        "overriding `nb_group_x`, `nb_group_y` and `nb_group_z`; "
+                                        "typically written by a previous `Compute`")},
     {NULL}
 };
 
@@ -168,7 +173,8 @@ static int update_uniforms(struct ngl_node *node)
         while ((entry = ngli_hmap_next(s->buffers, entry))) {
             const struct ngl_node *bnode = entry->data;
             const struct buffer *b = bnode->priv_data;
-            ngli_glBindBufferBase(gl, GL_SHADER_STORAGE_BUFFER, s->buffer_ids[i], b->buffer_id);
+            ngli_glBindBufferRange(gl, GL_SHADER_STORAGE_BUFFER, s->buffer_ids[i], b->buffer_id,
+                                   b->buffer_offset, b->data_size);
             i++;
         }
     }
@@ -192,9 +198,10 @@ static int compute_init(struct ngl_node *node)
         return -1;
     }
 
-    if (s->nb_group_x > glcontext->max_compute_work_group_counts[0] ||
-        s->nb_group_y > glcontext->max_compute_work_group_counts[1] ||
-        s->nb_group_z > glcontext->max_compute_work_group_counts[2]) {
+    if (!s->indirect_buffer &&
+        (s->nb_group_x > glcontext->max_compute_work_group_counts[0] ||
+         s->nb_group_y > glcontext->max_compute_work_group_counts[1] ||
+         s->nb_group_z > glcontext->max_compute_work_group_counts[2])) {
         LOG(ERROR,
             "Compute work group size (%d, %d, %d) exceeds driver limit (%d, %d, %d)",
             s->nb_group_x,
@@ -210,6 +217,21 @@ static int compute_init(struct ngl_node *node)
     if (ret < 0)
         return ret;
 
+    if (s->indirect_buffer) {
+        struct buffer *buffer = s->indirect_buffer->priv_data;
+        buffer->generate_gl_buffer = 1;
+        buffer->barrier_bits |= GL_COMMAND_BARRIER_BIT;
+
+        ret = ngli_node_init(s->indirect_buffer);
+        if (ret < 0)
+            return ret;
+
+        if (buffer->count < 3) {
+            LOG(ERROR, "indirect buffer must hold at least 3 elements (got %d)", buffer->count);
+            return -1;
+        }
+    }
+
     int nb_textures = s->textures ? ngli_hmap_count(s->textures) : 0;
     if (nb_textures > glcontext->max_texture_image_units) {
         LOG(ERROR, "Attached textures count (%d) exceeds driver limit (%d)",
@@ -231,6 +253,9 @@ static int compute_init(struct ngl_node *node)
             if (ret < 0)
                 return ret;
 
+            struct texture *texture = tnode->priv_data;
+            texture->barrier_bits |= GL_SHADER_IMAGE_ACCESS_BARRIER_BIT;
+
             s->textureprograminfos[i].sampler_id = ngli_glGetUniformLocation(gl,
                                                                              program->program_id,
                                                                              entry->key);
@@ -278,6 +303,10 @@ static int compute_init(struct ngl_node *node)
             info.id = ngli_glGetUniformLocation(gl, program->program_id, info.name);
             *infop = info;
         }
+
+        ret = ngli_uniformbuffer_init(&s->uniformbuffer, ctx, program->program_id, s->uniforms);
+        if (ret < 0)
+            return ret;
     }
 
     int nb_buffers = s->buffers ? ngli_hmap_count(s->buffers) : 0;
@@ -292,6 +321,7 @@ static int compute_init(struct ngl_node *node)
             struct ngl_node *unode = entry->data;
             struct buffer *buffer = unode->priv_data;
             buffer->generate_gl_buffer = 1;
+            buffer->barrier_bits |= GL_SHADER_STORAGE_BARRIER_BIT;
 
             ret = ngli_node_init(unode);
             if (ret < 0)
@@ -331,6 +361,7 @@ static void compute_uninit(struct ngl_node *node)
 {
     struct compute *s = node->priv_data;
 
+    ngli_uniformbuffer_reset(&s->uniformbuffer);
     free(s->textureprograminfos);
     free(s->uniform_ids);
     free(s->buffer_ids);
@@ -356,6 +387,7 @@ static int compute_update(struct ngl_node *node, double t)
             if (ret < 0)
                 return ret;
         }
+        ngli_uniformbuffer_update(&s->uniformbuffer);
     }
 
     if (s->buffers) {
@@ -367,9 +399,49 @@ static int compute_update(struct ngl_node *node, double t)
         }
     }
 
+    if (s->indirect_buffer) {
+        int ret = ngli_node_update(s->indirect_buffer, t);
+        if (ret < 0)
+            return ret;
+    }
+
     return ngli_node_update(s->program, t);
 }
 
+static int is_barrier_pending(const struct ngl_node *node)
+{
+    const struct ngl_ctx *ctx = node->ctx;
+    const struct compute *s = node->priv_data;
+
+    if (s->textures) {
+        const struct hmap_entry *entry = NULL;
+        while ((entry = ngli_hmap_next(s->textures, entry))) {
+            const struct ngl_node *tnode = entry->data;
+            const struct texture *texture = tnode->priv_data;
+            if (ngli_memorybarrier_is_pending(ctx, texture->write_seq))
+                return 1;
+        }
+    }
+
+    if (s->buffers) {
+        const struct hmap_entry *entry = NULL;
+        while ((entry = ngli_hmap_next(s->buffers, entry))) {
+            const struct ngl_node *bnode = entry->data;
+            const struct buffer *buffer = bnode->priv_data;
+            if (ngli_memorybarrier_is_pending(ctx, buffer->write_seq))
+                return 1;
+        }
+    }
+
+    if (s->indirect_buffer) {
+        const struct buffer *buffer = s->indirect_buffer->priv_data;
+        if (ngli_memorybarrier_is_pending(ctx, buffer->write_seq))
+            return 1;
+    }
+
+    return 0;
+}
+
 static void compute_draw(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
@@ -382,10 +454,42 @@ static void compute_draw(struct ngl_node *node)
     ngli_glUseProgram(gl, program->program_id);
 
     update_uniforms(node);
+    ngli_uniformbuffer_bind(&s->uniformbuffer);
+
+    /* Only wait for the previous dispatches if they wrote one of our resources */
+    if (is_barrier_pending(node))
+        ngli_memorybarrier_flush(ctx);
+
+    if (s->indirect_buffer) {
+        const struct buffer *buffer = s->indirect_buffer->priv_data;
+        ngli_glBindBuffer(gl, GL_DISPATCH_INDIRECT_BUFFER, buffer->buffer_id);
+        ngli_glDispatchComputeIndirect(gl, buffer->buffer_offset);
+        ngli_glBindBuffer(gl, GL_DISPATCH_INDIRECT_BUFFER, 0);
+    } else {
+        ngli_glDispatchCompute(gl, s->nb_group_x, s->nb_group_y, s->nb_group_z);
+    }
 
-    ngli_glMemoryBarrier(gl, GL_ALL_BARRIER_BITS);
-    ngli_glDispatchCompute(gl, s->nb_group_x, s->nb_group_y, s->nb_group_z);
-    ngli_glMemoryBarrier(gl, GL_ALL_BARRIER_BITS);
+    if (s->textures) {
+        const struct hmap_entry *entry = NULL;
+        while ((entry = ngli_hmap_next(s->textures, entry))) {
+            struct ngl_node *tnode = entry->data;
+            struct texture *texture = tnode->priv_data;
+            if (texture->access != GL_READ_ONLY) {
+                ngli_memorybarrier_write(ctx, &texture->write_seq, texture->barrier_bits);
+                texture->generation++;
+            }
+        }
+    }
+
+    /* The shader storage blocks are assumed to be written */
+    if (s->buffers) {
+        const struct hmap_entry *entry = NULL;
+        while ((entry = ngli_hmap_next(s->buffers, entry))) {
+            struct ngl_node *bnode = entry->data;
+            struct buffer *buffer = bnode->priv_data;
+            ngli_memorybarrier_write(ctx, &buffer->write_seq, buffer->barrier_bits);
+        }
+    }
 }
 
 const struct node_class ngli_compute_class = {
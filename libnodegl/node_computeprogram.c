@@ -27,6 +27,7 @@
 #include "log.h"
 #include "nodegl.h"
 #include "nodes.h"
+#include "trace.h"
 
 #define OFFSET(x) offsetof(struct computeprogram, x)
 static const struct node_param computeprogram_params[] = {
@@ -70,6 +71,8 @@ static GLuint load_shader(struct ngl_node *node, const char *compute_shader_data
 
     GLint result = GL_FALSE;
 
+    TRACE_BEGIN("compile", node->name);
+
     GLuint program = ngli_glCreateProgram(gl);
     GLuint compute_shader = ngli_glCreateShader(gl, GL_COMPUTE_SHADER);
 
@@ -93,6 +96,8 @@ static GLuint load_shader(struct ngl_node *node, const char *compute_shader_data
 
     ngli_glDeleteShader(gl, compute_shader);
 
+    TRACE_END("compile", node->name);
+
     return program;
 
 fail:
@@ -109,6 +114,8 @@ fail:
         ngli_glDeleteProgram(gl, program);
     }
 
+    TRACE_END("compile", node->name);
+
     return 0;
 }
 
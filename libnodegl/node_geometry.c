@@ -42,6 +42,7 @@ struct ngl_node *ngli_geometry_generate_buffer(struct ngl_ctx *ctx, int type, in
 
     struct buffer *buffer = node->priv_data;
     buffer->generate_gl_buffer = 1;
+    buffer->share_gl_buffer = 1;
 
     if (data)
         ngl_node_param_set(node, "data", size, data);
@@ -131,6 +132,7 @@ static int geometry_init(struct ngl_node *node)
 
     struct buffer *vertices = s->vertices_buffer->priv_data;
     vertices->generate_gl_buffer = 1;
+    vertices->barrier_bits |= GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT;
 
     int ret = ngli_node_init(s->vertices_buffer);
     if (ret < 0)
@@ -139,6 +141,7 @@ static int geometry_init(struct ngl_node *node)
     if (s->uvcoords_buffer) {
         struct buffer *buffer = s->uvcoords_buffer->priv_data;
         buffer->generate_gl_buffer = 1;
+        buffer->barrier_bits |= GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT;
 
         int ret = ngli_node_init(s->uvcoords_buffer);
         if (ret < 0)
@@ -156,6 +159,7 @@ static int geometry_init(struct ngl_node *node)
     if (s->normals_buffer) {
         struct buffer *buffer = s->normals_buffer->priv_data;
         buffer->generate_gl_buffer = 1;
+        buffer->barrier_bits |= GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT;
 
         int ret = ngli_node_init(s->normals_buffer);
         if (ret < 0)
@@ -173,6 +177,7 @@ static int geometry_init(struct ngl_node *node)
     if (s->indices_buffer) {
         struct buffer *buffer = s->indices_buffer->priv_data;
         buffer->generate_gl_buffer = 1;
+        buffer->barrier_bits |= GL_ELEMENT_ARRAY_BARRIER_BIT;
 
         int ret = ngli_node_init(s->indices_buffer);
         if (ret < 0)
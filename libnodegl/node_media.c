@@ -32,6 +32,7 @@
 #include "log.h"
 #include "nodegl.h"
 #include "nodes.h"
+#include "trace.h"
 
 #define OFFSET(x) offsetof(struct media, x)
 static const struct node_param media_params[] = {
@@ -206,7 +207,7 @@ static const char * const pix_fmt_names[] = {
     [SXPLAYER_PIXFMT_MEDIACODEC] = "mediacodec",
 };
 
-static int media_update(struct ngl_node *node, double t)
+static int get_media_time(struct ngl_node *node, double t, int *remap_kf, double *media_timep)
 {
     struct media *s = node->priv_data;
     struct ngl_node *anim_node = s->anim;
@@ -222,10 +223,11 @@ static int media_update(struct ngl_node *node, double t)
             if (anim->nb_animkf == 1) {
                 media_time = NGLI_MAX(0, t - kf0->time);
             } else {
-                int ret = ngli_node_update(anim_node, t);
+                double remapped_time;
+                int ret = ngli_animation_evaluate(anim_node, &remapped_time, t, remap_kf);
                 if (ret < 0)
                     return ret;
-                media_time = anim->scalar - initial_seek;
+                media_time = remapped_time - initial_seek;
             }
 
             LOG(VERBOSE, "remapped time f(%g)=%g", t, media_time);
@@ -236,10 +238,94 @@ static int media_update(struct ngl_node *node, double t)
         }
     }
 
-    sxplayer_release_frame(s->frame);
+    *media_timep = media_time;
+    return 0;
+}
+
+/*
+ * The frame is fetched in evaluate() so that the decoding of several medias
+ * can be waited for in parallel, possibly ahead of time. The current frame
+ * is kept until the next update() since it may still be in use by the
+ * textures being drawn.
+ */
+static int media_evaluate(struct ngl_node *node, double t)
+{
+    struct media *s = node->priv_data;
+
+    double media_time;
+    int ret = get_media_time(node, t, &s->remap_kf, &media_time);
+    if (ret < 0)
+        return ret;
+
+    /*
+     * Evaluated again for the same media time (typically after queued
+     * updates invalidated the evaluation ahead): the player would have no
+     * newer frame, so the one already fetched must be kept.
+     */
+    if (s->next_frame && s->next_media_time == media_time)
+        return 0;
+
+    struct sxplayer_frame *preloaded_frame = s->preloaded_frame;
+    s->preloaded_frame = NULL;
+
+    /*
+     * The preload happened for the predicted time of the first use, which a
+     * player driven by a wall clock seldom hits exactly: the media times are
+     * compared instead (they match before the start of a remapped media), and
+     * a preloaded frame fetched for another media time is still used below
+     * if the player has nothing newer.
+     */
+    if (preloaded_frame && s->preload_media_time == media_time) {
+        LOG(VERBOSE, "use frame preloaded from %s at t=%g", node->name, media_time);
+        sxplayer_release_frame(s->next_frame);
+        s->next_frame = preloaded_frame;
+        s->next_media_time = media_time;
+        return 0;
+    }
+
+    sxplayer_release_frame(s->next_frame);
 
     LOG(VERBOSE, "get frame from %s at t=%g", node->name, media_time);
-    struct sxplayer_frame *frame = sxplayer_get_frame(s->player, media_time);
+    TRACE_BEGIN("get_frame", node->name);
+    s->next_frame = sxplayer_get_frame(s->player, media_time);
+    TRACE_END("get_frame", node->name);
+
+    /* No new frame since the preloaded one: it is still the current one */
+    if (!s->next_frame)
+        s->next_frame = preloaded_frame;
+    else
+        sxplayer_release_frame(preloaded_frame);
+    s->next_media_time = media_time;
+    return 0;
+}
+
+/*
+ * Seek and decode the first frame ahead of time, so that the first
+ * evaluate() after the media is started doesn't wait for it.
+ */
+static int media_preload(struct ngl_node *node, double t)
+{
+    struct media *s = node->priv_data;
+
+    double media_time;
+    int ret = get_media_time(node, t, &s->preload_remap_kf, &media_time);
+    if (ret < 0)
+        return ret;
+
+    sxplayer_release_frame(s->preloaded_frame);
+    s->preloaded_frame = sxplayer_get_frame(s->player, media_time);
+    s->preload_media_time = media_time;
+    return 0;
+}
+
+static int media_update(struct ngl_node *node, double t)
+{
+    struct media *s = node->priv_data;
+
+    sxplayer_release_frame(s->frame);
+    struct sxplayer_frame *frame = s->next_frame;
+    s->next_frame = NULL;
+
     if (frame) {
         const char *pix_fmt_str = frame->pix_fmt >= 0 &&
                                   frame->pix_fmt < NGLI_ARRAY_NB(pix_fmt_names) ? pix_fmt_names[frame->pix_fmt]
@@ -248,11 +334,15 @@ static int media_update(struct ngl_node *node, double t)
             if (frame->pix_fmt != SXPLAYER_SMPFMT_FLT) {
                 LOG(ERROR, "Unexpected %s (%d) sxplayer frame",
                     pix_fmt_str ? pix_fmt_str : "unknown", frame->pix_fmt);
+                sxplayer_release_frame(frame);
+                s->frame = NULL;
                 return -1;
             }
             pix_fmt_str = "audio";
         } else if (!pix_fmt_str) {
             LOG(ERROR, "Invalid pixel format %d in sxplayer frame", frame->pix_fmt);
+            sxplayer_release_frame(frame);
+            s->frame = NULL;
             return -1;
         }
         LOG(VERBOSE, "got frame %dx%d %s with ts=%f", frame->width, frame->height,
@@ -266,7 +356,11 @@ static void media_release(struct ngl_node *node)
 {
     struct media *s = node->priv_data;
     sxplayer_release_frame(s->frame);
+    sxplayer_release_frame(s->next_frame);
+    sxplayer_release_frame(s->preloaded_frame);
     s->frame = NULL;
+    s->next_frame = NULL;
+    s->preloaded_frame = NULL;
     sxplayer_stop(s->player);
 }
 
@@ -291,6 +385,8 @@ const struct node_class ngli_media_class = {
     .name      = "Media",
     .init      = media_init,
     .prefetch  = media_prefetch,
+    .evaluate  = media_evaluate,
+    .preload   = media_preload,
     .update    = media_update,
     .release   = media_release,
     .uninit    = media_uninit,
@@ -27,6 +27,7 @@
 #include "log.h"
 #include "nodegl.h"
 #include "nodes.h"
+#include "trace.h"
 
 #ifdef TARGET_ANDROID
 static const char default_fragment_shader[] =
@@ -129,6 +130,8 @@ static GLuint load_program(struct ngl_node *node, const char *vertex, const char
 
     GLint result = GL_FALSE;
 
+    TRACE_BEGIN("compile", node->name);
+
     GLuint program = ngli_glCreateProgram(gl);
     GLuint vertex_shader = ngli_glCreateShader(gl, GL_VERTEX_SHADER);
     GLuint fragment_shader = ngli_glCreateShader(gl, GL_FRAGMENT_SHADER);
@@ -164,6 +167,8 @@ static GLuint load_program(struct ngl_node *node, const char *vertex, const char
     ngli_glDeleteShader(gl, vertex_shader);
     ngli_glDeleteShader(gl, fragment_shader);
 
+    TRACE_END("compile", node->name);
+
     return program;
 
 fail:
@@ -184,6 +189,8 @@ fail:
         ngli_glDeleteProgram(gl, program);
     }
 
+    TRACE_END("compile", node->name);
+
     return 0;
 }
 
@@ -20,6 +20,7 @@
  */
 
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -94,6 +95,11 @@ static const struct node_param render_params[] = {
     {"buffers",  PARAM_TYPE_NODEDICT, OFFSET(buffers),
                  .node_types=BUFFERS_TYPES_LIST,
                  .desc=NGLI_DOCSTRING("buffers made accessible to the `program`")},
+    {"indirect_buffer", PARAM_TYPE_NODE, OFFSET(indirect_buffer),
+                 .node_types=(const int[]){NGL_NODE_BUFFERUINT, -1},
+                 .desc=NGLI_DOCSTRING("buffer holding draw commands of 5 elements each "
+                                      "(`count`, `instance_count`, `first_index`, `base_vertex`, `base_instance`) "
+                                      "overriding the number of indices drawn; typically written by a `Compute`")},
     {NULL}
 };
 
@@ -162,22 +168,22 @@ static int update_uniforms(struct ngl_node *node)
         }
         case NGL_NODE_BUFFERFLOAT: {
             const struct buffer *buffer = unode->priv_data;
-            ngli_glUniform1fv(gl, uid, buffer->count, (const GLfloat *)buffer->data);
+            ngli_glUniform1fv(gl, uid, buffer->count, (const GLfloat *)buffer->data_ptr);
             break;
         }
         case NGL_NODE_BUFFERVEC2: {
             const struct buffer *buffer = unode->priv_data;
-            ngli_glUniform2fv(gl, uid, buffer->count, (const GLfloat *)buffer->data);
+            ngli_glUniform2fv(gl, uid, buffer->count, (const GLfloat *)buffer->data_ptr);
             break;
         }
         case NGL_NODE_BUFFERVEC3: {
             const struct buffer *buffer = unode->priv_data;
-            ngli_glUniform3fv(gl, uid, buffer->count, (const GLfloat *)buffer->data);
+            ngli_glUniform3fv(gl, uid, buffer->count, (const GLfloat *)buffer->data_ptr);
             break;
         }
         case NGL_NODE_BUFFERVEC4: {
             const struct buffer *buffer = unode->priv_data;
-            ngli_glUniform4fv(gl, uid, buffer->count, (const GLfloat *)buffer->data);
+            ngli_glUniform4fv(gl, uid, buffer->count, (const GLfloat *)buffer->data_ptr);
             break;
         }
         default:
@@ -213,6 +219,7 @@ static int update_uniforms(struct ngl_node *node)
 
                 if (info->sampler_id >= 0) {
                     sampling_mode = SAMPLING_MODE_2D;
+                    ngli_texture_update_mipmap(tnode);
                     ngli_glBindTexture(gl, texture->target, texture->id);
                     ngli_glUniform1i(gl, info->sampler_id, texture_index);
                 }
@@ -227,6 +234,7 @@ static int update_uniforms(struct ngl_node *node)
             case GL_TEXTURE_3D:
                 if (info->sampler_id >= 0) {
                     ngli_glActiveTexture(gl, GL_TEXTURE0 + texture_index);
+                    ngli_texture_update_mipmap(tnode);
                     ngli_glBindTexture(gl, texture->target, texture->id);
                     ngli_glUniform1i(gl, info->sampler_id, texture_index);
                 }
@@ -306,7 +314,8 @@ static int update_vertex_attribs(struct ngl_node *node)
         if (program->position_location_id >= 0) {
             ngli_glEnableVertexAttribArray(gl, program->position_location_id);
             ngli_glBindBuffer(gl, GL_ARRAY_BUFFER, buffer->buffer_id);
-            ngli_glVertexAttribPointer(gl, program->position_location_id, buffer->data_comp, GL_FLOAT, GL_FALSE, buffer->data_stride, NULL);
+            ngli_glVertexAttribPointer(gl, program->position_location_id, buffer->data_comp, GL_FLOAT, GL_FALSE, buffer->data_stride,
+                                       (void *)(intptr_t)buffer->buffer_offset);
         }
     }
 
@@ -315,7 +324,8 @@ static int update_vertex_attribs(struct ngl_node *node)
         if (program->uvcoord_location_id >= 0) {
             ngli_glEnableVertexAttribArray(gl, program->uvcoord_location_id);
             ngli_glBindBuffer(gl, GL_ARRAY_BUFFER, buffer->buffer_id);
-            ngli_glVertexAttribPointer(gl, program->uvcoord_location_id, buffer->data_comp, GL_FLOAT, GL_FALSE, buffer->data_stride, NULL);
+            ngli_glVertexAttribPointer(gl, program->uvcoord_location_id, buffer->data_comp, GL_FLOAT, GL_FALSE, buffer->data_stride,
+                                       (void *)(intptr_t)buffer->buffer_offset);
         }
     }
 
@@ -324,7 +334,8 @@ static int update_vertex_attribs(struct ngl_node *node)
         if (program->normal_location_id >= 0) {
             ngli_glEnableVertexAttribArray(gl, program->normal_location_id);
             ngli_glBindBuffer(gl, GL_ARRAY_BUFFER, buffer->buffer_id);
-            ngli_glVertexAttribPointer(gl, program->normal_location_id, buffer->data_comp, GL_FLOAT, GL_FALSE, buffer->data_stride, NULL);
+            ngli_glVertexAttribPointer(gl, program->normal_location_id, buffer->data_comp, GL_FLOAT, GL_FALSE, buffer->data_stride,
+                                       (void *)(intptr_t)buffer->buffer_offset);
         }
     }
 
@@ -338,7 +349,8 @@ static int update_vertex_attribs(struct ngl_node *node)
             struct buffer *buffer = anode->priv_data;
             ngli_glEnableVertexAttribArray(gl, s->attribute_ids[i]);
             ngli_glBindBuffer(gl, GL_ARRAY_BUFFER, buffer->buffer_id);
-            ngli_glVertexAttribPointer(gl, s->attribute_ids[i], buffer->data_comp, GL_FLOAT, GL_FALSE, buffer->data_stride, NULL);
+            ngli_glVertexAttribPointer(gl, s->attribute_ids[i], buffer->data_comp, GL_FLOAT, GL_FALSE, buffer->data_stride,
+                                       (void *)(intptr_t)buffer->buffer_offset);
             i++;
         }
     }
@@ -402,7 +414,8 @@ static int update_buffers(struct ngl_node *node)
         while ((entry = ngli_hmap_next(s->buffers, entry))) {
             const struct ngl_node *bnode = entry->data;
             const struct buffer *buffer = bnode->priv_data;
-            ngli_glBindBufferBase(gl, GL_SHADER_STORAGE_BUFFER, s->buffer_ids[i], buffer->buffer_id);
+            ngli_glBindBufferRange(gl, GL_SHADER_STORAGE_BUFFER, s->buffer_ids[i], buffer->buffer_id,
+                                   buffer->buffer_offset, buffer->data_size);
             i++;
         }
     }
@@ -439,6 +452,27 @@ static int render_init(struct ngl_node *node)
 
     struct program *program = s->program->priv_data;
 
+    if (s->indirect_buffer) {
+        if (!(glcontext->features & NGLI_FEATURE_DRAW_INDIRECT)) {
+            LOG(ERROR, "context does not support indirect draws");
+            return -1;
+        }
+
+        struct buffer *buffer = s->indirect_buffer->priv_data;
+        buffer->generate_gl_buffer = 1;
+        buffer->barrier_bits |= GL_COMMAND_BARRIER_BIT;
+
+        ret = ngli_node_init(s->indirect_buffer);
+        if (ret < 0)
+            return ret;
+
+        if (!buffer->count || buffer->count % 5) {
+            LOG(ERROR, "indirect buffer element count (%d) is not a multiple of 5", buffer->count);
+            return -1;
+        }
+        s->nb_indirect_cmds = buffer->count / 5;
+    }
+
     int nb_uniforms = s->uniforms ? ngli_hmap_count(s->uniforms) : 0;
     if (nb_uniforms > 0) {
         s->uniform_ids = calloc(nb_uniforms, sizeof(*s->uniform_ids));
@@ -473,6 +507,10 @@ static int render_init(struct ngl_node *node)
             info.id = ngli_glGetUniformLocation(gl, program->program_id, info.name);
             *infop = info;
         }
+
+        ret = ngli_uniformbuffer_init(&s->uniformbuffer, ctx, program->program_id, s->uniforms);
+        if (ret < 0)
+            return ret;
     }
 
     int nb_attributes = s->attributes ? ngli_hmap_count(s->attributes) : 0;
@@ -489,6 +527,7 @@ static int render_init(struct ngl_node *node)
             struct ngl_node *anode = entry->data;
             struct buffer *buffer = anode->priv_data;
             buffer->generate_gl_buffer = 1;
+            buffer->barrier_bits |= GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT;
 
             ret = ngli_node_init(anode);
             if (ret < 0)
@@ -554,6 +593,7 @@ static int render_init(struct ngl_node *node)
                 s->disable_1st_texture_unit = 1;
 
             struct texture *texture = tnode->priv_data;
+            texture->barrier_bits |= GL_TEXTURE_FETCH_BARRIER_BIT;
             texture->direct_rendering = texture->direct_rendering &&
                                         info->external_sampler_id >= 0;
             LOG(VERBOSE,
@@ -578,6 +618,7 @@ static int render_init(struct ngl_node *node)
             struct ngl_node *unode = entry->data;
             struct buffer *buffer = unode->priv_data;
             buffer->generate_gl_buffer = 1;
+            buffer->barrier_bits |= GL_SHADER_STORAGE_BARRIER_BIT;
 
             ret = ngli_node_init(unode);
             if (ret < 0)
@@ -632,6 +673,7 @@ static void render_uninit(struct ngl_node *node)
         ngli_glDeleteVertexArrays(gl, 1, &s->vao_id);
     }
 
+    ngli_uniformbuffer_reset(&s->uniformbuffer);
     free(s->textureprograminfos);
     free(s->uniform_ids);
     free(s->attribute_ids);
@@ -665,6 +707,7 @@ static int render_update(struct ngl_node *node, double t)
             if (ret < 0)
                 return ret;
         }
+        ngli_uniformbuffer_update(&s->uniformbuffer);
     }
 
     if (s->buffers &&
@@ -677,9 +720,42 @@ static int render_update(struct ngl_node *node, double t)
         }
     }
 
+    if (s->indirect_buffer) {
+        ret = ngli_node_update(s->indirect_buffer, t);
+        if (ret < 0)
+            return ret;
+    }
+
     return ngli_node_update(s->program, t);
 }
 
+static void draw_indirect(struct ngl_node *node)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    struct glcontext *glcontext = ctx->glcontext;
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    struct render *s = node->priv_data;
+    const struct geometry *geometry = s->geometry->priv_data;
+    const struct buffer *indices_buffer = geometry->indices_buffer->priv_data;
+    const struct buffer *buffer = s->indirect_buffer->priv_data;
+    const GLsizei cmd_size = 5 * sizeof(GLuint);
+
+    ngli_glBindBuffer(gl, GL_DRAW_INDIRECT_BUFFER, buffer->buffer_id);
+    if (s->nb_indirect_cmds > 1 && (glcontext->features & NGLI_FEATURE_MULTI_DRAW_INDIRECT)) {
+        ngli_glMultiDrawElementsIndirect(gl, geometry->draw_mode, indices_buffer->data_comp_type,
+                                         (void *)(intptr_t)buffer->buffer_offset,
+                                         s->nb_indirect_cmds, cmd_size);
+    } else {
+        for (int i = 0; i < s->nb_indirect_cmds; i++) {
+            const intptr_t offset = buffer->buffer_offset + i * cmd_size;
+            ngli_glDrawElementsIndirect(gl, geometry->draw_mode, indices_buffer->data_comp_type,
+                                        (void *)offset);
+        }
+    }
+    ngli_glBindBuffer(gl, GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
 static void render_draw(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
@@ -699,12 +775,18 @@ static void render_draw(struct ngl_node *node)
 
     update_uniforms(node);
     update_buffers(node);
+    ngli_uniformbuffer_bind(&s->uniformbuffer);
 
     const struct geometry *geometry = s->geometry->priv_data;
     const struct buffer *indices_buffer = geometry->indices_buffer->priv_data;
 
+    ngli_memorybarrier_flush(ctx);
+
     ngli_glBindBuffer(gl, GL_ELEMENT_ARRAY_BUFFER, indices_buffer->buffer_id);
-    ngli_glDrawElements(gl, geometry->draw_mode, indices_buffer->count, indices_buffer->data_comp_type, 0);
+    if (s->indirect_buffer)
+        draw_indirect(node);
+    else
+        ngli_glDrawElements(gl, geometry->draw_mode, indices_buffer->count, indices_buffer->data_comp_type, 0);
 
     if (!(glcontext->features & NGLI_FEATURE_VERTEX_ARRAY_OBJECT)) {
         disable_vertex_attribs(node);
@@ -22,11 +22,28 @@
 #include <stddef.h>
 #include <stdio.h>
 
+#include "glstats.h"
 #include "log.h"
 #include "nodegl.h"
 #include "nodes.h"
 #include "utils.h"
 
+enum {
+    DEPTH_MODE_NONE,
+    DEPTH_MODE_AUTO,
+    DEPTH_MODE_SHARED,
+};
+
+static const struct param_choices depth_mode_choices = {
+    .name = "depth_mode",
+    .consts = {
+        {"none",   DEPTH_MODE_NONE,   .desc=NGLI_DOCSTRING("no depth buffer")},
+        {"auto",   DEPTH_MODE_AUTO,   .desc=NGLI_DOCSTRING("depth buffer only if depth testing is enabled in `child` or by the ancestors")},
+        {"shared", DEPTH_MODE_SHARED, .desc=NGLI_DOCSTRING("depth buffer shared with the other render targets of the same dimensions")},
+        {NULL}
+    }
+};
+
 #define OFFSET(x) offsetof(struct rtt, x)
 static const struct node_param rtt_params[] = {
     {"child",         PARAM_TYPE_NODE, OFFSET(child),
@@ -42,9 +59,147 @@ static const struct node_param rtt_params[] = {
                       .desc=NGLI_DOCSTRING("destination depth texture")},
     {"samples",       PARAM_TYPE_INT, OFFSET(samples),
                       .desc=NGLI_DOCSTRING("number of samples used for multisampling anti-aliasing")},
+    {"depth_mode",    PARAM_TYPE_SELECT, OFFSET(depth_mode), {.i64=DEPTH_MODE_AUTO},
+                      .choices=&depth_mode_choices,
+                      .desc=NGLI_DOCSTRING("depth buffer allocation mode when no `depth_texture` is set")},
     {NULL}
 };
 
+static const struct glpool_key framebuffer_key = {.type = NGLI_GLPOOL_FRAMEBUFFER};
+
+static GLuint acquire_framebuffer(struct ngl_node *node)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    const struct glfunctions *gl = &ctx->glcontext->funcs;
+
+    int64_t size;
+    GLuint id = ngli_glpool_acquire(ctx, &framebuffer_key, &size);
+    if (!id)
+        ngli_glGenFramebuffers(gl, 1, &id);
+    return id;
+}
+
+/*
+ * Attach the transient renderbuffer of the current RenderToTexture nesting
+ * level, if it is not already attached
+ */
+static int update_transient(struct ngl_node *node, GLuint framebuffer_id, GLenum attachment,
+                            struct transient *transient, GLuint *idp)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    const struct glfunctions *gl = &ctx->glcontext->funcs;
+
+    const GLuint id = ngli_transient_get(ctx, transient, ctx->rtt_level);
+    if (!id)
+        return -1;
+
+    if (id != *idp) {
+        ngli_glBindFramebuffer(gl, GL_FRAMEBUFFER, framebuffer_id);
+        ngli_glFramebufferRenderbuffer(gl, GL_FRAMEBUFFER, attachment, GL_RENDERBUFFER, id);
+        *idp = id;
+    }
+    return 0;
+}
+
+/*
+ * Detach the transient renderbuffer of an attachment not needed by the
+ * current draw, so it does not get allocated
+ */
+static void detach_transient(struct ngl_node *node, GLuint framebuffer_id, GLenum attachment, GLuint *idp)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    const struct glfunctions *gl = &ctx->glcontext->funcs;
+
+    if (!*idp)
+        return;
+
+    ngli_glBindFramebuffer(gl, GL_FRAMEBUFFER, framebuffer_id);
+    ngli_glFramebufferRenderbuffer(gl, GL_FRAMEBUFFER, attachment, GL_RENDERBUFFER, 0);
+    *idp = 0;
+}
+
+/*
+ * The visited nodes are tracked so the nodes shared in the graph are only
+ * explored once; a visited node can only be reached again once it has been
+ * found without depth test, since the walk stops at the first one found.
+ */
+static int has_depth_test(struct hmap *visited, const struct ngl_node *node)
+{
+    char key[32];
+    (void)snprintf(key, sizeof(key), "%p", node);
+    if (ngli_hmap_get(visited, key))
+        return 0;
+    if (ngli_hmap_set(visited, key, (void *)node) < 0)
+        return -1;
+
+    if (node->class->id == NGL_NODE_GRAPHICCONFIG) {
+        const struct graphicconfig *graphicconfig = node->priv_data;
+        if (graphicconfig->depth_test == 1)
+            return 1;
+    }
+
+    const uint8_t *base_ptr = node->priv_data;
+    const struct node_param *par = node->class->params;
+
+    while (par && par->key) {
+        int ret = 0;
+        switch (par->type) {
+            case PARAM_TYPE_NODE: {
+                const struct ngl_node *child = *(struct ngl_node **)(base_ptr + par->offset);
+                if (child)
+                    ret = has_depth_test(visited, child);
+                break;
+            }
+            case PARAM_TYPE_NODELIST: {
+                struct ngl_node **elems = *(struct ngl_node ***)(base_ptr + par->offset);
+                const int nb_elems = *(int *)(base_ptr + par->offset + sizeof(struct ngl_node **));
+                for (int i = 0; i < nb_elems && !ret; i++)
+                    ret = has_depth_test(visited, elems[i]);
+                break;
+            }
+            case PARAM_TYPE_NODEDICT: {
+                struct hmap *hmap = *(struct hmap **)(base_ptr + par->offset);
+                if (!hmap)
+                    break;
+                const struct hmap_entry *entry = NULL;
+                while (!ret && (entry = ngli_hmap_next(hmap, entry)))
+                    ret = has_depth_test(visited, entry->data);
+                break;
+            }
+        }
+        if (ret)
+            return ret;
+        par++;
+    }
+
+    return 0;
+}
+
+static int child_has_depth_test(const struct ngl_node *node)
+{
+    struct hmap *visited = ngli_hmap_create();
+    if (!visited)
+        return -1;
+    const int ret = has_depth_test(visited, node);
+    ngli_hmap_freep(&visited);
+    return ret;
+}
+
+/*
+ * In auto mode, the depth test state set by the ancestors (such as a
+ * GraphicConfig above the RenderToTexture) is only known at draw time
+ */
+static int get_use_depth(const struct ngl_node *node)
+{
+    const struct rtt *s = node->priv_data;
+
+    if (!s->use_depth)
+        return 0;
+    if (s->depth_texture || s->depth_mode != DEPTH_MODE_AUTO)
+        return 1;
+    return s->child_depth_test || node->ctx->glstate->depth_test;
+}
+
 static int rtt_prefetch(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
@@ -57,6 +212,7 @@ static int rtt_prefetch(struct ngl_node *node)
 
     s->width = texture->width;
     s->height = texture->height;
+    texture->barrier_bits |= GL_FRAMEBUFFER_BARRIER_BIT;
 
     if (!(glcontext->features & NGLI_FEATURE_FRAMEBUFFER_OBJECT) &&
         s->samples > 0) {
@@ -65,34 +221,80 @@ static int rtt_prefetch(struct ngl_node *node)
     }
 
     if (s->depth_texture) {
+        if (s->depth_mode == DEPTH_MODE_NONE) {
+            LOG(ERROR, "depth texture can not be used with the none depth mode");
+            return -1;
+        }
         depth_texture = s->depth_texture->priv_data;
+        depth_texture->barrier_bits |= GL_FRAMEBUFFER_BARRIER_BIT;
         if (s->width != depth_texture->width || s->height != depth_texture->height) {
             LOG(ERROR, "color and depth texture dimensions do not match: %dx%d != %dx%d",
                 s->width, s->height, depth_texture->width, depth_texture->height);
             return -1;
         }
+        s->use_depth = 1;
+    } else if (s->depth_mode == DEPTH_MODE_AUTO) {
+        /*
+         * The depth renderbuffers are acquired but only attached (and thus
+         * allocated) by the draws needing them, see get_use_depth()
+         */
+        s->child_depth_test = child_has_depth_test(s->child);
+        if (s->child_depth_test < 0)
+            return -1;
+        s->use_depth = 1;
+    } else {
+        s->use_depth = s->depth_mode == DEPTH_MODE_SHARED;
+    }
+
+    GLenum depth_format = GL_NONE;
+    int64_t depth_pixel_size = 0;
+    if (depth_texture) {
+        depth_format = depth_texture->internal_format;
+        depth_pixel_size = ngli_glstats_get_pixels_size(depth_texture->format, depth_texture->type, 1, 1, 1);
+    } else if (s->use_depth) {
+        depth_format = GL_DEPTH_COMPONENT16;
+        depth_pixel_size = 2;
+    }
+
+    if (s->samples > 0 && (glcontext->features & NGLI_FEATURE_INTERNALFORMAT_QUERY)) {
+        GLint samples;
+        ngli_glGetInternalformativ(gl, GL_RENDERBUFFER, texture->internal_format, GL_SAMPLES, 1, &samples);
+        if (s->use_depth) {
+            GLint dbuffer_samples;
+            ngli_glGetInternalformativ(gl, GL_RENDERBUFFER, depth_format, GL_SAMPLES, 1, &dbuffer_samples);
+            samples = NGLI_MIN(samples, dbuffer_samples);
+        }
+        if (s->samples > samples) {
+            LOG(WARNING,
+                "requested samples (%d) exceed renderbuffer's maximum supported value (%d)",
+                s->samples,
+                samples);
+            s->samples = samples;
+        }
     }
 
     GLuint framebuffer_id = 0;
     ngli_glGetIntegerv(gl, GL_FRAMEBUFFER_BINDING, (GLint *)&framebuffer_id);
 
-    ngli_glGenFramebuffers(gl, 1, &s->framebuffer_id);
+    s->framebuffer_id = acquire_framebuffer(node);
     ngli_glBindFramebuffer(gl, GL_FRAMEBUFFER, s->framebuffer_id);
 
     LOG(VERBOSE, "init rtt with texture %d", texture->id);
     ngli_glFramebufferTexture2D(gl, GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture->id, 0);
 
-    GLenum depth_format;
     if (depth_texture) {
-        depth_format = depth_texture->internal_format;
         ngli_glFramebufferTexture2D(gl, GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depth_texture->id, 0);
-    } else {
-        depth_format = GL_DEPTH_COMPONENT16;
-        ngli_glGenRenderbuffers(gl, 1, &s->renderbuffer_id);
-        ngli_glBindRenderbuffer(gl, GL_RENDERBUFFER, s->renderbuffer_id);
-        ngli_glRenderbufferStorage(gl, GL_RENDERBUFFER, depth_format, s->width, s->height);
-        ngli_glBindRenderbuffer(gl, GL_RENDERBUFFER, 0);
-        ngli_glFramebufferRenderbuffer(gl, GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, s->renderbuffer_id);
+    } else if (s->use_depth && !s->samples) {
+        /* With multisampling, the draws only use the multisampled depth buffer */
+        s->depthbuffer = ngli_transient_acquire(ctx, depth_format, s->width, s->height, 0, depth_pixel_size);
+        if (!s->depthbuffer)
+            return -1;
+        if (s->depth_mode != DEPTH_MODE_AUTO) {
+            int ret = update_transient(node, s->framebuffer_id, GL_DEPTH_ATTACHMENT,
+                                       s->depthbuffer, &s->renderbuffer_id);
+            if (ret < 0)
+                return ret;
+        }
     }
 
     if (ngli_glCheckFramebufferStatus(gl, GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
@@ -101,37 +303,32 @@ static int rtt_prefetch(struct ngl_node *node)
     }
 
     if (s->samples > 0) {
-        if (glcontext->features & NGLI_FEATURE_INTERNALFORMAT_QUERY) {
-            GLint cbuffer_samples;
-            ngli_glGetInternalformativ(gl, GL_RENDERBUFFER, texture->internal_format, GL_SAMPLES, 1, &cbuffer_samples);
-            GLint dbuffer_samples;
-            ngli_glGetInternalformativ(gl, GL_RENDERBUFFER, depth_format, GL_SAMPLES, 1, &dbuffer_samples);
+        s->framebuffer_ms_id = acquire_framebuffer(node);
+        ngli_glBindFramebuffer(gl, GL_FRAMEBUFFER, s->framebuffer_ms_id);
 
-            GLint samples = NGLI_MIN(cbuffer_samples, dbuffer_samples);
-            if (s->samples > samples) {
-                LOG(WARNING,
-                    "requested samples (%d) exceed renderbuffer's maximum supported value (%d)",
-                    s->samples,
-                    samples);
-                s->samples = samples;
+        const int64_t color_pixel_size = ngli_glstats_get_pixels_size(texture->format, texture->type, 1, 1, 1);
+        s->colorbuffer_ms = ngli_transient_acquire(ctx, texture->internal_format, s->width, s->height,
+                                                   s->samples, color_pixel_size);
+        if (!s->colorbuffer_ms)
+            return -1;
+        int ret = update_transient(node, s->framebuffer_ms_id, GL_COLOR_ATTACHMENT0,
+                                   s->colorbuffer_ms, &s->colorbuffer_ms_id);
+        if (ret < 0)
+            return ret;
+
+        if (s->use_depth) {
+            s->depthbuffer_ms = ngli_transient_acquire(ctx, depth_format, s->width, s->height,
+                                                       s->samples, depth_pixel_size);
+            if (!s->depthbuffer_ms)
+                return -1;
+            if (s->depth_mode != DEPTH_MODE_AUTO || s->depth_texture) {
+                ret = update_transient(node, s->framebuffer_ms_id, GL_DEPTH_ATTACHMENT,
+                                       s->depthbuffer_ms, &s->depthbuffer_ms_id);
+                if (ret < 0)
+                    return ret;
             }
         }
 
-        ngli_glGenFramebuffers(gl, 1, &s->framebuffer_ms_id);
-        ngli_glBindFramebuffer(gl, GL_FRAMEBUFFER, s->framebuffer_ms_id);
-
-        ngli_glGenRenderbuffers(gl, 1, &s->colorbuffer_ms_id);
-        ngli_glBindRenderbuffer(gl, GL_RENDERBUFFER, s->colorbuffer_ms_id);
-        ngli_glRenderbufferStorageMultisample(gl, GL_RENDERBUFFER, s->samples, texture->internal_format, s->width, s->height);
-        ngli_glBindRenderbuffer(gl, GL_RENDERBUFFER, 0);
-        ngli_glFramebufferRenderbuffer(gl, GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, s->colorbuffer_ms_id);
-
-        ngli_glGenRenderbuffers(gl, 1, &s->depthbuffer_ms_id);
-        ngli_glBindRenderbuffer(gl, GL_RENDERBUFFER, s->depthbuffer_ms_id);
-        ngli_glRenderbufferStorageMultisample(gl, GL_RENDERBUFFER, s->samples, depth_format, s->width, s->height);
-        ngli_glBindRenderbuffer(gl, GL_RENDERBUFFER, 0);
-        ngli_glFramebufferRenderbuffer(gl, GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, s->depthbuffer_ms_id);
-
         if (ngli_glCheckFramebufferStatus(gl, GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
             LOG(ERROR, "multisampled framebuffer %u is not complete", s->framebuffer_id);
             return -1;
@@ -174,6 +371,32 @@ static void rtt_draw(struct ngl_node *node)
     GLuint framebuffer_id = 0;
     ngli_glGetIntegerv(gl, GL_FRAMEBUFFER_BINDING, (GLint *)&framebuffer_id);
 
+    const int use_depth = get_use_depth(node);
+
+    int ret = 0;
+    if (s->depthbuffer) {
+        if (use_depth)
+            ret |= update_transient(node, s->framebuffer_id, GL_DEPTH_ATTACHMENT,
+                                    s->depthbuffer, &s->renderbuffer_id);
+        else
+            detach_transient(node, s->framebuffer_id, GL_DEPTH_ATTACHMENT, &s->renderbuffer_id);
+    }
+    if (s->colorbuffer_ms)
+        ret |= update_transient(node, s->framebuffer_ms_id, GL_COLOR_ATTACHMENT0,
+                                s->colorbuffer_ms, &s->colorbuffer_ms_id);
+    if (s->depthbuffer_ms) {
+        if (use_depth)
+            ret |= update_transient(node, s->framebuffer_ms_id, GL_DEPTH_ATTACHMENT,
+                                    s->depthbuffer_ms, &s->depthbuffer_ms_id);
+        else
+            detach_transient(node, s->framebuffer_ms_id, GL_DEPTH_ATTACHMENT, &s->depthbuffer_ms_id);
+    }
+    if (ret < 0) {
+        LOG(ERROR, "unable to allocate the transient renderbuffers");
+        ngli_glBindFramebuffer(gl, GL_FRAMEBUFFER, framebuffer_id);
+        return;
+    }
+
     if (s->samples > 0)
         ngli_glBindFramebuffer(gl, GL_FRAMEBUFFER, s->framebuffer_ms_id);
     else
@@ -181,9 +404,14 @@ static void rtt_draw(struct ngl_node *node)
 
     ngli_glGetIntegerv(gl, GL_VIEWPORT, viewport);
     ngli_glViewport(gl, 0, 0, s->width, s->height);
-    ngli_glClear(gl, GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    ngli_memorybarrier_flush(ctx);
+    ngli_glClear(gl, GL_COLOR_BUFFER_BIT | (use_depth ? GL_DEPTH_BUFFER_BIT : 0));
 
+    /* The transient renderbuffers of this level are in use until the end of
+     * the draw, the nested RenderToTexture nodes need their own */
+    ctx->rtt_level++;
     ngli_node_draw(s->child);
+    ctx->rtt_level--;
 
     if (ngli_glCheckFramebufferStatus(gl, GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
         LOG(ERROR, "framebuffer %u is not complete", s->framebuffer_id);
@@ -193,28 +421,35 @@ static void rtt_draw(struct ngl_node *node)
     if (s->samples > 0) {
         ngli_glBindFramebuffer(gl, GL_READ_FRAMEBUFFER, s->framebuffer_ms_id);
         ngli_glBindFramebuffer(gl, GL_DRAW_FRAMEBUFFER, s->framebuffer_id);
-        ngli_glBlitFramebuffer(gl, 0, 0, s->width, s->height, 0, 0, s->width, s->height, GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+        const GLbitfield mask = GL_COLOR_BUFFER_BIT | (s->depth_texture ? GL_DEPTH_BUFFER_BIT : 0);
+        ngli_glBlitFramebuffer(gl, 0, 0, s->width, s->height, 0, 0, s->width, s->height, mask, GL_NEAREST);
+    }
+
+    /* The content of the transient renderbuffers does not need to outlive
+     * the draw: let the driver know so it can skip storing it back */
+    if (glcontext->features & NGLI_FEATURE_INVALIDATE_SUBDATA) {
+        if (s->samples > 0) {
+            static const GLenum attachments[] = {GL_COLOR_ATTACHMENT0, GL_DEPTH_ATTACHMENT};
+            ngli_glInvalidateFramebuffer(gl, GL_READ_FRAMEBUFFER, use_depth ? 2 : 1, attachments);
+        } else if (s->depthbuffer && use_depth) {
+            static const GLenum attachments[] = {GL_DEPTH_ATTACHMENT};
+            ngli_glInvalidateFramebuffer(gl, GL_FRAMEBUFFER, 1, attachments);
+        }
     }
 
     ngli_glBindFramebuffer(gl, GL_FRAMEBUFFER, framebuffer_id);
     ngli_glViewport(gl, viewport[0], viewport[1], viewport[2], viewport[3]);
 
+    /* The mipmap levels are rebuilt by the next user of the textures */
     struct texture *texture = s->color_texture->priv_data;
-    switch(texture->min_filter) {
-    case GL_NEAREST_MIPMAP_NEAREST:
-    case GL_NEAREST_MIPMAP_LINEAR:
-    case GL_LINEAR_MIPMAP_NEAREST:
-    case GL_LINEAR_MIPMAP_LINEAR:
-        ngli_glBindTexture(gl, GL_TEXTURE_2D, texture->id);
-        ngli_glGenerateMipmap(gl, GL_TEXTURE_2D);
-        break;
-    }
+    texture->generation++;
 
     texture->coordinates_matrix[5] = -1.0f;
     texture->coordinates_matrix[13] = 1.0f;
 
     if (s->depth_texture) {
         struct texture *depth_texture = s->depth_texture->priv_data;
+        depth_texture->generation++;
         depth_texture->coordinates_matrix[5] = -1.0f;
         depth_texture->coordinates_matrix[13] = 1.0f;
     }
@@ -234,17 +469,19 @@ static void rtt_release(struct ngl_node *node)
     ngli_glFramebufferTexture2D(gl, GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0);
     ngli_glFramebufferRenderbuffer(gl, GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, 0);
 
-    ngli_glDeleteRenderbuffers(gl, 1, &s->renderbuffer_id);
-    ngli_glDeleteFramebuffers(gl, 1, &s->framebuffer_id);
+    ngli_transient_release(ctx, &s->depthbuffer);
+    ngli_glpool_release(ctx, &framebuffer_key, s->framebuffer_id, 0);
+    s->renderbuffer_id = s->framebuffer_id = 0;
 
     if (s->samples > 0) {
         ngli_glBindFramebuffer(gl, GL_FRAMEBUFFER, s->framebuffer_ms_id);
         ngli_glFramebufferRenderbuffer(gl, GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, 0);
         ngli_glFramebufferRenderbuffer(gl, GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, 0);
 
-        ngli_glDeleteFramebuffers(gl, 1, &s->framebuffer_ms_id);
-        ngli_glDeleteRenderbuffers(gl, 1, &s->colorbuffer_ms_id);
-        ngli_glDeleteRenderbuffers(gl, 1, &s->depthbuffer_ms_id);
+        ngli_glpool_release(ctx, &framebuffer_key, s->framebuffer_ms_id, 0);
+        ngli_transient_release(ctx, &s->colorbuffer_ms);
+        ngli_transient_release(ctx, &s->depthbuffer_ms);
+        s->framebuffer_ms_id = s->colorbuffer_ms_id = s->depthbuffer_ms_id = 0;
     }
 
     ngli_glBindFramebuffer(gl, GL_FRAMEBUFFER, framebuffer_id);
@@ -25,6 +25,8 @@
 #include <sxplayer.h>
 
 #include "glincludes.h"
+#include "glpool.h"
+#include "glstats.h"
 #include "hwupload.h"
 #include "log.h"
 #include "math_utils.h"
@@ -363,6 +365,54 @@ static void tex_set_params(const struct glfunctions *gl, const struct texture *s
         ngli_glTexParameteri(gl, s->local_target, GL_TEXTURE_WRAP_R, s->wrap_r);
 }
 
+static int has_mipmap(const struct texture *s)
+{
+    switch (s->min_filter) {
+    case GL_NEAREST_MIPMAP_NEAREST:
+    case GL_NEAREST_MIPMAP_LINEAR:
+    case GL_LINEAR_MIPMAP_NEAREST:
+    case GL_LINEAR_MIPMAP_LINEAR:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+static int64_t get_gpu_size(const struct texture *s)
+{
+    const int depth = s->local_target == GL_TEXTURE_3D ? s->depth : 1;
+    int64_t size = ngli_glstats_get_pixels_size(s->format, s->type, s->width, s->height, depth);
+
+    if (has_mipmap(s))
+        size += size / 3;
+
+    return size;
+}
+
+static void set_local_key(struct texture *s)
+{
+    s->local_key = (struct glpool_key){
+        .type            = NGLI_GLPOOL_TEXTURE,
+        .target          = s->local_target,
+        .internal_format = s->internal_format,
+        .data_type       = s->type,
+        .width           = s->width,
+        .height          = s->height,
+        .depth           = s->depth,
+        .immutable       = s->immutable,
+    };
+}
+
+/* Hand the local texture over to the pool so it can be recycled */
+static void release_local_texture(struct ngl_node *node)
+{
+    struct texture *s = node->priv_data;
+
+    ngli_glpool_release(node->ctx, &s->local_key, s->local_id, s->gpu_size);
+    s->local_id = 0;
+    s->gpu_size = 0;
+}
+
 int ngli_texture_update_local_texture(struct ngl_node *node,
                                       int width, int height, int depth,
                                       const uint8_t *data)
@@ -377,72 +427,95 @@ int ngli_texture_update_local_texture(struct ngl_node *node,
     if (!width || !height || (node->class->id == NGL_NODE_TEXTURE3D && !depth))
         return ret;
 
-    int update_dimensions = !s->local_id || s->width != width || s->height != height || s->depth != depth;
+    const int update_dimensions = s->width != width || s->height != height || s->depth != depth;
+
+    /* The storage of an immutable texture can not be redefined */
+    if (s->local_id && s->immutable && update_dimensions)
+        release_local_texture(node);
 
     s->width = width;
     s->height = height;
     s->depth = depth;
 
-    if (s->immutable) {
-        if (update_dimensions) {
-            ret = 1;
+    if (!s->local_id) {
+        ret = 1;
 
-            if (s->local_id) {
-                ngli_glDeleteTextures(gl, 1, &s->local_id);
-            }
+        s->internal_format = ngli_texture_get_sized_internal_format(glcontext,
+                                                                    s->format,
+                                                                    s->type);
+        set_local_key(s);
 
-            ngli_glGenTextures(gl, 1, &s->local_id);
+        s->local_id = ngli_glpool_acquire(ctx, &s->local_key, &s->gpu_size);
+        if (s->local_id) {
+            /* The storage of a recycled texture already matches */
             ngli_glBindTexture(gl, s->local_target, s->local_id);
             tex_set_params(gl, s);
-
-            s->internal_format = ngli_texture_get_sized_internal_format(glcontext,
-                                                                        s->format,
-                                                                        s->type);
-            tex_storage(gl, s);
+            if (data)
+                tex_sub_image(gl, s, data);
         } else {
-            ngli_glBindTexture(gl, s->local_target, s->local_id);
-        }
-
-        if (data) {
-            tex_sub_image(gl, s, data);
-        }
-    } else {
-        if (!s->local_id) {
-            ret = 1;
-
             ngli_glGenTextures(gl, 1, &s->local_id);
             ngli_glBindTexture(gl, s->local_target, s->local_id);
             tex_set_params(gl, s);
-        } else {
-            ngli_glBindTexture(gl, s->local_target, s->local_id);
-        }
 
-        if (update_dimensions) {
-            s->internal_format = ngli_texture_get_sized_internal_format(glcontext,
-                                                                        s->format,
-                                                                        s->type);
-            tex_image(gl, s, data);
-        } else if (data) {
-            tex_sub_image(gl, s, data);
-        }
-    }
+            if (s->immutable) {
+                tex_storage(gl, s);
+                if (data)
+                    tex_sub_image(gl, s, data);
+            } else {
+                tex_image(gl, s, data);
+            }
 
-    switch (s->min_filter) {
-    case GL_NEAREST_MIPMAP_NEAREST:
-    case GL_NEAREST_MIPMAP_LINEAR:
-    case GL_LINEAR_MIPMAP_NEAREST:
-    case GL_LINEAR_MIPMAP_LINEAR:
-        ngli_glGenerateMipmap(gl, s->local_target);
-        break;
+            s->gpu_size = get_gpu_size(s);
+            ngli_gpumem_alloc(&ctx->gpumem, NGLI_GPUMEM_TEXTURE, s->gpu_size);
+        }
+    } else if (update_dimensions) {
+        ngli_glBindTexture(gl, s->local_target, s->local_id);
+
+        s->internal_format = ngli_texture_get_sized_internal_format(glcontext,
+                                                                    s->format,
+                                                                    s->type);
+        set_local_key(s);
+        tex_image(gl, s, data);
+
+        ngli_gpumem_free(&ctx->gpumem, NGLI_GPUMEM_TEXTURE, s->gpu_size);
+        s->gpu_size = get_gpu_size(s);
+        ngli_gpumem_alloc(&ctx->gpumem, NGLI_GPUMEM_TEXTURE, s->gpu_size);
+    } else {
+        ngli_glBindTexture(gl, s->local_target, s->local_id);
+        if (data)
+            tex_sub_image(gl, s, data);
     }
 
     ngli_glBindTexture(gl, s->local_target, 0);
 
     s->id = s->local_id;
+    s->generation++;
 
     return ret;
 }
 
+/*
+ * Rebuild the mipmap levels of the local texture if its content changed
+ * since they were last built. The texture is left bound to the active
+ * texture unit.
+ */
+void ngli_texture_update_mipmap(struct ngl_node *node)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    const struct glfunctions *gl = &ctx->glcontext->funcs;
+    struct texture *s = node->priv_data;
+
+    if (!s->local_id || s->id != s->local_id || !has_mipmap(s))
+        return;
+
+    if (s->mipmap_generation == s->generation)
+        return;
+
+    ngli_glBindTexture(gl, s->local_target, s->local_id);
+    ngli_glGenerateMipmap(gl, s->local_target);
+    s->mipmap_generation = s->generation;
+}
+
 static int texture_prefetch(struct ngl_node *node, GLenum local_target)
 {
     struct ngl_ctx *ctx = node->ctx;
@@ -474,6 +547,8 @@ static int texture_prefetch(struct ngl_node *node, GLenum local_target)
         if (ret < 0)
             return ret;
 
+        s->barrier_bits |= GL_TEXTURE_UPDATE_BARRIER_BIT;
+
         switch (s->data_src->class->id) {
         case NGL_NODE_FPS:
             s->format = glcontext->gl_1comp;
@@ -536,7 +611,7 @@ static int texture_prefetch(struct ngl_node *node, GLenum local_target)
                 }
             }
 
-            data = buffer->data;
+            data = buffer->data_ptr;
             s->type = buffer->data_comp_type;
             switch (buffer->data_comp) {
             case 1: s->internal_format = s->format = GL_RED;  break;
@@ -597,7 +672,7 @@ static void handle_buffer_frame(struct ngl_node *node)
 {
     struct texture *s = node->priv_data;
     struct buffer *buffer = s->data_src->priv_data;
-    const uint8_t *data = buffer->data;
+    const uint8_t *data = buffer->data_ptr;
 
     ngli_texture_update_local_texture(node, s->width, s->height, s->depth, data);
 }
@@ -636,16 +711,13 @@ static int texture_update(struct ngl_node *node, double t)
 
 static void texture_release(struct ngl_node *node)
 {
-    struct ngl_ctx *ctx = node->ctx;
-    struct glcontext *glcontext = ctx->glcontext;
-    const struct glfunctions *gl = &glcontext->funcs;
-
     struct texture *s = node->priv_data;
 
     ngli_hwupload_uninit(node);
 
-    ngli_glDeleteTextures(gl, 1, &s->local_id);
-    s->id = s->local_id = 0;
+    if (s->local_id)
+        release_local_texture(node);
+    s->id = 0;
 }
 
 static int texture3d_init(struct ngl_node *node)
@@ -36,6 +36,8 @@ struct timerangefilter {
     double max_idle_time;
 
     int drawme;
+    struct gpumem_residency residency;
+    int preload_range;  // index of the range the child is preloaded for (0 for none)
 };
 
 #define RANGES_TYPES_LIST (const int[]){NGL_NODE_TIMERANGEMODEONCE,     \
@@ -141,6 +143,10 @@ static int timerangefilter_visit(struct ngl_node *node, int is_active, double t)
      * parent is dead, the children are likely dead as well. However, a living
      * children from a dead parent can be revealed by another living branch.
      */
+    struct ngl_ctx *ctx = node->ctx;
+    int ahead = 0;
+    int preload_range = 0;
+
     if (is_active) {
         const int rr_id = update_rr_state(s, t);
 
@@ -157,14 +163,33 @@ static int timerangefilter_visit(struct ngl_node *node, int is_active, double t)
                     // as the current one doesn't.
                     const struct timerangemode *next = s->ranges[rr_id + 1]->priv_data;
                     const double next_use_in = next->start_time - t;
+                    struct gpumem *gpumem = &ctx->gpumem;
 
                     if (next_use_in < s->prefetch_time) {
                         LOG(VERBOSE, "next use of %s in %g (< %g), mark as active",
                             child->name, next_use_in, s->prefetch_time);
 
                         // The node will actually be needed soon, so we need to
-                        // start it if necessary.
-                        is_active = 1;
+                        // start it if necessary, unless it was evicted or the
+                        // GPU memory budget is exceeded, in which case it will
+                        // only be started when actually used. The branches
+                        // are started one per frame to spread their GL
+                        // initialization, and once started, the CPU side of
+                        // their warm-up is preloaded in the background for
+                        // the start of the next range. A branch partially
+                        // started, its remaining prefetches deferred by the
+                        // frame budget, is kept being started.
+                        if (child->state == STATE_READY) {
+                            is_active = ngli_gpumem_keep(gpumem, &s->residency);
+                            if (is_active)
+                                preload_range = rr_id + 1;
+                        } else if (child->prefetch_deferred) {
+                            is_active = 1;
+                        } else if (!ngli_gpumem_over_budget(gpumem) && !ctx->nb_started_ahead) {
+                            ngli_gpumem_use(gpumem, &s->residency);
+                            ctx->nb_started_ahead++;
+                            is_active = 1;
+                        }
                     } else if (next_use_in < s->max_idle_time && child->state == STATE_READY) {
                         LOG(VERBOSE, "%s not currently needed by will be soon %g (< %g), keep as active",
                             child->name, next_use_in, s->max_idle_time);
@@ -173,15 +198,28 @@ static int timerangefilter_visit(struct ngl_node *node, int is_active, double t)
                         // a bit longer than a prefetch period so we don't need
                         // to start it, but in the case where it's actually
                         // already active it's not worth releasing it to start
-                        // it again soon after, so we keep it active.
-                        is_active = 1;
+                        // it again soon after, so we keep it active (unless
+                        // evicted to honor the GPU memory budget).
+                        is_active = ngli_gpumem_keep(gpumem, &s->residency);
                     }
+                    ahead = is_active;
                 }
             }
         }
     }
 
-    return ngli_node_visit(child, is_active, t);
+    if (preload_range && preload_range != s->preload_range) {
+        const struct timerangemode *next = s->ranges[preload_range]->priv_data;
+        int ret = ngli_preload_schedule(ctx, child, next->start_time);
+        if (ret < 0)
+            return ret;
+    }
+    s->preload_range = preload_range;
+
+    ctx->visit_ahead += ahead;
+    int ret = ngli_node_visit(child, is_active, t);
+    ctx->visit_ahead -= ahead;
+    return ret;
 }
 
 static int timerangefilter_update(struct ngl_node *node, double t)
@@ -207,6 +245,7 @@ static int timerangefilter_update(struct ngl_node *node, double t)
     }
 
     s->drawme = 1;
+    ngli_gpumem_use(&node->ctx->gpumem, &s->residency);
 
     struct ngl_node *child = s->child;
     memcpy(child->modelview_matrix, node->modelview_matrix, sizeof(node->modelview_matrix));
@@ -75,6 +75,11 @@ void ngl_log_set_callback(void *arg, ngl_log_callback_type callback);
  * No message with its level inferior to the specified level will be logged
  * (with or without the callback set).
  *
+ * The messages below the LOG_LEVEL build option are removed at compile time
+ * and can not be enabled with this function. LOG_LEVEL defaults to info, so
+ * NGL_LOG_DEBUG and NGL_LOG_VERBOSE only have an effect on builds made with
+ * DEBUG=yes or with LOG_LEVEL=debug or LOG_LEVEL=verbose.
+ *
  * @param level log level (any of NGL_LOG_*)
  */
 void ngl_log_set_min_level(int level);
@@ -208,6 +213,26 @@ struct ngl_node *ngl_node_ref(struct ngl_node *node);
  */
 void ngl_node_unrefp(struct ngl_node **nodep);
 
+/**
+ * Create a copy of a graph, typically to render the same scene with several
+ * node.gl contexts.
+ *
+ * A node can only be associated with one node.gl context at a time, since it
+ * holds the GPU resources of this context. The clone is a new graph with the
+ * same parameters and the same topology (nodes shared between several
+ * parents are shared in the clone as well), which can be associated with
+ * another context, possibly in another thread. The data buffers (Buffer and
+ * AnimKeyFrameBuffer data) are not duplicated but shared between the graph
+ * and its clones.
+ *
+ * The source graph must not be modified during the call.
+ *
+ * @param node  pointer to the root node of the graph to copy
+ *
+ * @return a new node of reference counter 1 on success, NULL on error
+ */
+struct ngl_node *ngl_node_clone(const struct ngl_node *node);
+
 /**
  * Add entries to a list-based parameter of an allocated node.
  *
@@ -238,6 +263,27 @@ int ngl_node_param_add(struct ngl_node *node, const char *key,
  */
 int ngl_node_param_set(struct ngl_node *node, const char *key, ...);
 
+/**
+ * Set a data parameter of an allocated node without copying the data.
+ *
+ * Contrary to ngl_node_param_set(), the data is borrowed: it must remain valid
+ * and unchanged until release() is called with opaque, which happens once no
+ * node uses it anymore (including the clones of the node, see
+ * ngl_node_clone()). release() may be called from any thread, and is also
+ * called if the function fails.
+ *
+ * @param node      pointer to the target node
+ * @param key       string identifying the data parameter
+ * @param size      size of the data in bytes
+ * @param data      pointer to the data
+ * @param release   callback releasing the data
+ * @param opaque    user pointer passed to release()
+ *
+ * @return 0 on success, < 0 on error
+ */
+int ngl_node_param_set_data(struct ngl_node *node, const char *key, int size, void *data,
+                            void (*release)(void *opaque), void *opaque);
+
 /**
  * Serialize in Graphviz format (.dot) a node graph.
  *
@@ -269,6 +315,44 @@ char *ngl_node_serialize(const struct ngl_node *node);
  */
 struct ngl_node *ngl_node_deserialize(const char *s);
 
+/**
+ * Callback reading the next chunk of a serialized scene.
+ *
+ * @param opaque  user pointer passed to ngl_node_deserialize_cb()
+ * @param buf     destination buffer
+ * @param size    maximum number of bytes to read
+ *
+ * @return the number of bytes read, 0 at the end of the stream, or a negative
+ *         value on error
+ */
+typedef int (*ngl_read_func)(void *opaque, char *buf, int size);
+
+/**
+ * De-serialize a scene read in chunks through a callback.
+ *
+ * The scene is parsed while it is read, and only the line being parsed is
+ * held in memory, which makes it suitable for large scenes.
+ *
+ * Must be destroyed using ngl_node_unrefp().
+ *
+ * @param read_func  callback reading the serialized scene
+ * @param opaque     user pointer passed to read_func
+ *
+ * @return a pointer to the de-serialized node graph or NULL on error
+ */
+struct ngl_node *ngl_node_deserialize_cb(ngl_read_func read_func, void *opaque);
+
+/**
+ * De-serialize a scene read from a file descriptor until the end of file.
+ *
+ * Must be destroyed using ngl_node_unrefp().
+ *
+ * @see ngl_node_deserialize_cb()
+ *
+ * @return a pointer to the de-serialized node graph or NULL on error
+ */
+struct ngl_node *ngl_node_deserialize_fd(int fd);
+
 /**
  * OpenGL platforms identifiers
  */
@@ -347,12 +431,87 @@ int ngl_set_glcontext(struct ngl_ctx *s, void *display, void *window, void *hand
  * it and its reference counter decremented.
  *
  * @param s      pointer to the configured node.gl context
- * @param scene  pointer to the scene
+ * @param scene  pointer to the scene, NULL to only detach the current one
  *
  * @return 0 on success, < 0 on error
  */
 int ngl_set_scene(struct ngl_ctx *s, struct ngl_node *scene);
 
+/**
+ * Replace the scene associated with the node.gl context while preserving the
+ * resources of the nodes which did not change.
+ *
+ * The nodes of the new scene are matched with the nodes of the current scene
+ * according to their parameters and children: every sub-graph identical to a
+ * sub-graph of the current scene is replaced by the current one, which remains
+ * initialized (programs, textures, medias, ...). The remaining nodes of the
+ * new scene are attached to the context, and the nodes of the current scene
+ * which are not part of the new scene anymore are detached from it.
+ *
+ * This is meant to be used for live edition, where only a small part of the
+ * scene changes between two calls. Note that the node parameters of the
+ * specified scene may be modified to point to the preserved nodes.
+ *
+ * If no scene was previously associated with the context, this function
+ * behaves like ngl_set_scene().
+ *
+ * @param s      pointer to the configured node.gl context
+ * @param scene  pointer to the new scene
+ *
+ * @return 0 on success, < 0 on error
+ */
+int ngl_patch_scene(struct ngl_ctx *s, struct ngl_node *scene);
+
+/**
+ * Queue a parameter change of a node of the scene, to be applied at the
+ * beginning of the next ngl_draw().
+ *
+ * Contrary to ngl_node_param_set(), this function can be called from any
+ * thread, concurrently with ngl_draw(). All the updates queued before a
+ * frame are applied together before the scene is visited, in the order they
+ * were queued. Setting the same parameter several times before the next
+ * frame only keeps the last value.
+ *
+ * The node must be part of the scene associated with the context (pending
+ * updates are applied before the scene is changed with ngl_set_scene() or
+ * ngl_patch_scene()). The updates of a node removed from the scene before
+ * they are applied are dropped, so the node only needs to stay referenced by
+ * the caller during this call. Only parameters holding values are supported,
+ * a node parameter can not be changed this way (see ngl_patch_scene()).
+ *
+ * The parameter and its value are checked by this function. An update which
+ * still fails when it is applied is logged, and does not prevent the other
+ * updates from being applied nor the frame from being drawn.
+ *
+ * @param s      pointer to the configured node.gl context
+ * @param node   pointer to the target node
+ * @param key    string identifying the parameter
+ * @param ...    the value in parameter type, copied by the function
+ *
+ * @return 0 on success, < 0 on error
+ */
+int ngl_queue_param_set(struct ngl_ctx *s, struct ngl_node *node, const char *key, ...);
+
+/**
+ * Queue the addition of entries to a list-based parameter of a node of the
+ * scene, to be applied at the beginning of the next ngl_draw().
+ *
+ * This is the thread-safe counterpart of ngl_node_param_add(), with the same
+ * rules as ngl_queue_param_set(), except that additions are never coalesced.
+ * The added nodes are attached to the context when the update is applied,
+ * and must not be used by the caller in the meantime.
+ *
+ * @param s         pointer to the configured node.gl context
+ * @param node      pointer to the target node
+ * @param key       string identifying the parameter
+ * @param nb_elems  number of elements to append
+ * @param elems     pointer to an array of values in parameter type
+ *
+ * @return 0 on success, < 0 on error
+ */
+int ngl_queue_param_add(struct ngl_ctx *s, struct ngl_node *node, const char *key,
+                        int nb_elems, void *elems);
+
 /**
  * Draw at the specified time.
  *
@@ -363,6 +522,66 @@ int ngl_set_scene(struct ngl_ctx *s, struct ngl_node *scene);
  */
 int ngl_draw(struct ngl_ctx *s, double t);
 
+/**
+ * Read back the pixels of the frame drawn by the last ngl_draw().
+ *
+ * The pixels are read from the framebuffer currently bound in the OpenGL
+ * context, in RGBA with 8 bits per component, the rows being written from the
+ * bottom to the top of the area.
+ *
+ * @param s       pointer to the configured node.gl context
+ * @param x       horizontal position of the left of the area
+ * @param y       vertical position of the bottom of the area
+ * @param width   width of the area
+ * @param height  height of the area
+ * @param dst     destination buffer of at least width * height * 4 bytes
+ *
+ * @return 0 on success, < 0 on error
+ */
+int ngl_read_pixels(struct ngl_ctx *s, int x, int y, int width, int height, void *dst);
+
+/**
+ * Set the number of threads used to evaluate the animations of the scene.
+ *
+ * The CPU-only part of the update of the nodes (such as the interpolation of
+ * the animations and the animated buffers) is spread across a pool of
+ * threads when the frame has enough of them to evaluate, before the update
+ * and draw which remain in the calling thread.
+ *
+ * @param s           pointer to a node.gl context
+ * @param nb_threads  number of threads including the calling one, 1 to
+ *                    disable the threading, 0 to use as many threads as
+ *                    available CPUs (default)
+ *
+ * @return 0 on success, < 0 on error
+ */
+int ngl_set_update_threads(struct ngl_ctx *s, int nb_threads);
+
+/**
+ * Announce the times of the upcoming draws, typically for an offline
+ * rendering where all the times are known in advance.
+ *
+ * When ngl_draw() is called with the next announced time, the animations
+ * and media frames of the scene are evaluated for the following announced
+ * time in a separate thread, while the current frame is drawn and until the
+ * next call to ngl_draw(). This overlaps the CPU work and the media decoding
+ * of a frame with the GPU submission and read back of the previous one.
+ *
+ * Drawing any other time drops the announced times. The nodes of the scene
+ * must not be modified with ngl_node_param_set() or ngl_node_param_add()
+ * between two ngl_draw() while times are announced. ngl_queue_param_set()
+ * remains safe: the nodes evaluated ahead are evaluated again when queued
+ * updates are applied, at the cost of the overlap for this frame.
+ *
+ * @param s         pointer to a node.gl context
+ * @param times     array of upcoming draw times in drawing order, copied by
+ *                  the function
+ * @param nb_times  number of entries in times, 0 to drop the announced times
+ *
+ * @return 0 on success, < 0 on error
+ */
+int ngl_set_draw_times(struct ngl_ctx *s, const double *times, int nb_times);
+
 /**
  * Serialize the current scene in Graphviz format (.dot) a node graph at the
  * specified time. Non active nodes will be grayed.
@@ -375,6 +594,251 @@ int ngl_draw(struct ngl_ctx *s, double t);
  */
 char *ngl_dot(struct ngl_ctx *s, double t);
 
+/**
+ * Profiling information of a single node for the last drawn frame
+ */
+struct ngl_node_stats {
+    const char *name;           /* name of the node */
+    int type;                   /* node type (any of NGL_NODE_*) */
+    int64_t update_time;        /* CPU time spent updating the node and its children, in microseconds */
+    int64_t update_self_time;   /* update_time minus the time spent in the children updates */
+    int64_t draw_time;          /* CPU time spent drawing the node and its children, in microseconds */
+    int64_t draw_self_time;     /* draw_time minus the time spent in the children draws */
+    int64_t gpu_time;           /* GPU time of the draws resolved during the frame in nanoseconds,
+                                   only set for Render and Compute nodes; -1 if none was resolved */
+    int nb_updates;             /* number of updates of the node */
+    int nb_draws;               /* number of draws of the node */
+};
+
+/**
+ * Profiling information of the last drawn frame
+ */
+struct ngl_stats {
+    int64_t frame_time;                 /* CPU time spent in ngl_draw(), in microseconds */
+    int64_t visit_time;                 /* CPU time spent visiting the scene, in microseconds */
+    int64_t prefetch_time;              /* CPU time spent prefetching and releasing resources, in microseconds */
+    int64_t update_time;                /* CPU time spent updating the scene, in microseconds */
+    int64_t draw_time;                  /* CPU time spent drawing the scene, in microseconds */
+    int nb_nodes;                       /* number of entries in nodes */
+    const struct ngl_node_stats *nodes; /* nodes updated or drawn during the frame */
+};
+
+/**
+ * Enable or disable the profiling of the node.gl context.
+ *
+ * When enabled, the CPU time spent in the update and draw of every node is
+ * measured during ngl_draw(). If the OpenGL context supports timer queries,
+ * the GPU time of every Render and Compute node is also measured. The GPU
+ * timings are read back asynchronously and are thus typically available a
+ * few frames later.
+ *
+ * @param s       pointer to a node.gl context
+ * @param enable  1 to enable the profiling, 0 to disable it
+ *
+ * @return 0 on success, < 0 on error
+ */
+int ngl_set_profiling(struct ngl_ctx *s, int enable);
+
+/**
+ * Get the profiling information of the last drawn frame.
+ *
+ * The profiling must have been enabled with ngl_set_profiling().
+ *
+ * The returned data is owned by the node.gl context and remains valid until
+ * the next call to ngl_draw(), ngl_get_stats(), ngl_set_scene() or
+ * ngl_free().
+ *
+ * @param s      pointer to the configured node.gl context
+ * @param stats  pointer to the destination stats structure
+ *
+ * @return 0 on success, < 0 on error
+ */
+int ngl_get_stats(struct ngl_ctx *s, struct ngl_stats *stats);
+
+/**
+ * OpenGL calls statistics of a single OpenGL entry point
+ */
+struct ngl_gl_call_stats {
+    const char *name;   /* name of the OpenGL function, such as "glBindBuffer" */
+    int64_t nb_calls;   /* number of calls to the function */
+    int64_t nb_bytes;   /* amount of data transferred by the calls, in bytes */
+};
+
+/**
+ * OpenGL calls statistics of the last drawn frame
+ */
+struct ngl_gl_stats {
+    int64_t nb_calls;                           /* total number of OpenGL calls */
+    int64_t upload_bytes;                       /* bytes uploaded with glBufferData(), glBufferSubData(),
+                                                   glTexImage*() and glTexSubImage*() */
+    int64_t readback_bytes;                     /* bytes read back with glReadPixels() and the buffers
+                                                   mapped with GL_MAP_READ_BIT */
+    int nb_entries;                             /* number of entries in entries */
+    const struct ngl_gl_call_stats *entries;    /* OpenGL functions called at least once during the frame */
+};
+
+/**
+ * Get the OpenGL calls statistics of the last drawn frame.
+ *
+ * Every OpenGL call made by node.gl from the start of ngl_draw() is counted
+ * per entry point, along with the amount of data uploaded to and read back
+ * from the GPU.
+ *
+ * The statistics are only available if node.gl is built with GL_STATS=yes.
+ *
+ * The returned data is owned by the node.gl context and remains valid until
+ * the next call to ngl_draw(), ngl_get_gl_stats() or ngl_free().
+ *
+ * @param s      pointer to the configured node.gl context
+ * @param stats  pointer to the destination GL stats structure
+ *
+ * @return 0 on success, < 0 on error
+ */
+int ngl_get_gl_stats(struct ngl_ctx *s, struct ngl_gl_stats *stats);
+
+/**
+ * GPU memory statistics of a node.gl context
+ *
+ * The sizes are estimated from the dimensions and formats of the resources
+ * and do not account for the driver internal padding and alignment.
+ */
+struct ngl_memory_stats {
+    int64_t budget;         /* GPU memory budget in bytes, 0 if unlimited */
+    int64_t total;          /* GPU memory currently allocated, in bytes */
+    int64_t peak;           /* maximum GPU memory allocated at once, in bytes */
+    int64_t textures;       /* GPU memory allocated for the textures, in bytes */
+    int64_t buffers;        /* GPU memory allocated for the buffers, in bytes */
+    int64_t renderbuffers;  /* GPU memory allocated for the renderbuffers, in bytes */
+    int nb_textures;        /* number of allocated textures */
+    int nb_buffers;         /* number of allocated buffers */
+    int nb_renderbuffers;   /* number of allocated renderbuffers */
+    int64_t nb_evictions;   /* number of idle resources evicted to honor the budget */
+    int64_t pool_size;      /* GPU memory held by the resource pool, in bytes (included in total) */
+    int nb_pooled;          /* number of resources in the pool */
+    int64_t pool_hits;      /* number of resources recycled from the pool */
+    int64_t pool_misses;    /* number of resources allocated because none matched in the pool */
+};
+
+/**
+ * Set the GPU memory budget of the node.gl context.
+ *
+ * The textures, buffers and renderbuffers allocated by the scene are
+ * accounted for. While the budget is exceeded, the resources kept alive by a
+ * TimeRangeFilter while they are not in use (see its prefetch_time and
+ * max_idle_time parameters) are released, starting with the least recently
+ * used, and no resource is prefetched ahead of time. The resources in use by
+ * the current frame are never released, so the budget may still be exceeded.
+ *
+ * @param s       pointer to a node.gl context
+ * @param budget  GPU memory budget in bytes, 0 for unlimited (default);
+ *                negative values are rejected
+ *
+ * @return 0 on success, < 0 on error
+ */
+int ngl_set_memory_budget(struct ngl_ctx *s, int64_t budget);
+
+/**
+ * Set the maximum size of the resource pool of the node.gl context.
+ *
+ * The textures, renderbuffers and framebuffers released by the scene (for
+ * instance when a TimeRangeFilter child is not needed anymore) are kept in a
+ * pool, so they can be recycled by the next allocation of a resource with the
+ * same target, format, dimensions and samples instead of being destroyed and
+ * allocated again. The least recently released resources are destroyed when
+ * the pool exceeds its maximum size, and the whole pool is flushed when the
+ * GPU memory budget is exceeded.
+ *
+ * @param s         pointer to a node.gl context
+ * @param max_size  maximum size of the pool in bytes, 0 to disable the pool
+ *                  (default: 64 MiB); negative values are rejected
+ *
+ * @return 0 on success, < 0 on error
+ */
+int ngl_set_resource_pool_size(struct ngl_ctx *s, int64_t max_size);
+
+/**
+ * Get the GPU memory statistics of the node.gl context.
+ *
+ * @param s      pointer to a node.gl context
+ * @param stats  pointer to the destination memory stats structure
+ *
+ * @return 0 on success, < 0 on error
+ */
+int ngl_get_memory_stats(struct ngl_ctx *s, struct ngl_memory_stats *stats);
+
+/**
+ * Frame budget statistics of a node.gl context
+ */
+struct ngl_frame_budget_stats {
+    int64_t budget;             /* frame budget in microseconds, 0 if unlimited */
+    int nb_deferred;            /* number of prefetches deferred during the last frame */
+    int nb_skipped;             /* number of nodes in use skipped during the last frame (included in nb_deferred) */
+    int64_t total_deferred;     /* number of prefetches deferred since the creation of the context */
+    int64_t total_skipped;      /* number of node skips since the creation of the context */
+    int64_t nb_frames;          /* number of frames drawn */
+    int64_t nb_late_frames;     /* number of frames for which ngl_draw() exceeded the budget */
+    int64_t max_frame_time;     /* longest ngl_draw() in microseconds */
+};
+
+/**
+ * Set the frame budget of the node.gl context.
+ *
+ * When many nodes need to be prefetched at once (at the start of the scene
+ * or at a TimeRangeFilter boundary), the prefetches which would start after
+ * the budget is spent in the current ngl_draw() are deferred to the next
+ * frames. At least one node is prefetched per frame.
+ *
+ * The nodes only prefetched ahead of their use (see the TimeRangeFilter
+ * prefetch_time parameter) are always deferred first. The nodes in use by
+ * the current frame are only deferred if skip is set: they are then not
+ * updated nor drawn until they are ready, along with their parents in the
+ * same situation. Otherwise, they are prefetched regardless of the budget.
+ *
+ * @param s       pointer to a node.gl context
+ * @param budget  frame budget in microseconds, 0 for unlimited (default)
+ * @param skip    1 to allow the nodes in use to be deferred, 0 otherwise
+ *
+ * @return 0 on success, < 0 on error
+ */
+int ngl_set_frame_budget(struct ngl_ctx *s, int64_t budget, int skip);
+
+/**
+ * Get the frame budget statistics of the node.gl context.
+ *
+ * @param s      pointer to a node.gl context
+ * @param stats  pointer to the destination frame budget stats structure
+ *
+ * @return 0 on success, < 0 on error
+ */
+int ngl_get_frame_budget_stats(struct ngl_ctx *s, struct ngl_frame_budget_stats *stats);
+
+/**
+ * Start recording trace events.
+ *
+ * Events are recorded for the visit, prefetch, release, update and draw of
+ * every node, as well as for the media frame fetching, the hardware uploads
+ * and the shader compilations, in all the threads calling node.gl.
+ *
+ * Tracing is only available if node.gl is built with TRACE=yes. The events
+ * are recorded without lock, into a ring per thread which is only allocated
+ * once tracing is started.
+ *
+ * @return 0 on success, < 0 on error
+ *
+ * @see ngl_trace_dump()
+ */
+int ngl_trace_start(void);
+
+/**
+ * Stop recording trace events and write them to a file in the Chrome trace
+ * event JSON format, which can be loaded in chrome://tracing or Perfetto.
+ *
+ * @param filename  path to the destination JSON file
+ *
+ * @return 0 on success, < 0 on error
+ */
+int ngl_trace_dump(const char *filename);
+
 /**
  * Destroy a node.gl context. The passed context pointer will also be set to
  * NULL.
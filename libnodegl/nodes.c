@@ -31,6 +31,8 @@
 #include "nodegl.h"
 #include "nodes.h"
 #include "params.h"
+#include "stats.h"
+#include "trace.h"
 #include "utils.h"
 #include "nodes_register.h"
 
@@ -76,6 +78,7 @@ static struct ngl_node *node_create(const struct node_class *class)
 
     node->class = class;
     node->last_update_time = -1.;
+    node->last_eval_time = -1.;
     node->visit_time = -1.;
 
     node->refcount = 1;
@@ -173,6 +176,8 @@ struct ngl_node *ngl_node_create(int type, ...)
 
 static void node_release(struct ngl_node *node)
 {
+    ngli_preload_wait(node);
+
     if (node->state == STATE_IDLE)
         return;
 
@@ -182,10 +187,13 @@ static void node_release(struct ngl_node *node)
     ngli_assert(node->ctx);
     if (node->class->release) {
         LOG(DEBUG, "RELEASE %s @ %p", node->name, node);
+        TRACE_BEGIN("release", node->name);
         node->class->release(node);
+        TRACE_END("release", node->name);
     }
     node->state = STATE_IDLE;
     node->last_update_time = -1.;
+    node->last_eval_time = -1.;
 }
 
 /*
@@ -220,8 +228,12 @@ static void node_uninit(struct ngl_node *node)
         LOG(VERBOSE, "UNINIT %s @ %p", node->name, node);
         node->class->uninit(node);
     }
+    ngli_stats_node_uninit(node);
     reset_non_params(node);
     node->state = STATE_UNINITIALIZED;
+    node->prefetch_deferred = 0;
+    node->last_update_time = -1.;
+    node->last_eval_time = -1.;
 }
 
 static int node_set_children_ctx(uint8_t *base_ptr, const struct node_param *params,
@@ -277,10 +289,14 @@ static int node_set_ctx(struct ngl_node *node, struct ngl_ctx *ctx)
                 return -1;
             }
         } else {
+            if ((ret = ngli_updatequeue_track(&ctx->updatequeue, node)) < 0)
+                return ret;
             node->ctx = ctx;
         }
     } else {
         node_uninit(node);
+        if (node->ctx)
+            ngli_updatequeue_untrack(&node->ctx->updatequeue, node);
         node->ctx = NULL;
     }
 
@@ -301,6 +317,15 @@ void ngli_node_detach_ctx(struct ngl_node *node)
     ngli_assert(ret == 0);
 }
 
+/* Detach the node alone, its children remain attached */
+void ngli_node_detach_ctx_self(struct ngl_node *node)
+{
+    node_uninit(node);
+    if (node->ctx)
+        ngli_updatequeue_untrack(&node->ctx->updatequeue, node);
+    node->ctx = NULL;
+}
+
 int ngli_node_init(struct ngl_node *node)
 {
     if (node->state == STATE_INITIALIZED)
@@ -322,7 +347,23 @@ int ngli_node_init(struct ngl_node *node)
     return 0;
 }
 
-int ngli_node_visit(struct ngl_node *node, int is_active, double t)
+static int register_evaluation(struct ngl_node *node)
+{
+    struct ngl_ctx *ctx = node->ctx;
+
+    if (ctx->nb_eval_nodes == ctx->eval_nodes_size) {
+        const int size = ctx->eval_nodes_size ? ctx->eval_nodes_size * 2 : 64;
+        struct ngl_node **nodes = realloc(ctx->eval_nodes, size * sizeof(*nodes));
+        if (!nodes)
+            return -1;
+        ctx->eval_nodes = nodes;
+        ctx->eval_nodes_size = size;
+    }
+    ctx->eval_nodes[ctx->nb_eval_nodes++] = node;
+    return 0;
+}
+
+static int node_visit(struct ngl_node *node, int is_active, double t)
 {
     int ret = ngli_node_init(node);
     if (ret < 0)
@@ -351,9 +392,16 @@ int ngli_node_visit(struct ngl_node *node, int is_active, double t)
          * active state takes over to replace the one from a previous update.
          */
         node->is_active = is_active;
+        node->is_used = is_active && !node->ctx->visit_ahead;
         node->visit_time = t;
         LOG(VERBOSE, "%s visited at t=%f is %s", node->name, t,
             state_str[is_active]);
+
+        if (node->class->evaluate) {
+            ret = register_evaluation(node);
+            if (ret < 0)
+                return ret;
+        }
     } else {
         /*
          * This is not the first time we come across that node, so if it's
@@ -364,6 +412,7 @@ int ngli_node_visit(struct ngl_node *node, int is_active, double t)
             node->name, t, state_str[node->is_active], state_str[is_active],
             state_str[node->is_active | is_active]);
         node->is_active |= is_active;
+        node->is_used |= is_active && !node->ctx->visit_ahead;
     }
 
     if (node->class->visit)
@@ -415,6 +464,14 @@ int ngli_node_visit(struct ngl_node *node, int is_active, double t)
     return 0;
 }
 
+int ngli_node_visit(struct ngl_node *node, int is_active, double t)
+{
+    TRACE_BEGIN("visit", node->name);
+    int ret = node_visit(node, is_active, t);
+    TRACE_END("visit", node->name);
+    return ret;
+}
+
 static int node_prefetch(struct ngl_node *node)
 {
     if (node->state == STATE_READY)
@@ -426,7 +483,9 @@ static int node_prefetch(struct ngl_node *node)
 
     if (node->class->prefetch) {
         LOG(DEBUG, "PREFETCH %s @ %p", node->name, node);
+        TRACE_BEGIN("prefetch", node->name);
         ret = node->class->prefetch(node);
+        TRACE_END("prefetch", node->name);
         if (ret < 0)
             return ret;
     }
@@ -435,7 +494,29 @@ static int node_prefetch(struct ngl_node *node)
     return 0;
 }
 
-int ngli_node_honor_release_prefetch(struct ngl_node *node, double t)
+/*
+ * Whether the prefetch of the node must be deferred to a later frame to
+ * honor the frame budget. A node is also deferred when some of its children
+ * were, so it never relies on a child which is not ready.
+ */
+static int defer_prefetch(struct ngl_node *node, int children_deferred)
+{
+    struct ngl_ctx *ctx = node->ctx;
+
+    if (node->is_used && !ctx->frame_budget_skip)
+        return 0;
+
+    if (children_deferred)
+        return 1;
+
+    /* At least one node is prefetched per frame so the loading progresses */
+    if (!ctx->frame_budget || !ctx->nb_frame_prefetches)
+        return 0;
+
+    return ngli_gettime() - ctx->frame_start >= ctx->frame_budget;
+}
+
+static int honor_release_prefetch(struct ngl_node *node, double t, int budget, int *deferredp)
 {
     uint8_t *base_ptr = node->priv_data;
     const struct node_param *par = node->class->params;
@@ -443,13 +524,15 @@ int ngli_node_honor_release_prefetch(struct ngl_node *node, double t)
     if (node->visit_time != t)
         return 0;
 
+    int children_deferred = 0;
+
     while (par && par->key) {
         switch (par->type) {
             case PARAM_TYPE_NODE: {
                 uint8_t *child_p = base_ptr + par->offset;
                 struct ngl_node *child = *(struct ngl_node **)child_p;
                 if (child) {
-                    int ret = ngli_node_honor_release_prefetch(child, t);
+                    int ret = honor_release_prefetch(child, t, budget, &children_deferred);
                     if (ret < 0)
                         return ret;
                 }
@@ -461,7 +544,7 @@ int ngli_node_honor_release_prefetch(struct ngl_node *node, double t)
                 struct ngl_node **elems = *(struct ngl_node ***)elems_p;
                 const int nb_elems = *(int *)nb_elems_p;
                 for (int i = 0; i < nb_elems; i++) {
-                    int ret = ngli_node_honor_release_prefetch(elems[i], t);
+                    int ret = honor_release_prefetch(elems[i], t, budget, &children_deferred);
                     if (ret < 0)
                         return ret;
                 }
@@ -473,7 +556,7 @@ int ngli_node_honor_release_prefetch(struct ngl_node *node, double t)
                     break;
                 const struct hmap_entry *entry = NULL;
                 while ((entry = ngli_hmap_next(hmap, entry))) {
-                    int ret = ngli_node_honor_release_prefetch(entry->data, t);
+                    int ret = honor_release_prefetch(entry->data, t, budget, &children_deferred);
                     if (ret < 0)
                         return ret;
                 }
@@ -483,19 +566,156 @@ int ngli_node_honor_release_prefetch(struct ngl_node *node, double t)
         par++;
     }
 
-    if (node->is_active)
+    node->prefetch_deferred = 0;
+
+    if (node->is_active) {
+        if (node->state == STATE_READY) {
+            /* A ready node can not be updated nor drawn with a deferred child */
+            if (budget && children_deferred && defer_prefetch(node, children_deferred)) {
+                LOG(VERBOSE, "skip %s until its children are ready", node->name);
+                node->prefetch_deferred = 1;
+                *deferredp = 1;
+            }
+            return 0;
+        }
+
+        if (budget && defer_prefetch(node, children_deferred)) {
+            struct ngl_frame_budget_stats *fb = &node->ctx->frame_budget_stats;
+            LOG(VERBOSE, "defer prefetch of %s to honor the frame budget", node->name);
+            node->prefetch_deferred = 1;
+            *deferredp = 1;
+            fb->nb_deferred++;
+            fb->total_deferred++;
+            if (node->is_used) {
+                fb->nb_skipped++;
+                fb->total_skipped++;
+            }
+            return 0;
+        }
+
+        node->ctx->nb_frame_prefetches++;
         return node_prefetch(node);
+    }
 
     node_release(node);
     return 0;
 }
 
+int ngli_node_honor_release_prefetch(struct ngl_node *node, double t)
+{
+    int deferred = 0;
+    return honor_release_prefetch(node, t, 0, &deferred);
+}
+
+/*
+ * Same as ngli_node_honor_release_prefetch() but the prefetches exceeding the
+ * frame budget of the context are deferred to the next frames.
+ */
+int ngli_node_honor_release_prefetch_budget(struct ngl_node *node, double t)
+{
+    int deferred = 0;
+    return honor_release_prefetch(node, t, 1, &deferred);
+}
+
+int ngli_node_evaluate(struct ngl_node *node, double t)
+{
+    ngli_preload_wait(node);
+    if (node->last_eval_time == t)
+        return 0;
+    int ret = node->class->evaluate(node, t);
+    if (ret < 0)
+        return ret;
+    node->last_eval_time = t;
+    return 0;
+}
+
+struct evaluation {
+    struct ngl_node **nodes;
+    double t;
+};
+
+static int evaluate_nodes(void *arg, int start, int end)
+{
+    const struct evaluation *e = arg;
+    for (int i = start; i < end; i++) {
+        int ret = ngli_node_evaluate(e->nodes[i], e->t);
+        if (ret < 0)
+            return ret;
+    }
+    return 0;
+}
+
+#define MIN_PARALLEL_EVALUATIONS 64
+
+/*
+ * Evaluate the nodes registered during the visit of the scene, across the
+ * threads of the context when there are enough of them.
+ */
+int ngli_node_evaluate_registered(struct ngl_ctx *ctx, double t)
+{
+    struct evaluation e = {.nodes = ctx->eval_nodes, .t = t};
+    const int nb_nodes = ctx->nb_eval_nodes;
+
+    const int nb_threads = ctx->nb_update_threads ? ctx->nb_update_threads : ngli_get_nb_cpus();
+    if (nb_threads <= 1 || nb_nodes < MIN_PARALLEL_EVALUATIONS)
+        return evaluate_nodes(&e, 0, nb_nodes);
+
+    if (!ctx->threadpool) {
+        ctx->threadpool = ngli_threadpool_create(nb_threads - 1);
+        if (!ctx->threadpool)
+            return -1;
+    }
+
+    TRACE_BEGIN("evaluate", "scene");
+    int ret = ngli_threadpool_run(ctx->threadpool, evaluate_nodes, &e, nb_nodes);
+    TRACE_END("evaluate", "scene");
+    return ret;
+}
+
+/*
+ * Only keep the nodes in use among the registered ones (the branches only
+ * started ahead of their use are not updated) and evaluate them
+ * when they are worth spreading across threads. The nodes missed for any
+ * reason are evaluated later on by ngli_node_update().
+ */
+int ngli_node_evaluate_all(struct ngl_ctx *ctx, double t)
+{
+    int nb_nodes = 0;
+    for (int i = 0; i < ctx->nb_eval_nodes; i++) {
+        struct ngl_node *node = ctx->eval_nodes[i];
+        if (node->is_used && node->state == STATE_READY)
+            ctx->eval_nodes[nb_nodes++] = node;
+    }
+    ctx->nb_eval_nodes = nb_nodes;
+
+    /* The profiling measures the evaluation time of each node in the update pass */
+    if (ctx->stats.enabled || nb_nodes < MIN_PARALLEL_EVALUATIONS)
+        return 0;
+
+    return ngli_node_evaluate_registered(ctx, t);
+}
+
+int ngli_node_run_update(struct ngl_node *node, double t)
+{
+    ngli_preload_wait(node);
+    if (node->class->evaluate) {
+        int ret = ngli_node_evaluate(node, t);
+        if (ret < 0)
+            return ret;
+    }
+    return node->class->update ? node->class->update(node, t) : 0;
+}
+
 int ngli_node_update(struct ngl_node *node, double t)
 {
     int ret = ngli_node_init(node);
     if (ret < 0)
         return ret;
-    if (node->class->update) {
+    if (node->prefetch_deferred) {
+        LOG(VERBOSE, "%s is not ready, skip its update", node->name);
+        return 0;
+    }
+    if (node->class->update || node->class->evaluate) {
         if (node->last_update_time != t) {
             // Sometimes the node might not be prefetched by the node_check_prefetch()
             // crawling: this could happen when the node was for instance instantiated
@@ -506,7 +726,12 @@ int ngli_node_update(struct ngl_node *node, double t)
                 return ret;
 
             LOG(VERBOSE, "UPDATE %s @ %p with t=%g", node->name, node, t);
-            ret = node->class->update(node, t);
+            TRACE_BEGIN("update", node->name);
+            if (node->ctx->stats.enabled)
+                ret = ngli_stats_node_update(node, t);
+            else
+                ret = ngli_node_run_update(node, t);
+            TRACE_END("update", node->name);
             if (ret < 0)
                 return ret;
         } else {
@@ -520,9 +745,18 @@ int ngli_node_update(struct ngl_node *node, double t)
 
 void ngli_node_draw(struct ngl_node *node)
 {
+    if (node->prefetch_deferred) {
+        LOG(VERBOSE, "%s is not ready, skip its draw", node->name);
+        return;
+    }
     if (node->class->draw) {
         LOG(VERBOSE, "DRAW %s @ %p", node->name, node);
-        node->class->draw(node);
+        TRACE_BEGIN("draw", node->name);
+        if (node->ctx->stats.enabled)
+            ngli_stats_node_draw(node);
+        else
+            node->class->draw(node);
+        TRACE_END("draw", node->name);
     }
 }
 
@@ -577,6 +811,29 @@ int ngl_node_param_set(struct ngl_node *node, const char *key, ...)
     return ret;
 }
 
+int ngl_node_param_set_data(struct ngl_node *node, const char *key, int size, void *data,
+                            void (*release)(void *opaque), void *opaque)
+{
+    uint8_t *base_ptr;
+    const struct node_param *par = ngli_node_param_find(node, key, &base_ptr);
+    if (!par) {
+        release(opaque);
+        return -1;
+    }
+
+    if (par->type != PARAM_TYPE_DATA) {
+        LOG(ERROR, "%s.%s is not a data parameter", node->name, key);
+        release(opaque);
+        return -1;
+    }
+
+    int ret = ngli_params_borrow_data(base_ptr + par->offset, size, data, release, opaque);
+    if (ret < 0)
+        LOG(ERROR, "unable to set %s.%s", node->name, key);
+    node_uninit(node); // need a reinit after changing options
+    return ret;
+}
+
 struct ngl_node *ngl_node_ref(struct ngl_node *node)
 {
     node->refcount++;
@@ -34,11 +34,23 @@
 #include <CoreVideo/CoreVideo.h>
 #endif
 
+#include "buffercache.h"
+#include "bufstream.h"
+#include "drawahead.h"
 #include "glincludes.h"
 #include "glcontext.h"
+#include "glpool.h"
 #include "glstate.h"
+#include "gpumem.h"
 #include "hmap.h"
+#include "memorybarrier.h"
 #include "params.h"
+#include "preload.h"
+#include "stats.h"
+#include "threadpool.h"
+#include "transient.h"
+#include "updatequeue.h"
+#include "uniformbuffer.h"
 
 struct node_class;
 
@@ -53,6 +65,33 @@ struct ngl_ctx {
     struct glcontext *glcontext;
     struct glstate *glstate;
     struct ngl_node *scene;
+    struct stats stats;
+    struct hmap *buffer_cache;
+    struct gpumem gpumem;
+    struct glpool glpool;
+    struct transient **transients;
+    int nb_transients;
+    int rtt_level;          // nesting level of the RenderToTexture being drawn
+    struct memorybarrier memorybarrier;
+    struct updatequeue updatequeue;
+
+    /* Nodes visited for the current frame with a CPU evaluation pending */
+    struct ngl_node **eval_nodes;
+    int nb_eval_nodes;
+    int eval_nodes_size;
+    struct threadpool *threadpool;
+    int nb_update_threads;  // 0 for automatic
+    struct drawahead drawahead;
+    struct preload preload;
+    int visit_ahead;        // visiting a branch only started ahead of its use
+    int nb_started_ahead;   // branches started ahead of their use in the current frame
+
+    /* Frame budget */
+    int64_t frame_budget;   // in microseconds, 0 for unlimited
+    int frame_budget_skip;  // nodes in use can be deferred and skipped
+    int64_t frame_start;
+    int nb_frame_prefetches;
+    struct ngl_frame_budget_stats frame_budget_stats;
 };
 
 struct ngl_node {
@@ -65,12 +104,17 @@ struct ngl_node {
     int state;
 
     double last_update_time;
+    double last_eval_time;
 
     int is_active;
+    int is_used;            // active for its use in the current frame, not only started ahead
+    int prefetch_deferred;  // prefetch deferred to a later frame by the frame budget
     double visit_time;
 
     char *name;
 
+    struct node_stats *stats;
+
     void *priv_data;
 };
 
@@ -164,7 +208,7 @@ struct ngl_node *ngli_geometry_generate_indices_buffer(struct ngl_ctx *ctx, int
 
 struct buffer {
     int count;              // number of elements
-    uint8_t *data;          // buffer of <count> elements
+    uint8_t *data;          // buffer of <count> elements set by the user
     int data_size;          // total buffer data size in bytes
     char *filename;         // filename from which the data will be read
     int data_comp;          // number of components per element
@@ -178,12 +222,28 @@ struct buffer {
     int current_kf;
 
     int fd;
+    uint8_t *own_buf;       // data allocated by the node (from the count or the filename)
+    uint8_t *data_ptr;      // data in use: the user data or own_buf
 
     /* private option that must be set before calling ngl_node_init() to enable
      * the generation of a GL buffer feed with the buffer data; mandatory for
      * buffers used as geometry, attributes or shader storage buffer objects */
     int generate_gl_buffer;
+    /* private option that must be set before calling ngl_node_init() to
+     * share the GL buffer with the other buffers holding the same data; only
+     * suitable for buffers never written by the GPU */
+    int share_gl_buffer;
+    struct buffercache_entry *cache_entry;
     GLuint buffer_id;
+    int buffer_offset;      // offset of the data in the GL buffer
+
+    /* memory barrier bits matching the way the GL buffer is consumed, and
+     * sequence of the last barrier required after a write by the GPU */
+    GLbitfield barrier_bits;
+    int64_t write_seq;
+
+    /* animatedbuffer: streaming GL buffer, written every update */
+    struct bufstream stream;
 };
 
 struct uniform {
@@ -200,14 +260,23 @@ struct rtt {
     struct ngl_node *color_texture;
     struct ngl_node *depth_texture;
     int samples;
+    int depth_mode;
     int width;
     int height;
+    int use_depth;
+    int child_depth_test;   // auto depth mode: depth testing enabled in the child
     GLuint framebuffer_id;
     GLuint renderbuffer_id;
 
     GLuint framebuffer_ms_id;
     GLuint colorbuffer_ms_id;
     GLuint depthbuffer_ms_id;
+
+    /* transient renderbuffers, aliased with the other RenderToTexture nodes;
+     * the *_id fields hold the ones currently attached */
+    struct transient *depthbuffer;
+    struct transient *colorbuffer_ms;
+    struct transient *depthbuffer_ms;
 };
 
 struct program {
@@ -254,6 +323,12 @@ struct texture {
     GLuint id;
     GLuint local_id;
     GLenum local_target;
+    struct glpool_key local_key;
+    int64_t gpu_size;       // estimated size of the local texture storage
+    GLbitfield barrier_bits;  // see struct buffer
+    int64_t write_seq;
+    int64_t generation;         // incremented on each write of the local texture content
+    int64_t mipmap_generation;  // content generation the mipmap levels were built from
 
     int upload_fmt;
     struct ngl_node *quad;
@@ -278,6 +353,8 @@ int ngli_texture_update_local_texture(struct ngl_node *node,
                                       int width, int height, int depth,
                                       const uint8_t *data);
 
+void ngli_texture_update_mipmap(struct ngl_node *node);
+
 struct uniformprograminfo {
     GLint id;
     GLint size;
@@ -305,6 +382,7 @@ struct render {
     struct hmap *uniforms;
     struct uniformprograminfo *uniform_ids;
     int nb_uniform_ids;
+    struct uniformbuffer uniformbuffer;
 
     struct hmap *attributes;
     GLint *attribute_ids;
@@ -312,6 +390,9 @@ struct render {
     struct hmap *buffers;
     GLint *buffer_ids;
 
+    struct ngl_node *indirect_buffer;
+    int nb_indirect_cmds;
+
     GLuint vao_id;
 };
 
@@ -328,12 +409,15 @@ struct compute {
     struct hmap *uniforms;
     struct uniformprograminfo *uniform_ids;
     int nb_uniform_ids;
+    struct uniformbuffer uniformbuffer;
 
     struct hmap *attributes;
     GLint *attribute_ids;
 
     struct hmap *buffers;
     GLint *buffer_ids;
+
+    struct ngl_node *indirect_buffer;
 };
 
 struct media {
@@ -350,6 +434,13 @@ struct media {
 
     struct sxplayer_ctx *player;
     struct sxplayer_frame *frame;
+    struct sxplayer_frame *next_frame;  // fetched by evaluate() for the next update()
+    double next_media_time;             // media time next_frame was fetched for
+    int remap_kf;
+
+    struct sxplayer_frame *preloaded_frame; // fetched by preload() for preload_media_time
+    double preload_media_time;
+    int preload_remap_kf;
 
 #ifdef TARGET_ANDROID
     GLuint android_texture_id;
@@ -403,6 +494,12 @@ struct animation {
     double scalar;
 };
 
+/*
+ * Thread-safe evaluation of an animation initialized beforehand, with the
+ * key frame lookup cache provided by the caller
+ */
+int ngli_animation_evaluate(const struct ngl_node *node, void *dst, double t, int *current_kf);
+
 struct animkeyframe {
     double time;
     float value[4];
@@ -470,12 +567,28 @@ struct fps {
  * Note: nodes implementation do NOT have to implement this logic, but they can
  * rely on these properties in their callback implementations.
  */
+/*
+ * The evaluate() callback is the CPU-only part of the update: it must not
+ * make any GL call nor access anything but the private data of the node and
+ * its (already initialized) children parameters, since the evaluations of
+ * the visited nodes are spread across the threads of the context before the
+ * update pass. It is called once per time, before update().
+ *
+ * The optional preload() callback is the CPU-only part of the warm-up of a
+ * node started ahead of its first use at time t (media seeking, decoding,
+ * ...). It follows the same restrictions as evaluate() and runs in a
+ * separate thread, concurrently with the render thread: every access of the
+ * render thread to the private data of the node is guarded by
+ * ngli_preload_wait().
+ */
 struct node_class {
     int id;
     const char *name;
     int (*init)(struct ngl_node *node);
     int (*visit)(struct ngl_node *node, int is_active, double t);
     int (*prefetch)(struct ngl_node *node);
+    int (*evaluate)(struct ngl_node *node, double t);
+    int (*preload)(struct ngl_node *node, double t);
     int (*update)(struct ngl_node *node, double t);
     void (*draw)(struct ngl_node *node);
     void (*release)(struct ngl_node *node);
@@ -492,12 +605,18 @@ void ngli_node_print_specs(void);
 int ngli_node_init(struct ngl_node *node);
 int ngli_node_visit(struct ngl_node *node, int is_active, double t);
 int ngli_node_honor_release_prefetch(struct ngl_node *node, double t);
+int ngli_node_honor_release_prefetch_budget(struct ngl_node *node, double t);
+int ngli_node_evaluate(struct ngl_node *node, double t);
+int ngli_node_evaluate_registered(struct ngl_ctx *ctx, double t);
+int ngli_node_evaluate_all(struct ngl_ctx *ctx, double t);
 int ngli_node_update(struct ngl_node *node, double t);
+int ngli_node_run_update(struct ngl_node *node, double t);
 int ngli_prepare_draw(struct ngl_ctx *s, double t);
 void ngli_node_draw(struct ngl_node *node);
 
 int ngli_node_attach_ctx(struct ngl_node *node, struct ngl_ctx *ctx);
 void ngli_node_detach_ctx(struct ngl_node *node);
+void ngli_node_detach_ctx_self(struct ngl_node *node);
 
 char *ngli_node_default_name(const char *class_name);
 int ngli_is_default_name(const char *class_name, const char *str);
@@ -505,4 +624,14 @@ struct ngl_node *ngli_node_create_noconstructor(int type);
 const struct node_param *ngli_node_param_find(const struct ngl_node *node, const char *key,
                                               uint8_t **base_ptrp);
 
+/*
+ * Serialize the graph node by node, children first: the callback receives
+ * the serialized line of each node, in which the children are referenced by
+ * the identifiers previously returned by the callback, and returns the
+ * allocated identifier of the node
+ */
+typedef char *(*ngli_serialize_node_func)(void *opaque, const struct ngl_node *node, const char *line);
+int ngli_node_serialize_cb(const struct ngl_node *node,
+                           ngli_serialize_node_func func, void *opaque);
+
 #endif
@@ -19,6 +19,8 @@
  * under the License.
  */
 
+#include <pthread.h>
+#include <stdio.h>
 #include <string.h>
 #include <inttypes.h>
 
@@ -315,6 +317,134 @@ static int allowed_node(const struct ngl_node *node, const int *allowed_ids)
     return 0;
 }
 
+/*
+ * The data parameters are reference counted so that the clones of a graph
+ * share them (see ngl_node_clone()). The reference counter is stored in a
+ * header preceding the data, and since the clones may be released from
+ * different threads, it is protected by a lock.
+ *
+ * The data borrowed from the user (see ngl_node_param_set_data()) have no
+ * header: their reference counter is indexed by their address instead.
+ */
+#define DATA_HEADER_SIZE 16
+
+static pthread_mutex_t data_lock = PTHREAD_MUTEX_INITIALIZER;
+
+struct borrowed_data {
+    int refcount;
+    int size;
+    void (*release)(void *opaque);
+    void *opaque;
+};
+
+static struct hmap *borrowed_data;
+
+/* Must be called with the data lock held */
+static struct borrowed_data *get_borrowed_data(const uint8_t *data, char *key, size_t key_size)
+{
+    snprintf(key, key_size, "%p", data);
+    return borrowed_data ? ngli_hmap_get(borrowed_data, key) : NULL;
+}
+
+static uint8_t *data_create(int size)
+{
+    uint8_t *p = malloc(DATA_HEADER_SIZE + size);
+    if (!p)
+        return NULL;
+    *(int *)p = 1;
+    return p + DATA_HEADER_SIZE;
+}
+
+static uint8_t *data_ref(uint8_t *data)
+{
+    if (!data)
+        return NULL;
+    char key[32];
+    pthread_mutex_lock(&data_lock);
+    struct borrowed_data *b = get_borrowed_data(data, key, sizeof(key));
+    if (b)
+        b->refcount++;
+    else
+        (*(int *)(data - DATA_HEADER_SIZE))++;
+    pthread_mutex_unlock(&data_lock);
+    return data;
+}
+
+static void data_unrefp(uint8_t **datap)
+{
+    uint8_t *data = *datap;
+    if (!data)
+        return;
+    *datap = NULL;
+
+    char key[32];
+    pthread_mutex_lock(&data_lock);
+    struct borrowed_data *b = get_borrowed_data(data, key, sizeof(key));
+    if (b) {
+        const int delete = --b->refcount == 0;
+        if (delete) {
+            ngli_hmap_set(borrowed_data, key, NULL);
+            if (!ngli_hmap_count(borrowed_data))
+                ngli_hmap_freep(&borrowed_data);
+        }
+        pthread_mutex_unlock(&data_lock);
+        if (delete) {
+            b->release(b->opaque);
+            free(b);
+        }
+        return;
+    }
+    uint8_t *p = data - DATA_HEADER_SIZE;
+    const int delete = --(*(int *)p) == 0;
+    pthread_mutex_unlock(&data_lock);
+    if (delete)
+        free(p);
+}
+
+/*
+ * Reference the user data, which remains owned by the user until release()
+ * is called. If the same memory is already borrowed, it is already kept
+ * alive so the new borrow is released right away.
+ */
+static int data_borrow(uint8_t **dst, int size, void *data,
+                       void (*release)(void *opaque), void *opaque)
+{
+    char key[32];
+    pthread_mutex_lock(&data_lock);
+    struct borrowed_data *b = get_borrowed_data(data, key, sizeof(key));
+    if (b) {
+        if (size > b->size) {
+            pthread_mutex_unlock(&data_lock);
+            LOG(ERROR, "%p is already borrowed with a smaller size", data);
+            return -1;
+        }
+        b->refcount++;
+        pthread_mutex_unlock(&data_lock);
+        release(opaque);
+        *dst = data;
+        return 0;
+    }
+
+    int ret = -1;
+    if (!borrowed_data)
+        borrowed_data = ngli_hmap_create();
+    b = calloc(1, sizeof(*b));
+    if (borrowed_data && b) {
+        *b = (struct borrowed_data){1, size, release, opaque};
+        ret = ngli_hmap_set(borrowed_data, key, b);
+    }
+    if (ret < 0) {
+        free(b);
+        if (borrowed_data && !ngli_hmap_count(borrowed_data))
+            ngli_hmap_freep(&borrowed_data);
+    }
+    pthread_mutex_unlock(&data_lock);
+    if (ret < 0)
+        return ret;
+    *dst = data;
+    return 0;
+}
+
 static void node_hmap_free(void *user_arg, void *data)
 {
     struct ngl_node *node = data;
@@ -386,10 +516,9 @@ int ngli_params_set(uint8_t *base_ptr, const struct node_param *par, va_list *ap
             LOG(VERBOSE, "set %s to %p (of size %d)", par->key, data, size);
             uint8_t **dst = (uint8_t **)dstp;
 
-            free(*dst);
-            *dst = NULL;
+            data_unrefp(dst);
             if (data && size) {
-                *dst = malloc(size);
+                *dst = data_create(size);
                 if (!*dst)
                     return -1;
                 memcpy(*dst, data, size);
@@ -633,6 +762,41 @@ int ngli_params_add(uint8_t *base_ptr, const struct node_param *par,
     return 0;
 }
 
+/*
+ * Set the data parameter pointed by dstp to the user data without copying it
+ * (see ngl_node_param_set_data()). release() is called on error as well.
+ */
+int ngli_params_borrow_data(uint8_t *dstp, int size, void *data,
+                            void (*release)(void *opaque), void *opaque)
+{
+    uint8_t *borrowed = NULL;
+    if (data && size > 0) {
+        int ret = data_borrow(&borrowed, size, data, release, opaque);
+        if (ret < 0) {
+            release(opaque);
+            return ret;
+        }
+    } else {
+        release(opaque);
+        size = 0;
+    }
+    data_unrefp((uint8_t **)dstp);
+    *(uint8_t **)dstp = borrowed;
+    memcpy(dstp + sizeof(uint8_t *), &size, sizeof(size));
+    return 0;
+}
+
+/*
+ * Make the data parameter pointed by dstp share the data of the one pointed
+ * by srcp instead of holding a copy
+ */
+void ngli_params_share_data(uint8_t *dstp, const uint8_t *srcp)
+{
+    data_unrefp((uint8_t **)dstp);
+    *(uint8_t **)dstp = data_ref(*(uint8_t **)srcp);
+    memcpy(dstp + sizeof(uint8_t *), srcp + sizeof(uint8_t *), sizeof(int));
+}
+
 void ngli_params_free(uint8_t *base_ptr, const struct node_param *params)
 {
     if (!params)
@@ -648,11 +812,9 @@ void ngli_params_free(uint8_t *base_ptr, const struct node_param *params)
                 free(s);
                 break;
             }
-            case PARAM_TYPE_DATA: {
-                uint8_t *data = *(uint8_t **)parp;
-                free(data);
+            case PARAM_TYPE_DATA:
+                data_unrefp((uint8_t **)parp);
                 break;
-            }
             case PARAM_TYPE_NODE: {
                 uint8_t *node_p = base_ptr + par->offset;
                 struct ngl_node *node = *(struct ngl_node **)node_p;
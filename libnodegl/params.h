@@ -97,6 +97,9 @@ int ngli_params_vset(uint8_t *base_ptr, const struct node_param *par, ...);
 int ngli_params_set_constructors(uint8_t *base_ptr, const struct node_param *params, va_list *ap);
 int ngli_params_set_defaults(uint8_t *base_ptr, const struct node_param *params);
 int ngli_params_add(uint8_t *base_ptr, const struct node_param *par, int nb_elems, void *elems);
+void ngli_params_share_data(uint8_t *dstp, const uint8_t *srcp);
+int ngli_params_borrow_data(uint8_t *dstp, int size, void *data,
+                            void (*release)(void *opaque), void *opaque);
 void ngli_params_free(uint8_t *base_ptr, const struct node_param *params);
 
 #endif
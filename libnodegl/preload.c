@@ -0,0 +1,220 @@
+/*
+ * Copyright 2018 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hmap.h"
+#include "log.h"
+#include "nodegl.h"
+#include "nodes.h"
+#include "preload.h"
+#include "trace.h"
+
+static void *preload_thread(void *arg)
+{
+    struct ngl_ctx *s = arg;
+    struct preload *p = &s->preload;
+
+    pthread_mutex_lock(&p->lock);
+    for (;;) {
+        while (!p->stop && !p->nb_jobs)
+            pthread_cond_wait(&p->cond, &p->lock);
+        if (p->stop)
+            break;
+
+        struct preload_job *job = &p->jobs[0];
+        struct ngl_node *node = job->node;
+        const double t = job->t;
+        job->running = 1;
+        pthread_mutex_unlock(&p->lock);
+
+        LOG(DEBUG, "PRELOAD %s @ %p for t=%g", node->name, node, t);
+        TRACE_BEGIN("preload", node->name);
+        const int ret = node->class->preload(node, t);
+        TRACE_END("preload", node->name);
+        if (ret < 0)
+            LOG(WARNING, "unable to preload %s, it will be loaded when used", node->name);
+
+        pthread_mutex_lock(&p->lock);
+        p->nb_jobs--;
+        memmove(p->jobs, p->jobs + 1, p->nb_jobs * sizeof(*p->jobs));
+        pthread_cond_broadcast(&p->cond);
+    }
+    pthread_mutex_unlock(&p->lock);
+    return NULL;
+}
+
+int ngli_preload_init(struct preload *p)
+{
+    if (pthread_mutex_init(&p->lock, NULL))
+        return -1;
+    if (pthread_cond_init(&p->cond, NULL)) {
+        pthread_mutex_destroy(&p->lock);
+        return -1;
+    }
+    return 0;
+}
+
+static int find_job(const struct preload *p, const struct ngl_node *node)
+{
+    for (int i = 0; i < p->nb_jobs; i++)
+        if (p->jobs[i].node == node)
+            return i;
+    return -1;
+}
+
+static int queue_job(struct preload *p, struct ngl_node *node, double t)
+{
+    if (find_job(p, node) >= 0)
+        return 0;
+
+    if (p->nb_jobs == p->jobs_size) {
+        const int size = p->jobs_size ? p->jobs_size * 2 : 16;
+        struct preload_job *jobs = realloc(p->jobs, size * sizeof(*jobs));
+        if (!jobs)
+            return -1;
+        p->jobs = jobs;
+        p->jobs_size = size;
+    }
+    p->jobs[p->nb_jobs++] = (struct preload_job){.node = node, .t = t};
+    return 0;
+}
+
+static int queue_nodes(struct preload *p, struct ngl_node *node, double t);
+
+static int queue_children(struct preload *p, uint8_t *base_ptr,
+                          const struct node_param *par, double t)
+{
+    while (par && par->key) {
+        if (par->type == PARAM_TYPE_NODE) {
+            struct ngl_node *child = *(struct ngl_node **)(base_ptr + par->offset);
+            if (child) {
+                int ret = queue_nodes(p, child, t);
+                if (ret < 0)
+                    return ret;
+            }
+        } else if (par->type == PARAM_TYPE_NODELIST) {
+            struct ngl_node **elems = *(struct ngl_node ***)(base_ptr + par->offset);
+            const int nb_elems = *(int *)(base_ptr + par->offset + sizeof(struct ngl_node **));
+            for (int i = 0; i < nb_elems; i++) {
+                int ret = queue_nodes(p, elems[i], t);
+                if (ret < 0)
+                    return ret;
+            }
+        } else if (par->type == PARAM_TYPE_NODEDICT) {
+            struct hmap *hmap = *(struct hmap **)(base_ptr + par->offset);
+            const struct hmap_entry *entry = NULL;
+            while (hmap && (entry = ngli_hmap_next(hmap, entry))) {
+                int ret = queue_nodes(p, entry->data, t);
+                if (ret < 0)
+                    return ret;
+            }
+        }
+        par++;
+    }
+    return 0;
+}
+
+static int queue_nodes(struct preload *p, struct ngl_node *node, double t)
+{
+    if (node->state != STATE_READY)
+        return 0;
+
+    if (node->class->preload) {
+        int ret = queue_job(p, node, t);
+        if (ret < 0)
+            return ret;
+    }
+    return queue_children(p, node->priv_data, node->class->params, t);
+}
+
+/*
+ * Queue the preloading of the nodes of the branch starting at node, for
+ * their first use at time t. Only the nodes already prefetched are
+ * considered: their preload() is then run concurrently with the render
+ * thread until ngli_preload_wait() is called on them.
+ */
+int ngli_preload_schedule(struct ngl_ctx *s, struct ngl_node *node, double t)
+{
+    struct preload *p = &s->preload;
+
+    if (!p->thread_started) {
+        if (pthread_create(&p->thread, NULL, preload_thread, s)) {
+            LOG(ERROR, "unable to create the preload thread");
+            return -1;
+        }
+        p->thread_started = 1;
+    }
+
+    pthread_mutex_lock(&p->lock);
+    const int ret = queue_nodes(p, node, t);
+    pthread_cond_signal(&p->cond);
+    pthread_mutex_unlock(&p->lock);
+    return ret;
+}
+
+/*
+ * Must be called before the render thread touches the private data of a node
+ * implementing preload(): a pending preload is cancelled, and a running one
+ * is waited for.
+ */
+void ngli_preload_wait(struct ngl_node *node)
+{
+    if (!node->class->preload || !node->ctx)
+        return;
+
+    struct preload *p = &node->ctx->preload;
+    if (!p->thread_started)
+        return;
+
+    pthread_mutex_lock(&p->lock);
+    int i;
+    while ((i = find_job(p, node)) >= 0) {
+        if (!p->jobs[i].running) {
+            p->nb_jobs--;
+            memmove(p->jobs + i, p->jobs + i + 1, (p->nb_jobs - i) * sizeof(*p->jobs));
+            break;
+        }
+        pthread_cond_wait(&p->cond, &p->lock);
+    }
+    pthread_mutex_unlock(&p->lock);
+}
+
+void ngli_preload_reset(struct ngl_ctx *s)
+{
+    struct preload *p = &s->preload;
+
+    if (p->thread_started) {
+        pthread_mutex_lock(&p->lock);
+        p->stop = 1;
+        pthread_cond_broadcast(&p->cond);
+        pthread_mutex_unlock(&p->lock);
+        pthread_join(p->thread, NULL);
+        p->thread_started = 0;
+    }
+    pthread_cond_destroy(&p->cond);
+    pthread_mutex_destroy(&p->lock);
+    free(p->jobs);
+    p->jobs = NULL;
+    p->nb_jobs = p->jobs_size = 0;
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright 2018 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef PRELOAD_H
+#define PRELOAD_H
+
+#include <pthread.h>
+
+struct ngl_ctx;
+struct ngl_node;
+
+/*
+ * Preloading of the nodes started ahead of their use: the CPU side of their
+ * warm-up (such as the media seeking and decoding of the first frame) is run
+ * in a separate thread while the frames preceding their use are drawn.
+ */
+struct preload_job {
+    struct ngl_node *node;
+    double t;               // time of the first use of the node
+    int running;
+};
+
+struct preload {
+    pthread_t thread;
+    int thread_started;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    struct preload_job *jobs;   // FIFO, only the first job can be running
+    int nb_jobs;
+    int jobs_size;
+    int stop;
+};
+
+int ngli_preload_init(struct preload *p);
+int ngli_preload_schedule(struct ngl_ctx *s, struct ngl_node *node, double t);
+void ngli_preload_wait(struct ngl_node *node);
+void ngli_preload_reset(struct ngl_ctx *s);
+
+#endif /* PRELOAD_H */
@@ -0,0 +1,273 @@
+/*
+ * Copyright 2018 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hmap.h"
+#include "log.h"
+#include "nodegl.h"
+#include "nodes.h"
+#include "utils.h"
+
+extern const struct node_param ngli_base_node_params[];
+
+/*
+ * The live scene and the new scene are both serialized: a new node whose
+ * serialized line (parameters and children identifiers included) is identical
+ * to the line of a live node is replaced by this live node. Since the
+ * children are referenced by their identifiers, a node only matches if its
+ * whole sub-graph does.
+ */
+
+struct candidate {
+    int index;
+    struct candidate *next;
+};
+
+struct live_node {
+    struct ngl_node *node;
+    int matched;
+};
+
+struct patch {
+    struct hmap *candidates;    // serialized line -> struct candidate list
+    struct hmap *matches;       // new node pointer -> struct live_node index
+    struct live_node *live;
+    int nb_live;
+    int live_size;
+    struct ngl_node **created;  // new nodes without a live equivalent
+    int nb_created;
+    int created_size;
+};
+
+static void free_candidates(void *arg, void *data)
+{
+    struct candidate *c = data;
+    while (c) {
+        struct candidate *next = c->next;
+        free(c);
+        c = next;
+    }
+}
+
+static void free_match(void *arg, void *data)
+{
+    free(data);
+}
+
+static char *register_live_node(void *opaque, const struct ngl_node *node, const char *line)
+{
+    struct patch *p = opaque;
+
+    if (p->nb_live == p->live_size) {
+        const int size = p->live_size ? p->live_size * 2 : 64;
+        struct live_node *live = realloc(p->live, size * sizeof(*live));
+        if (!live)
+            return NULL;
+        p->live = live;
+        p->live_size = size;
+    }
+
+    struct candidate *c = calloc(1, sizeof(*c));
+    if (!c)
+        return NULL;
+    c->index = p->nb_live;
+
+    /* Identical nodes are chained after the first one registered */
+    struct candidate *head = ngli_hmap_get(p->candidates, line);
+    if (head) {
+        c->next = head->next;
+        head->next = c;
+    } else if (ngli_hmap_set(p->candidates, line, c) < 0) {
+        free(c);
+        return NULL;
+    }
+
+    p->live[p->nb_live++] = (struct live_node){.node = (struct ngl_node *)node};
+    return ngli_asprintf("%x", c->index);
+}
+
+static char *match_new_node(void *opaque, const struct ngl_node *node, const char *line)
+{
+    struct patch *p = opaque;
+
+    struct candidate *c = ngli_hmap_get(p->candidates, line);
+    while (c && p->live[c->index].matched)
+        c = c->next;
+
+    if (c) {
+        char key[32];
+        snprintf(key, sizeof(key), "%p", node);
+        int *index = malloc(sizeof(*index));
+        if (!index)
+            return NULL;
+        *index = c->index;
+        if (ngli_hmap_set(p->matches, key, index) < 0) {
+            free(index);
+            return NULL;
+        }
+        p->live[c->index].matched = 1;
+        return ngli_asprintf("%x", c->index);
+    }
+
+    if (p->nb_created == p->created_size) {
+        const int size = p->created_size ? p->created_size * 2 : 64;
+        struct ngl_node **created = realloc(p->created, size * sizeof(*created));
+        if (!created)
+            return NULL;
+        p->created = created;
+        p->created_size = size;
+    }
+    p->created[p->nb_created] = (struct ngl_node *)node;
+    return ngli_asprintf("n%x", p->nb_created++);
+}
+
+static struct ngl_node *get_live_node(struct patch *p, const struct ngl_node *node)
+{
+    char key[32];
+    snprintf(key, sizeof(key), "%p", node);
+    const int *index = ngli_hmap_get(p->matches, key);
+    return index ? p->live[*index].node : NULL;
+}
+
+static void replace_node(struct patch *p, struct ngl_node **nodep)
+{
+    struct ngl_node *live = get_live_node(p, *nodep);
+    if (!live)
+        return;
+    ngl_node_ref(live);
+    ngl_node_unrefp(nodep);
+    *nodep = live;
+}
+
+static void replace_children(struct patch *p, uint8_t *base_ptr, const struct node_param *par)
+{
+    while (par && par->key) {
+        uint8_t *parp = base_ptr + par->offset;
+
+        switch (par->type) {
+            case PARAM_TYPE_NODE: {
+                struct ngl_node **nodep = (struct ngl_node **)parp;
+                if (*nodep)
+                    replace_node(p, nodep);
+                break;
+            }
+            case PARAM_TYPE_NODELIST: {
+                struct ngl_node **elems = *(struct ngl_node ***)parp;
+                const int nb_elems = *(int *)(parp + sizeof(struct ngl_node **));
+                for (int i = 0; i < nb_elems; i++)
+                    replace_node(p, &elems[i]);
+                break;
+            }
+            case PARAM_TYPE_NODEDICT: {
+                struct hmap *hmap = *(struct hmap **)parp;
+                if (!hmap)
+                    break;
+                const struct hmap_entry *entry = NULL;
+                while ((entry = ngli_hmap_next(hmap, entry)))
+                    replace_node(p, (struct ngl_node **)&((struct hmap_entry *)entry)->data);
+                break;
+            }
+        }
+        par++;
+    }
+}
+
+int ngl_patch_scene(struct ngl_ctx *s, struct ngl_node *scene)
+{
+    if (!s->scene || !scene)
+        return ngl_set_scene(s, scene);
+
+    if (scene == s->scene)
+        return 0;
+
+    /* The queued updates target nodes of the current scene */
+    ngli_drawahead_wait(s);
+    ngli_updatequeue_apply(s);
+
+    struct patch p = {
+        .candidates = ngli_hmap_create(),
+        .matches    = ngli_hmap_create(),
+    };
+    int ret = -1;
+    if (!p.candidates || !p.matches)
+        goto end;
+    ngli_hmap_set_free(p.candidates, free_candidates, NULL);
+    ngli_hmap_set_free(p.matches, free_match, NULL);
+
+    if ((ret = ngli_node_serialize_cb(s->scene, register_live_node, &p)) < 0 ||
+        (ret = ngli_node_serialize_cb(scene, match_new_node, &p)) < 0)
+        goto end;
+
+    struct ngl_node *root = get_live_node(&p, scene);
+    if (root == s->scene) {
+        LOG(DEBUG, "scene is unchanged");
+        ret = 0;
+        goto end;
+    }
+
+    /*
+     * Splice the matching live sub-graphs into the new nodes. The new nodes
+     * left without parent are released along the way.
+     */
+    for (int i = 0; i < p.nb_created; i++) {
+        struct ngl_node *node = p.created[i];
+        replace_children(&p, node->priv_data, node->class->params);
+        replace_children(&p, (uint8_t *)node, ngli_base_node_params);
+    }
+
+    if (!root) {
+        root = scene;
+        ngli_updatequeue_purge(s);
+        ret = ngli_node_attach_ctx(root, s);
+        if (ret < 0) {
+            for (int i = 0; i < p.nb_created; i++)
+                if (p.created[i]->ctx == s)
+                    ngli_node_detach_ctx_self(p.created[i]);
+            goto end;
+        }
+    }
+
+    /* Parents are detached before their children (reverse serialization order) */
+    int nb_detached = 0;
+    for (int i = p.nb_live - 1; i >= 0; i--) {
+        if (!p.live[i].matched) {
+            ngli_node_detach_ctx_self(p.live[i].node);
+            nb_detached++;
+        }
+    }
+    LOG(DEBUG, "scene patched: %d/%d nodes kept, %d created, %d released",
+        p.nb_live - nb_detached, p.nb_live, p.nb_created, nb_detached);
+
+    ngl_node_unrefp(&s->scene);
+    s->scene = ngl_node_ref(root);
+    s->nb_eval_nodes = 0;
+    ret = 0;
+
+end:
+    ngli_hmap_freep(&p.candidates);
+    ngli_hmap_freep(&p.matches);
+    free(p.live);
+    free(p.created);
+    return ret;
+}
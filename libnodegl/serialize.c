@@ -36,19 +36,26 @@ static void free_func(void *arg, void *data)
     free(data);
 }
 
-static int register_node(struct hmap *nlist,
-                          const struct ngl_node *node)
+struct serial_ctx {
+    struct hmap *nlist;
+    struct bstr *line;
+    ngli_serialize_node_func func;
+    void *opaque;
+};
+
+static int register_node(struct serial_ctx *sctx,
+                         const struct ngl_node *node,
+                         char *id)
 {
     char key[32];
     int ret = snprintf(key, sizeof(key), "%p", node);
-    if (ret < 0)
+    if (ret < 0) {
+        free(id);
         return ret;
-    char *val = ngli_asprintf("%x", ngli_hmap_count(nlist));
-    if (!val)
-        return -1;
-    ret = ngli_hmap_set(nlist, key, val);
+    }
+    ret = ngli_hmap_set(sctx->nlist, key, id);
     if (ret < 0)
-        free(val);
+        free(id);
     return ret;
 }
 
@@ -277,12 +284,10 @@ static void serialize_options(struct hmap *nlist,
     }
 }
 
-static int serialize(struct hmap *nlist,
-                     struct bstr *b,
+static int serialize(struct serial_ctx *sctx,
                      const struct ngl_node *node);
 
-static int serialize_children(struct hmap *nlist,
-                               struct bstr *b,
+static int serialize_children(struct serial_ctx *sctx,
                                const struct ngl_node *node,
                                uint8_t *priv,
                                const struct node_param *p)
@@ -292,7 +297,7 @@ static int serialize_children(struct hmap *nlist,
             case PARAM_TYPE_NODE: {
                 const struct ngl_node *child = *(struct ngl_node **)(priv + p->offset);
                 if (child) {
-                    int ret = serialize(nlist, b, child);
+                    int ret = serialize(sctx, child);
                     if (ret < 0)
                         return ret;
                 }
@@ -303,7 +308,7 @@ static int serialize_children(struct hmap *nlist,
                 const int nb_children = *(int *)(priv + p->offset + sizeof(struct ngl_node **));
 
                 for (int i = 0; i < nb_children; i++) {
-                    int ret = serialize(nlist, b, children[i]);
+                    int ret = serialize(sctx, children[i]);
                     if (ret < 0)
                         return ret;
                 }
@@ -315,7 +320,7 @@ static int serialize_children(struct hmap *nlist,
                     break;
                 const struct hmap_entry *entry = NULL;
                 while ((entry = ngli_hmap_next(hmap, entry))) {
-                    int ret = serialize(nlist, b, entry->data);
+                    int ret = serialize(sctx, entry->data);
                     if (ret < 0)
                         return ret;
                 }
@@ -327,49 +332,86 @@ static int serialize_children(struct hmap *nlist,
     return 0;
 }
 
-static int serialize(struct hmap *nlist,
-                     struct bstr *b,
+static int serialize(struct serial_ctx *sctx,
                      const struct ngl_node *node)
 {
-    if (get_node_id(nlist, node))
+    if (get_node_id(sctx->nlist, node))
         return 0;
 
     int ret;
 
-    if ((ret = serialize_children(nlist, b, node, (uint8_t *)node, ngli_base_node_params)) < 0 ||
-        (ret = serialize_children(nlist, b, node, node->priv_data, node->class->params)) < 0)
+    if ((ret = serialize_children(sctx, node, (uint8_t *)node, ngli_base_node_params)) < 0 ||
+        (ret = serialize_children(sctx, node, node->priv_data, node->class->params)) < 0)
         return ret;
 
+    /* The children lines are complete at this point, the line can be reused */
+    struct bstr *b = sctx->line;
+    ngli_bstr_clear(b);
+
     const uint32_t tag = node->class->id;
     ngli_bstr_print(b, "%c%c%c%c",
                     tag >> 24 & 0xff,
                     tag >> 16 & 0xff,
                     tag >>  8 & 0xff,
                     tag       & 0xff);
-    serialize_options(nlist, b, node, node->priv_data, node->class->params);
-    serialize_options(nlist, b, node, (uint8_t *)node, ngli_base_node_params);
-    ngli_bstr_print(b, "\n");
+    serialize_options(sctx->nlist, b, node, node->priv_data, node->class->params);
+    serialize_options(sctx->nlist, b, node, (uint8_t *)node, ngli_base_node_params);
+
+    char *id = sctx->func(sctx->opaque, node, ngli_bstr_strptr(b));
+    if (!id)
+        return -1;
+
+    return register_node(sctx, node, id);
+}
+
+int ngli_node_serialize_cb(const struct ngl_node *node,
+                           ngli_serialize_node_func func, void *opaque)
+{
+    struct serial_ctx sctx = {
+        .nlist  = ngli_hmap_create(),
+        .line   = ngli_bstr_create(),
+        .func   = func,
+        .opaque = opaque,
+    };
+    int ret = -1;
+    if (!sctx.nlist || !sctx.line)
+        goto end;
+
+    ngli_hmap_set_free(sctx.nlist, free_func, NULL);
+    ret = serialize(&sctx, node);
+
+end:
+    ngli_hmap_freep(&sctx.nlist);
+    ngli_bstr_freep(&sctx.line);
+    return ret;
+}
+
+struct serializer {
+    struct bstr *b;
+    int nb_nodes;
+};
 
-    return register_node(nlist, node);
+static char *print_node(void *opaque, const struct ngl_node *node, const char *line)
+{
+    struct serializer *s = opaque;
+    ngli_bstr_print(s->b, "%s\n", line);
+    return ngli_asprintf("%x", s->nb_nodes++);
 }
 
 char *ngl_node_serialize(const struct ngl_node *node)
 {
     char *s = NULL;
-    struct hmap *nlist = ngli_hmap_create();
-    struct bstr *b = ngli_bstr_create();
-    if (!nlist || !b)
-        goto end;
+    struct serializer serializer = {.b = ngli_bstr_create()};
+    if (!serializer.b)
+        return NULL;
 
-    ngli_hmap_set_free(nlist, free_func, NULL);
-    ngli_bstr_print(b, "# Node.GL v%d.%d.%d\n",
+    ngli_bstr_print(serializer.b, "# Node.GL v%d.%d.%d\n",
                     NODEGL_VERSION_MAJOR, NODEGL_VERSION_MINOR, NODEGL_VERSION_MICRO);
-    if (serialize(nlist, b, node) < 0)
+    if (ngli_node_serialize_cb(node, print_node, &serializer) < 0)
         goto end;
-    s = ngli_bstr_strdup(b);
+    s = ngli_bstr_strdup(serializer.b);
 
 end:
-    ngli_hmap_freep(&nlist);
-    ngli_bstr_freep(&b);
+    ngli_bstr_freep(&serializer.b);
     return s;
 }
@@ -0,0 +1,270 @@
+/*
+ * Copyright 2018 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "glcontext.h"
+#include "log.h"
+#include "nodegl.h"
+#include "nodes.h"
+#include "stats.h"
+#include "utils.h"
+
+void ngli_stats_begin_frame(struct stats *stats)
+{
+    stats->frame_id++;
+    stats->children_time = 0;
+    stats->nb_nodes = 0;
+    memset(stats->stage_times, 0, sizeof(stats->stage_times));
+    stats->stage_start = ngli_gettime();
+}
+
+void ngli_stats_end_stage(struct stats *stats, int stage)
+{
+    const int64_t now = ngli_gettime();
+    stats->stage_times[stage] = now - stats->stage_start;
+    stats->stage_start = now;
+}
+
+static struct node_stats *get_node_stats(struct ngl_node *node)
+{
+    struct stats *stats = &node->ctx->stats;
+
+    if (!node->stats) {
+        node->stats = calloc(1, sizeof(*node->stats));
+        if (!node->stats)
+            return NULL;
+    }
+
+    struct node_stats *ns = node->stats;
+    if (ns->frame_id == stats->frame_id)
+        return ns;
+
+    if (stats->nb_nodes == stats->nodes_size) {
+        const int new_size = stats->nodes_size ? stats->nodes_size * 2 : 64;
+        struct ngl_node **new_nodes = realloc(stats->nodes, new_size * sizeof(*new_nodes));
+        if (!new_nodes)
+            return NULL;
+        stats->nodes = new_nodes;
+        stats->nodes_size = new_size;
+    }
+    stats->nodes[stats->nb_nodes++] = node;
+
+    ns->frame_id = stats->frame_id;
+    ns->update_time = 0;
+    ns->update_self_time = 0;
+    ns->draw_time = 0;
+    ns->draw_self_time = 0;
+    ns->gpu_time = -1;
+    ns->nb_updates = 0;
+    ns->nb_draws = 0;
+    return ns;
+}
+
+int ngli_stats_node_update(struct ngl_node *node, double t)
+{
+    struct stats *stats = &node->ctx->stats;
+    struct node_stats *ns = get_node_stats(node);
+    if (!ns)
+        return -1;
+
+    const int64_t parent_children_time = stats->children_time;
+    stats->children_time = 0;
+
+    const int64_t start = ngli_gettime();
+    int ret = ngli_node_run_update(node, t);
+    const int64_t elapsed = ngli_gettime() - start;
+
+    ns->update_time += elapsed;
+    ns->update_self_time += elapsed - stats->children_time;
+    ns->nb_updates++;
+    stats->children_time = parent_children_time + elapsed;
+
+    return ret;
+}
+
+/*
+ * Read back the results of the pending queries without stalling the
+ * pipeline: only the queries for which the result is already available are
+ * consumed, the others will be checked again on the next draw.
+ *
+ * With GL_EXT_disjoint_timer_query, a disjoint operation (such as a GPU
+ * frequency change) invalidates the results of the queries in flight: they
+ * are consumed but their values are discarded.
+ */
+static void resolve_gpu_queries(const struct glcontext *glcontext, struct node_stats *ns)
+{
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    GLint disjoint = 0;
+    if (glcontext->es && ns->nb_pending_queries)
+        ngli_glGetIntegerv(gl, GL_GPU_DISJOINT_EXT, &disjoint);
+
+    while (ns->nb_pending_queries) {
+        const GLuint query = ns->queries[ns->query_read];
+
+        GLuint available = 0;
+        ngli_glGetQueryObjectuiv(gl, query, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            break;
+
+        GLuint64 elapsed = 0;
+        ngli_glGetQueryObjectui64v(gl, query, GL_QUERY_RESULT, &elapsed);
+        if (!disjoint)
+            ns->gpu_time = NGLI_MAX(ns->gpu_time, 0) + elapsed;
+
+        ns->query_read = (ns->query_read + 1) % NGLI_STATS_NB_QUERIES;
+        ns->nb_pending_queries--;
+    }
+}
+
+static GLuint begin_gpu_query(const struct glcontext *glcontext, struct node_stats *ns)
+{
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    if (!ns->queries[0])
+        ngli_glGenQueries(gl, NGLI_STATS_NB_QUERIES, ns->queries);
+
+    resolve_gpu_queries(glcontext, ns);
+
+    /* All the queries are still in flight, skip the GPU measure of this draw */
+    if (ns->nb_pending_queries == NGLI_STATS_NB_QUERIES)
+        return 0;
+
+    const int index = (ns->query_read + ns->nb_pending_queries) % NGLI_STATS_NB_QUERIES;
+    const GLuint query = ns->queries[index];
+    ngli_glBeginQuery(gl, GL_TIME_ELAPSED, query);
+    ns->nb_pending_queries++;
+    return query;
+}
+
+void ngli_stats_node_draw(struct ngl_node *node)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    struct stats *stats = &ctx->stats;
+    struct node_stats *ns = get_node_stats(node);
+    if (!ns) {
+        node->class->draw(node);
+        return;
+    }
+
+    struct glcontext *glcontext = ctx->glcontext;
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    /* GL_TIME_ELAPSED queries can not be nested */
+    GLuint query = 0;
+    if ((glcontext->features & NGLI_FEATURE_TIMER_QUERY) && !stats->gpu_timer_running &&
+        (node->class->id == NGL_NODE_RENDER || node->class->id == NGL_NODE_COMPUTE)) {
+        query = begin_gpu_query(glcontext, ns);
+        stats->gpu_timer_running = query != 0;
+    }
+
+    const int64_t parent_children_time = stats->children_time;
+    stats->children_time = 0;
+
+    const int64_t start = ngli_gettime();
+    node->class->draw(node);
+    const int64_t elapsed = ngli_gettime() - start;
+
+    ns->draw_time += elapsed;
+    ns->draw_self_time += elapsed - stats->children_time;
+    ns->nb_draws++;
+    stats->children_time = parent_children_time + elapsed;
+
+    if (query) {
+        ngli_glEndQuery(gl, GL_TIME_ELAPSED);
+        stats->gpu_timer_running = 0;
+    }
+}
+
+void ngli_stats_node_uninit(struct ngl_node *node)
+{
+    struct node_stats *ns = node->stats;
+    if (!ns)
+        return;
+
+    struct ngl_ctx *ctx = node->ctx;
+    if (ns->queries[0]) {
+        const struct glfunctions *gl = &ctx->glcontext->funcs;
+        ngli_glDeleteQueries(gl, NGLI_STATS_NB_QUERIES, ns->queries);
+    }
+
+    struct stats *stats = &ctx->stats;
+    for (int i = 0; i < stats->nb_nodes; i++) {
+        if (stats->nodes[i] == node) {
+            memmove(&stats->nodes[i], &stats->nodes[i + 1],
+                    (stats->nb_nodes - i - 1) * sizeof(*stats->nodes));
+            stats->nb_nodes--;
+            break;
+        }
+    }
+
+    free(node->stats);
+    node->stats = NULL;
+}
+
+int ngli_stats_get(struct stats *stats, struct ngl_stats *out)
+{
+    if (!stats->enabled) {
+        LOG(ERROR, "profiling is not enabled");
+        return -1;
+    }
+
+    if (stats->nb_nodes) {
+        struct ngl_node_stats *entries = realloc(stats->entries, stats->nb_nodes * sizeof(*entries));
+        if (!entries)
+            return -1;
+        stats->entries = entries;
+    }
+
+    for (int i = 0; i < stats->nb_nodes; i++) {
+        const struct ngl_node *node = stats->nodes[i];
+        const struct node_stats *ns = node->stats;
+        struct ngl_node_stats *entry = &stats->entries[i];
+
+        entry->name             = node->name;
+        entry->type             = node->class->id;
+        entry->update_time      = ns->update_time;
+        entry->update_self_time = ns->update_self_time;
+        entry->draw_time        = ns->draw_time;
+        entry->draw_self_time   = ns->draw_self_time;
+        entry->gpu_time         = ns->gpu_time;
+        entry->nb_updates       = ns->nb_updates;
+        entry->nb_draws         = ns->nb_draws;
+    }
+
+    out->frame_time    = stats->frame_time;
+    out->visit_time    = stats->stage_times[NGLI_STATS_STAGE_VISIT];
+    out->prefetch_time = stats->stage_times[NGLI_STATS_STAGE_PREFETCH];
+    out->update_time   = stats->stage_times[NGLI_STATS_STAGE_UPDATE];
+    out->draw_time     = stats->stage_times[NGLI_STATS_STAGE_DRAW];
+    out->nb_nodes      = stats->nb_nodes;
+    out->nodes         = stats->entries;
+    return 0;
+}
+
+void ngli_stats_reset(struct stats *stats)
+{
+    free(stats->nodes);
+    free(stats->entries);
+    memset(stats, 0, sizeof(*stats));
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright 2018 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdint.h>
+
+#include "glincludes.h"
+#include "nodegl.h"
+
+#define NGLI_STATS_NB_QUERIES 4
+
+struct ngl_ctx;
+struct ngl_node;
+
+enum {
+    NGLI_STATS_STAGE_VISIT,
+    NGLI_STATS_STAGE_PREFETCH,
+    NGLI_STATS_STAGE_UPDATE,
+    NGLI_STATS_STAGE_DRAW,
+    NGLI_STATS_NB_STAGES
+};
+
+/* Per node profiling state, allocated on the first profiled frame */
+struct node_stats {
+    int64_t frame_id;           // last frame in which the node was profiled
+    int64_t update_time;
+    int64_t update_self_time;
+    int64_t draw_time;
+    int64_t draw_self_time;
+    int64_t gpu_time;
+    int nb_updates;
+    int nb_draws;
+
+    GLuint queries[NGLI_STATS_NB_QUERIES];
+    int query_read;             // index of the oldest pending query
+    int nb_pending_queries;
+};
+
+/* Per context profiling state */
+struct stats {
+    int enabled;
+    int64_t frame_id;
+    int64_t frame_time;
+    int64_t stage_start;
+    int64_t stage_times[NGLI_STATS_NB_STAGES];
+    int64_t children_time;      // time accumulated by the children of the current node
+    int gpu_timer_running;
+
+    struct ngl_node **nodes;    // nodes profiled during the current frame
+    int nb_nodes;
+    int nodes_size;
+
+    struct ngl_node_stats *entries;
+};
+
+void ngli_stats_begin_frame(struct stats *stats);
+void ngli_stats_end_stage(struct stats *stats, int stage);
+int ngli_stats_node_update(struct ngl_node *node, double t);
+void ngli_stats_node_draw(struct ngl_node *node);
+void ngli_stats_node_uninit(struct ngl_node *node);
+int ngli_stats_get(struct stats *stats, struct ngl_stats *out);
+void ngli_stats_reset(struct stats *stats);
+
+#endif /* STATS_H */
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2018 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "nodegl.h"
+#include "nodes.h"
+#include "utils.h"
+
+static const float values[] = {1.f, 2.f, 3.f, 4.f};
+static float borrowed[] = {5.f, 6.f, 7.f, 8.f};
+
+static void release_borrowed(void *opaque)
+{
+    int *nb_released = opaque;
+    (*nb_released)++;
+}
+
+/* Borrow the user data into a buffer initialized with its own data */
+static void test_borrow(struct ngl_ctx *ctx, struct ngl_node *buffer)
+{
+    int nb_released = 0;
+    const struct buffer *s = buffer->priv_data;
+
+    ngli_assert(ngl_set_scene(ctx, buffer) == 0);
+    ngli_assert(ngli_node_init(buffer) == 0);
+    ngli_assert(!s->data && s->own_buf && s->data_ptr == s->own_buf);
+
+    ngli_assert(ngl_node_param_set_data(buffer, "data", (int)sizeof(borrowed), borrowed,
+                                        release_borrowed, &nb_released) == 0);
+    ngli_assert(!s->own_buf && s->data == (uint8_t *)borrowed);
+
+    /* The data can not be used along with a filename */
+    if (!s->filename) {
+        ngli_assert(ngli_node_init(buffer) == 0);
+        ngli_assert(s->data_ptr == (uint8_t *)borrowed);
+    }
+
+    ngli_assert(ngl_set_scene(ctx, NULL) == 0);
+    ngli_assert(nb_released == 0);
+    ngli_assert(ngl_node_param_set(buffer, "data", 0, NULL) == 0);
+    ngli_assert(nb_released == 1);
+}
+
+/*
+ * The data allocated by an initialized buffer (from its count or filename)
+ * must not be mistaken for the data parameter when the parameter is changed
+ */
+int main(void)
+{
+    struct ngl_ctx *ctx = ngl_create();
+    ngli_assert(ctx);
+
+    struct ngl_node *buffer = ngl_node_create(NGL_NODE_BUFFERFLOAT);
+    ngli_assert(buffer);
+    ngli_assert(ngl_node_param_set(buffer, "count", 4) == 0);
+    test_borrow(ctx, buffer);
+    ngl_node_unrefp(&buffer);
+
+    char filename[32];
+    snprintf(filename, sizeof(filename), "test_buffer_%d.bin", (int)getpid());
+    FILE *fp = fopen(filename, "wb");
+    ngli_assert(fp);
+    ngli_assert(fwrite(values, 1, sizeof(values), fp) == sizeof(values));
+    fclose(fp);
+    buffer = ngl_node_create(NGL_NODE_BUFFERFLOAT);
+    ngli_assert(buffer);
+    ngli_assert(ngl_node_param_set(buffer, "filename", filename) == 0);
+    test_borrow(ctx, buffer);
+    ngl_node_unrefp(&buffer);
+    unlink(filename);
+
+    buffer = ngl_node_create(NGL_NODE_BUFFERFLOAT);
+    ngli_assert(buffer);
+    ngli_assert(ngl_node_param_set(buffer, "count", 4) == 0);
+    ngli_assert(ngl_set_scene(ctx, buffer) == 0);
+
+    const struct buffer *s = buffer->priv_data;
+    ngli_assert(ngli_node_init(buffer) == 0);
+    ngli_assert(!s->data && s->data_ptr);
+
+    ngli_assert(ngl_node_param_set(buffer, "data", (int)sizeof(values), values) == 0);
+    ngli_assert(ngli_node_init(buffer) == 0);
+    ngli_assert(s->data_ptr == s->data && !memcmp(s->data_ptr, values, sizeof(values)));
+
+    ngli_assert(ngl_node_param_set(buffer, "data", 0, NULL) == 0);
+    ngli_assert(ngli_node_init(buffer) == 0);
+    ngli_assert(!s->data && s->data_ptr);
+
+    ngli_assert(ngl_queue_param_set(ctx, buffer, "data", (int)sizeof(values), values) == 0);
+    ngli_assert(ngli_updatequeue_apply(ctx) == 1);
+    ngli_assert(ngli_node_init(buffer) == 0);
+    ngli_assert(s->data_ptr == s->data && !memcmp(s->data_ptr, values, sizeof(values)));
+
+    ngl_node_unrefp(&buffer);
+    ngl_free(&ctx);
+    return 0;
+}
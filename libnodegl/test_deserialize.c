@@ -0,0 +1,207 @@
+/*
+ * Copyright 2018 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "nodegl.h"
+#include "utils.h"
+
+static struct ngl_node *create_scene(void)
+{
+    static const float data[] = {0.f, -1.5f, 3.25f, 1e10f, -0.f, 42.f};
+    static const float corner[] = {-1.f, -1.f, 0.f};
+
+    struct ngl_node *quad     = ngl_node_create(NGL_NODE_QUAD);
+    struct ngl_node *program  = ngl_node_create(NGL_NODE_PROGRAM);
+    struct ngl_node *texture  = ngl_node_create(NGL_NODE_TEXTURE2D);
+    struct ngl_node *kf0      = ngl_node_create(NGL_NODE_ANIMKEYFRAMEFLOAT, 0.0, 0.25);
+    struct ngl_node *kf1      = ngl_node_create(NGL_NODE_ANIMKEYFRAMEFLOAT, 2.5, -7.0);
+    struct ngl_node *anim     = ngl_node_create(NGL_NODE_ANIMATEDFLOAT);
+    struct ngl_node *uniform  = ngl_node_create(NGL_NODE_UNIFORMFLOAT);
+    struct ngl_node *buffer   = ngl_node_create(NGL_NODE_BUFFERFLOAT);
+    struct ngl_node *render   = ngl_node_create(NGL_NODE_RENDER, quad);
+    struct ngl_node *group    = ngl_node_create(NGL_NODE_GROUP);
+    ngli_assert(quad && program && texture && kf0 && kf1 && anim &&
+                uniform && buffer && render && group);
+
+    struct ngl_node *kfs[] = {kf0, kf1};
+    ngli_assert(ngl_node_param_set(quad, "corner", corner) == 0);
+    ngli_assert(ngl_node_param_set(program, "fragment", "void main() { /* 100% */ }\n") == 0);
+    ngli_assert(ngl_node_param_set(texture, "width", 16) == 0);
+    ngli_assert(ngl_node_param_set(texture, "min_filter", "linear_mipmap_linear") == 0);
+    ngli_assert(ngl_node_param_set(texture, "wrap_s", "repeat") == 0);
+    ngli_assert(ngl_node_param_set(kf1, "easing", "exp_in") == 0);
+    ngli_assert(ngl_node_param_add(anim, "keyframes", 2, kfs) == 0);
+    ngli_assert(ngl_node_param_set(uniform, "anim", anim) == 0);
+    ngli_assert(ngl_node_param_set(buffer, "data", (int)sizeof(data), data) == 0);
+    ngli_assert(ngl_node_param_set(render, "program", program) == 0);
+    ngli_assert(ngl_node_param_set(render, "textures", "tex0", texture) == 0);
+    ngli_assert(ngl_node_param_set(render, "uniforms", "time", uniform) == 0);
+    ngli_assert(ngl_node_param_set(render, "buffers", "values", buffer) == 0);
+    ngli_assert(ngl_node_param_set(render, "name", "a render with spaces") == 0);
+    ngli_assert(ngl_node_param_add(group, "children", 1, &render) == 0);
+    ngli_assert(ngl_node_param_add(group, "children", 1, &uniform) == 0);
+
+    ngl_node_unrefp(&quad);
+    ngl_node_unrefp(&program);
+    ngl_node_unrefp(&texture);
+    ngl_node_unrefp(&kf0);
+    ngl_node_unrefp(&kf1);
+    ngl_node_unrefp(&anim);
+    ngl_node_unrefp(&uniform);
+    ngl_node_unrefp(&buffer);
+    ngl_node_unrefp(&render);
+    return group;
+}
+
+/* Serialize the de-serialized graph, NULL if the de-serialization failed */
+static char *reserialize(struct ngl_node *node)
+{
+    if (!node)
+        return NULL;
+    char *s = ngl_node_serialize(node);
+    ngli_assert(s);
+    ngl_node_unrefp(&node);
+    return s;
+}
+
+struct chunk_reader {
+    const char *str;
+    size_t len;
+    int chunk_size;
+};
+
+static int read_chunk(void *opaque, char *buf, int size)
+{
+    struct chunk_reader *reader = opaque;
+    const int n = NGLI_MIN(NGLI_MIN(reader->len, size), reader->chunk_size);
+    memcpy(buf, reader->str, n);
+    reader->str += n;
+    reader->len -= n;
+    return n;
+}
+
+static struct ngl_node *deserialize_chunks(const char *str, size_t len, int chunk_size)
+{
+    struct chunk_reader reader = {.str = str, .len = len, .chunk_size = chunk_size};
+    return ngl_node_deserialize_cb(read_chunk, &reader);
+}
+
+static int read_error(void *opaque, char *buf, int size)
+{
+    return -1;
+}
+
+static void check_invalid(const char *str)
+{
+    ngli_assert(!ngl_node_deserialize(str));
+    ngli_assert(!deserialize_chunks(str, strlen(str), 3));
+}
+
+int main(void)
+{
+    struct ngl_node *scene = create_scene();
+    char *ref = ngl_node_serialize(scene);
+    ngli_assert(ref);
+    ngl_node_unrefp(&scene);
+
+    const size_t len = strlen(ref);
+    ngli_assert(len > 0 && ref[len - 1] == '\n');
+
+    /* Round trip */
+    char *s = reserialize(ngl_node_deserialize(ref));
+    ngli_assert(s && !strcmp(s, ref));
+    free(s);
+
+    /* Every chunk size, down to a single byte per read */
+    for (int chunk_size = 1; chunk_size <= len + 1; chunk_size++) {
+        s = reserialize(deserialize_chunks(ref, len, chunk_size));
+        ngli_assert(s && !strcmp(s, ref));
+        free(s);
+    }
+
+    /* Missing trailing newline */
+    char *nonl = ngli_strdup(ref);
+    ngli_assert(nonl);
+    nonl[len - 1] = 0;
+    s = reserialize(ngl_node_deserialize(nonl));
+    ngli_assert(s && !strcmp(s, ref));
+    free(s);
+    for (int chunk_size = 1; chunk_size <= len; chunk_size++) {
+        s = reserialize(deserialize_chunks(nonl, len - 1, chunk_size));
+        ngli_assert(s && !strcmp(s, ref));
+        free(s);
+    }
+    free(nonl);
+
+    /* Truncated input: a cut header is an error, any other cut must either
+     * fail or give back a graph which can be serialized again */
+    const size_t header_len = strcspn(ref, "\n");
+    for (size_t i = 0; i < len; i++) {
+        s = reserialize(deserialize_chunks(ref, i, 7));
+        if (i < header_len)
+            ngli_assert(!s);
+        free(s);
+    }
+
+    /* Truncated parameters */
+    char *cut = ngli_strdup(ref);
+    ngli_assert(cut);
+    char *data = strstr(cut, " data:");
+    ngli_assert(data);
+    data[strlen(" data:") + 4] = 0;
+    ngli_assert(!reserialize(ngl_node_deserialize(cut)));
+    free(cut);
+
+    /* Garbage */
+    check_invalid("");
+    check_invalid("\n\n");
+    check_invalid("garbage\n");
+    check_invalid("# Node.GL v0.0.0\nGrup\n");
+    check_invalid("# Node.GL v\n");
+    char hdr[64];
+    snprintf(hdr, sizeof(hdr), "# Node.GL v%d.%d.%d\n",
+             NODEGL_VERSION_MAJOR, NODEGL_VERSION_MINOR, NODEGL_VERSION_MICRO);
+    const char *bodies[] = {
+        "XXXX\n",
+        "Grp  children:5\n",
+        "Grp  children:z\n",
+        "Grp  nochild:0\n",
+        "Grp  children\n",
+        "Grp  name:foo bar\n",
+        "\xff\x01\x80\x7f garbage\n",
+        "Unf1 value:1\n",
+        "Bfv1 data:8,00\n",
+        "AKF1 0z0\n",
+        "AKF1 0z0 1z0trailing\n",
+    };
+    for (int i = 0; i < NGLI_ARRAY_NB(bodies); i++) {
+        char *str = ngli_asprintf("%s%s", hdr, bodies[i]);
+        ngli_assert(str);
+        check_invalid(str);
+        free(str);
+    }
+    ngli_assert(!ngl_node_deserialize_cb(read_error, NULL));
+
+    free(ref);
+    return 0;
+}
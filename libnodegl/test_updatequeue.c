@@ -0,0 +1,127 @@
+/*
+ * Copyright 2018 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <pthread.h>
+
+#include "nodegl.h"
+#include "nodes.h"
+#include "utils.h"
+
+#define NB_THREADS 4
+#define NB_WRITES  1000
+
+struct writer {
+    struct ngl_ctx *ctx;
+    struct ngl_node *uniforms[2];
+    int id;
+};
+
+static double get_value(int id, int i)
+{
+    return id * NB_WRITES + i;
+}
+
+static void *write_values(void *arg)
+{
+    const struct writer *w = arg;
+    for (int i = 0; i < NB_WRITES; i++)
+        for (int j = 0; j < NGLI_ARRAY_NB(w->uniforms); j++)
+            ngli_assert(ngl_queue_param_set(w->ctx, w->uniforms[j], "value", get_value(w->id, i)) == 0);
+    return NULL;
+}
+
+static double get_scalar(const struct ngl_node *uniform)
+{
+    const struct uniform *s = uniform->priv_data;
+    return s->scalar;
+}
+
+/* The last write in time is the last write of one of the threads */
+static int is_last_write(double v)
+{
+    for (int id = 0; id < NB_THREADS; id++)
+        if (v == get_value(id, NB_WRITES - 1))
+            return 1;
+    return 0;
+}
+
+int main(void)
+{
+    struct ngl_ctx *ctx = ngl_create();
+    ngli_assert(ctx);
+
+    struct ngl_node *uniform0 = ngl_node_create(NGL_NODE_UNIFORMFLOAT);
+    struct ngl_node *uniform1 = ngl_node_create(NGL_NODE_UNIFORMFLOAT);
+    struct ngl_node *group = ngl_node_create(NGL_NODE_GROUP);
+    ngli_assert(uniform0 && uniform1 && group);
+    struct ngl_node *children[] = {uniform0, uniform1};
+    ngli_assert(ngl_node_param_add(group, "children", NGLI_ARRAY_NB(children), children) == 0);
+    ngli_assert(ngl_set_scene(ctx, group) == 0);
+
+    /* Concurrent writes to the same parameters are coalesced */
+    pthread_t threads[NB_THREADS];
+    struct writer writers[NB_THREADS];
+    for (int i = 0; i < NB_THREADS; i++) {
+        writers[i] = (struct writer){.ctx = ctx, .uniforms = {uniform0, uniform1}, .id = i};
+        ngli_assert(pthread_create(&threads[i], NULL, write_values, &writers[i]) == 0);
+    }
+    for (int i = 0; i < NB_THREADS; i++)
+        pthread_join(threads[i], NULL);
+    ngli_assert(ngli_updatequeue_apply(ctx) == 2);
+    ngli_assert(is_last_write(get_scalar(uniform0)));
+    ngli_assert(is_last_write(get_scalar(uniform1)));
+    ngli_assert(ngli_updatequeue_apply(ctx) == 0);
+
+    /* The last write wins */
+    for (int i = 0; i < 3; i++)
+        ngli_assert(ngl_queue_param_set(ctx, uniform0, "value", (double)i) == 0);
+    ngli_assert(ngli_updatequeue_apply(ctx) == 1);
+    ngli_assert(get_scalar(uniform0) == 2.);
+
+    /* Invalid updates are rejected when queued */
+    ngli_assert(ngl_queue_param_set(ctx, uniform0, "nokey", 1.) < 0);
+    ngli_assert(ngl_queue_param_set(ctx, group, "children", uniform0) < 0);
+    ngli_assert(ngl_queue_param_add(ctx, uniform0, "value", 1, children) < 0);
+    ngli_assert(ngli_updatequeue_apply(ctx) == 0);
+
+    /* Untracking a node drops its pending updates */
+    ngli_assert(ngl_queue_param_set(ctx, uniform0, "value", 10.) == 0);
+    ngli_assert(ngl_queue_param_set(ctx, uniform1, "value", 11.) == 0);
+    ngli_updatequeue_untrack(&ctx->updatequeue, uniform0);
+    ngli_assert(ngli_updatequeue_apply(ctx) == 1);
+    ngli_assert(get_scalar(uniform0) == 2.);
+    ngli_assert(get_scalar(uniform1) == 11.);
+    ngli_assert(ngli_updatequeue_track(&ctx->updatequeue, uniform0) == 0);
+
+    /* Including when the node is attached again before they are applied */
+    ngli_assert(ngl_set_scene(ctx, uniform1) == 0);
+    ngli_assert(ngl_queue_param_set(ctx, uniform0, "value", 20.) == 0);
+    ngli_assert(ngl_set_scene(ctx, group) == 0);
+    ngli_assert(ngli_updatequeue_apply(ctx) == 0);
+    ngli_assert(get_scalar(uniform0) == 2.);
+
+    ngli_assert(ngl_set_scene(ctx, NULL) == 0);
+    ngl_node_unrefp(&uniform0);
+    ngl_node_unrefp(&uniform1);
+    ngl_node_unrefp(&group);
+    ngl_free(&ctx);
+    return 0;
+}
@@ -0,0 +1,199 @@
+/*
+ * Copyright 2018 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "log.h"
+#include "threadpool.h"
+#include "utils.h"
+
+struct threadpool {
+    pthread_mutex_t lock;
+    pthread_cond_t work_cond;
+    pthread_cond_t done_cond;
+    pthread_t *threads;
+    int nb_threads;
+
+    /* Current batch, protected by the lock */
+    ngli_threadpool_func func;
+    void *arg;
+    int nb_jobs;
+    int next_job;
+    int chunk_size;
+    int nb_running;
+    int error;
+    int64_t batch;
+    int stop;
+};
+
+/*
+ * The jobs are handed out by chunks from a shared counter: a thread running
+ * out of work keeps taking chunks from the remaining ones, which balances
+ * the load between the threads. Must be called with the lock held.
+ */
+static void run_jobs(struct threadpool *tp)
+{
+    while (tp->next_job < tp->nb_jobs) {
+        const int start = tp->next_job;
+        const int end = NGLI_MIN(start + tp->chunk_size, tp->nb_jobs);
+        tp->next_job = end;
+
+        pthread_mutex_unlock(&tp->lock);
+        const int ret = tp->func(tp->arg, start, end);
+        pthread_mutex_lock(&tp->lock);
+
+        if (ret < 0 && !tp->error) {
+            tp->error = ret;
+            tp->next_job = tp->nb_jobs;
+        }
+    }
+}
+
+static void *worker_thread(void *arg)
+{
+    struct threadpool *tp = arg;
+    int64_t batch = 0;
+
+    pthread_mutex_lock(&tp->lock);
+    for (;;) {
+        while (!tp->stop && tp->batch == batch)
+            pthread_cond_wait(&tp->work_cond, &tp->lock);
+        if (tp->stop)
+            break;
+        batch = tp->batch;
+
+        run_jobs(tp);
+
+        if (--tp->nb_running == 0)
+            pthread_cond_signal(&tp->done_cond);
+    }
+    pthread_mutex_unlock(&tp->lock);
+    return NULL;
+}
+
+int ngli_get_nb_cpus(void)
+{
+#ifdef _SC_NPROCESSORS_ONLN
+    const long nb_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (nb_cpus > 0)
+        return (int)nb_cpus;
+#endif
+    return 1;
+}
+
+struct threadpool *ngli_threadpool_create(int nb_threads)
+{
+    struct threadpool *tp = calloc(1, sizeof(*tp));
+    if (!tp)
+        return NULL;
+
+    if (pthread_mutex_init(&tp->lock, NULL)) {
+        free(tp);
+        return NULL;
+    }
+    if (pthread_cond_init(&tp->work_cond, NULL)) {
+        pthread_mutex_destroy(&tp->lock);
+        free(tp);
+        return NULL;
+    }
+    if (pthread_cond_init(&tp->done_cond, NULL)) {
+        pthread_cond_destroy(&tp->work_cond);
+        pthread_mutex_destroy(&tp->lock);
+        free(tp);
+        return NULL;
+    }
+
+    tp->threads = calloc(nb_threads, sizeof(*tp->threads));
+    if (!tp->threads) {
+        ngli_threadpool_freep(&tp);
+        return NULL;
+    }
+
+    for (int i = 0; i < nb_threads; i++) {
+        if (pthread_create(&tp->threads[i], NULL, worker_thread, tp)) {
+            LOG(ERROR, "unable to create thread %d/%d", i + 1, nb_threads);
+            ngli_threadpool_freep(&tp);
+            return NULL;
+        }
+        tp->nb_threads++;
+    }
+
+    LOG(DEBUG, "thread pool created with %d threads", nb_threads);
+    return tp;
+}
+
+int ngli_threadpool_get_nb_threads(const struct threadpool *tp)
+{
+    return tp->nb_threads;
+}
+
+int ngli_threadpool_run(struct threadpool *tp, ngli_threadpool_func func, void *arg, int nb_jobs)
+{
+    if (nb_jobs <= 0)
+        return 0;
+
+    pthread_mutex_lock(&tp->lock);
+
+    tp->func       = func;
+    tp->arg        = arg;
+    tp->nb_jobs    = nb_jobs;
+    tp->next_job   = 0;
+    tp->chunk_size = NGLI_MAX(nb_jobs / ((tp->nb_threads + 1) * 4), 1);
+    tp->nb_running = tp->nb_threads;
+    tp->error      = 0;
+    tp->batch++;
+    pthread_cond_broadcast(&tp->work_cond);
+
+    /* The calling thread takes its share of the jobs as well */
+    run_jobs(tp);
+
+    while (tp->nb_running)
+        pthread_cond_wait(&tp->done_cond, &tp->lock);
+    const int ret = tp->error;
+
+    pthread_mutex_unlock(&tp->lock);
+    return ret;
+}
+
+void ngli_threadpool_freep(struct threadpool **tpp)
+{
+    struct threadpool *tp = *tpp;
+    if (!tp)
+        return;
+
+    pthread_mutex_lock(&tp->lock);
+    tp->stop = 1;
+    pthread_cond_broadcast(&tp->work_cond);
+    pthread_mutex_unlock(&tp->lock);
+
+    for (int i = 0; i < tp->nb_threads; i++)
+        pthread_join(tp->threads[i], NULL);
+    free(tp->threads);
+
+    pthread_cond_destroy(&tp->done_cond);
+    pthread_cond_destroy(&tp->work_cond);
+    pthread_mutex_destroy(&tp->lock);
+    free(tp);
+    *tpp = NULL;
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright 2018 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+/*
+ * Job function: process the jobs in [start, end) and return < 0 on error.
+ * It is called concurrently from the pool threads and the calling thread.
+ */
+typedef int (*ngli_threadpool_func)(void *arg, int start, int end);
+
+struct threadpool;
+
+struct threadpool *ngli_threadpool_create(int nb_threads);
+int ngli_threadpool_get_nb_threads(const struct threadpool *tp);
+int ngli_threadpool_run(struct threadpool *tp, ngli_threadpool_func func, void *arg, int nb_jobs);
+void ngli_threadpool_freep(struct threadpool **tpp);
+
+int ngli_get_nb_cpus(void);
+
+#endif /* THREADPOOL_H */
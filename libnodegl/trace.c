@@ -0,0 +1,254 @@
+/*
+ * Copyright 2018 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "log.h"
+#include "nodegl.h"
+#include "trace.h"
+#include "utils.h"
+
+#ifdef CONFIG_TRACE
+#include <pthread.h>
+#include <sched.h>
+
+#define TRACE_RING_SIZE (1 << 16)
+#define TRACE_NAME_MAX  48
+
+#define LOAD(x)     __atomic_load_n(&(x), __ATOMIC_SEQ_CST)
+#define STORE(x, v) __atomic_store_n(&(x), v, __ATOMIC_SEQ_CST)
+
+struct trace_event {
+    int64_t ts;
+    const char *category;
+    char phase;
+    char name[TRACE_NAME_MAX];
+};
+
+/*
+ * Every thread records its events into its own ring without any lock: only
+ * the owner thread writes the events and publishes them by incrementing the
+ * count. The start and the dump of the trace disable the recording and then
+ * wait for the events being written (flagged by writing) to be published,
+ * after which the rings are not touched by their owners anymore. The oldest
+ * events are overwritten when the ring is full.
+ */
+struct trace_ring {
+    int tid;
+    int writing;            // set by the owner while it records an event
+    int exited;             // owner thread exited, the ring is freed after the next dump or start
+    unsigned generation;    // trace session of the recorded events
+    int64_t start_time;
+    uint64_t count;         // total number of events recorded
+    struct trace_event events[TRACE_RING_SIZE];
+    struct trace_ring *next;
+};
+
+static struct {
+    pthread_mutex_t lock; // protects the ring list and serializes the start and dump
+    pthread_once_t key_once;
+    pthread_key_t key;
+    struct trace_ring *rings;
+    int nb_rings;
+    int enabled;
+    unsigned generation;
+    int64_t start_time;
+} trace = {
+    .lock     = PTHREAD_MUTEX_INITIALIZER,
+    .key_once = PTHREAD_ONCE_INIT,
+};
+
+static void release_ring(void *arg)
+{
+    struct trace_ring *ring = arg;
+    pthread_mutex_lock(&trace.lock);
+    ring->exited = 1;
+    pthread_mutex_unlock(&trace.lock);
+}
+
+static void create_key(void)
+{
+    pthread_key_create(&trace.key, release_ring);
+}
+
+/* Must be called with the trace lock held, once the recording is quiesced */
+static void free_exited_rings(void)
+{
+    struct trace_ring **ringp = &trace.rings;
+    while (*ringp) {
+        struct trace_ring *ring = *ringp;
+        if (ring->exited) {
+            *ringp = ring->next;
+            free(ring);
+        } else {
+            ringp = &ring->next;
+        }
+    }
+}
+
+/* Disable the recording and wait for the events being written */
+static void quiesce_rings(void)
+{
+    STORE(trace.enabled, 0);
+    for (struct trace_ring *ring = trace.rings; ring; ring = ring->next)
+        while (LOAD(ring->writing))
+            sched_yield();
+}
+
+/* Only called while tracing is enabled, so no ring exists otherwise */
+static struct trace_ring *get_thread_ring(void)
+{
+    pthread_once(&trace.key_once, create_key);
+
+    struct trace_ring *ring = pthread_getspecific(trace.key);
+    if (ring)
+        return ring;
+
+    ring = calloc(1, sizeof(*ring));
+    if (!ring)
+        return NULL;
+
+    pthread_mutex_lock(&trace.lock);
+    ring->tid = trace.nb_rings++;
+    ring->next = trace.rings;
+    trace.rings = ring;
+    pthread_mutex_unlock(&trace.lock);
+
+    pthread_setspecific(trace.key, ring);
+    return ring;
+}
+
+void ngli_trace_event(char phase, const char *category, const char *name)
+{
+    if (!LOAD(trace.enabled))
+        return;
+
+    struct trace_ring *ring = get_thread_ring();
+    if (!ring)
+        return;
+
+    /* Flag the write before checking the state, see quiesce_rings() */
+    STORE(ring->writing, 1);
+    if (LOAD(trace.enabled)) {
+        const unsigned generation = LOAD(trace.generation);
+        if (ring->generation != generation) {
+            ring->generation = generation;
+            ring->start_time = LOAD(trace.start_time);
+            ring->count = 0;
+        }
+        const uint64_t count = ring->count;
+        struct trace_event *event = &ring->events[count & (TRACE_RING_SIZE - 1)];
+        event->ts = ngli_gettime() - ring->start_time;
+        event->category = category;
+        event->phase = phase;
+        snprintf(event->name, sizeof(event->name), "%s", name ? name : "");
+        STORE(ring->count, count + 1);
+    }
+    STORE(ring->writing, 0);
+}
+
+static void print_json_escaped(FILE *fp, const char *s)
+{
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\')
+            fprintf(fp, "\\%c", *s);
+        else if ((unsigned char)*s < 0x20)
+            fprintf(fp, "\\u%04x", *s);
+        else
+            fputc(*s, fp);
+    }
+}
+
+int ngl_trace_start(void)
+{
+    pthread_mutex_lock(&trace.lock);
+    quiesce_rings();
+    free_exited_rings();
+    STORE(trace.start_time, ngli_gettime());
+    STORE(trace.generation, trace.generation + 1);
+    STORE(trace.enabled, 1);
+    pthread_mutex_unlock(&trace.lock);
+    return 0;
+}
+
+int ngl_trace_dump(const char *filename)
+{
+    FILE *fp = fopen(filename, "w");
+    if (!fp) {
+        LOG(ERROR, "unable to open %s", filename);
+        return -1;
+    }
+
+    pthread_mutex_lock(&trace.lock);
+    quiesce_rings();
+
+    int first = 1;
+    fprintf(fp, "{\"traceEvents\":[");
+    for (struct trace_ring *ring = trace.rings; ring; ring = ring->next) {
+        /* Rings without event since the start of the trace */
+        if (ring->generation != trace.generation)
+            continue;
+
+        const uint64_t count = LOAD(ring->count);
+        const uint64_t start = count > TRACE_RING_SIZE ? count - TRACE_RING_SIZE : 0;
+        if (start)
+            LOG(WARNING, "trace ring of thread %d overflowed, %" PRIu64 " events lost",
+                ring->tid, start);
+        for (uint64_t i = start; i < count; i++) {
+            const struct trace_event *event = &ring->events[i & (TRACE_RING_SIZE - 1)];
+            fprintf(fp, "%s\n{\"name\":\"%s ", first ? "" : ",", event->category);
+            print_json_escaped(fp, event->name);
+            fprintf(fp, "\",\"cat\":\"%s\",\"ph\":\"%c\",\"ts\":%" PRId64 ",\"pid\":1,\"tid\":%d}",
+                    event->category, event->phase, event->ts, ring->tid);
+            first = 0;
+        }
+    }
+    fprintf(fp, "\n]}\n");
+    free_exited_rings();
+    pthread_mutex_unlock(&trace.lock);
+
+    int ret = ferror(fp) ? -1 : 0;
+    if (fclose(fp) || ret < 0) {
+        LOG(ERROR, "unable to write trace to %s", filename);
+        return -1;
+    }
+    return 0;
+}
+
+#else
+
+int ngl_trace_start(void)
+{
+    LOG(ERROR, "node.gl was built without tracing support");
+    return -1;
+}
+
+int ngl_trace_dump(const char *filename)
+{
+    LOG(ERROR, "node.gl was built without tracing support");
+    return -1;
+}
+
+#endif
@@ -0,0 +1,42 @@
+/*
+ * Copyright 2018 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+/*
+ * Trace events are only recorded when the library is built with TRACE=yes;
+ * otherwise the macros compile to nothing.
+ *
+ * The category must be a static string. The name is copied into the event
+ * (and truncated if needed) since it typically points to a node name which
+ * may not outlive the trace.
+ */
+#ifdef CONFIG_TRACE
+void ngli_trace_event(char phase, const char *category, const char *name);
+# define TRACE_BEGIN(category, name) ngli_trace_event('B', category, name)
+# define TRACE_END(category, name)   ngli_trace_event('E', category, name)
+#else
+# define TRACE_BEGIN(category, name) do { } while (0)
+# define TRACE_END(category, name)   do { } while (0)
+#endif
+
+#endif /* TRACE_H */
@@ -0,0 +1,154 @@
+/*
+ * Copyright 2018 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "glcontext.h"
+#include "log.h"
+#include "nodes.h"
+#include "transient.h"
+#include "utils.h"
+
+struct transient *ngli_transient_acquire(struct ngl_ctx *ctx, GLenum format,
+                                         int width, int height, int samples,
+                                         int64_t pixel_size)
+{
+    const struct glpool_key key = {
+        .type            = NGLI_GLPOOL_RENDERBUFFER,
+        .target          = GL_RENDERBUFFER,
+        .internal_format = format,
+        .width           = width,
+        .height          = height,
+        .samples         = samples,
+    };
+
+    for (int i = 0; i < ctx->nb_transients; i++) {
+        struct transient *s = ctx->transients[i];
+        if (!memcmp(&s->key, &key, sizeof(key))) {
+            s->refcount++;
+            return s;
+        }
+    }
+
+    struct transient **transients = realloc(ctx->transients, (ctx->nb_transients + 1) * sizeof(*transients));
+    if (!transients)
+        return NULL;
+    ctx->transients = transients;
+
+    struct transient *s = calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+    s->key = key;
+    s->pixel_size = pixel_size;
+    s->refcount = 1;
+
+    ctx->transients[ctx->nb_transients++] = s;
+    return s;
+}
+
+static GLuint create_renderbuffer(struct ngl_ctx *ctx, const struct transient *s, int64_t *sizep)
+{
+    const struct glfunctions *gl = &ctx->glcontext->funcs;
+    const struct glpool_key *key = &s->key;
+
+    GLuint id = ngli_glpool_acquire(ctx, key, sizep);
+    if (id)
+        return id;
+
+    ngli_glGenRenderbuffers(gl, 1, &id);
+    ngli_glBindRenderbuffer(gl, GL_RENDERBUFFER, id);
+    if (key->samples > 0)
+        ngli_glRenderbufferStorageMultisample(gl, GL_RENDERBUFFER, key->samples, key->internal_format,
+                                              key->width, key->height);
+    else
+        ngli_glRenderbufferStorage(gl, GL_RENDERBUFFER, key->internal_format, key->width, key->height);
+    ngli_glBindRenderbuffer(gl, GL_RENDERBUFFER, 0);
+
+    *sizep = s->pixel_size * key->width * key->height * NGLI_MAX(key->samples, 1);
+    ngli_gpumem_alloc(&ctx->gpumem, NGLI_GPUMEM_RENDERBUFFER, *sizep);
+    return id;
+}
+
+GLuint ngli_transient_get(struct ngl_ctx *ctx, struct transient *s, int level)
+{
+    if (level >= s->nb_ids) {
+        const int nb_ids = level + 1;
+        GLuint *ids = realloc(s->ids, nb_ids * sizeof(*ids));
+        if (!ids)
+            return 0;
+        s->ids = ids;
+        int64_t *sizes = realloc(s->sizes, nb_ids * sizeof(*sizes));
+        if (!sizes)
+            return 0;
+        s->sizes = sizes;
+        for (int i = s->nb_ids; i < nb_ids; i++) {
+            s->ids[i] = 0;
+            s->sizes[i] = 0;
+        }
+        s->nb_ids = nb_ids;
+    }
+
+    if (!s->ids[level])
+        s->ids[level] = create_renderbuffer(ctx, s, &s->sizes[level]);
+    return s->ids[level];
+}
+
+static void transient_free(struct ngl_ctx *ctx, struct transient *s)
+{
+    for (int i = 0; i < s->nb_ids; i++)
+        ngli_glpool_release(ctx, &s->key, s->ids[i], s->sizes[i]);
+    free(s->ids);
+    free(s->sizes);
+    free(s);
+}
+
+void ngli_transient_release(struct ngl_ctx *ctx, struct transient **sp)
+{
+    struct transient *s = *sp;
+    if (!s)
+        return;
+    *sp = NULL;
+
+    if (--s->refcount)
+        return;
+
+    for (int i = 0; i < ctx->nb_transients; i++) {
+        if (ctx->transients[i] == s) {
+            memmove(&ctx->transients[i], &ctx->transients[i + 1],
+                    (ctx->nb_transients - i - 1) * sizeof(*ctx->transients));
+            ctx->nb_transients--;
+            break;
+        }
+    }
+    transient_free(ctx, s);
+}
+
+void ngli_transient_reset(struct ngl_ctx *ctx)
+{
+    if (ctx->nb_transients)
+        LOG(WARNING, "%d transient renderbuffers still referenced", ctx->nb_transients);
+    for (int i = 0; i < ctx->nb_transients; i++)
+        transient_free(ctx, ctx->transients[i]);
+    free(ctx->transients);
+    ctx->transients = NULL;
+    ctx->nb_transients = 0;
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright 2018 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef TRANSIENT_H
+#define TRANSIENT_H
+
+#include <stdint.h>
+
+#include "glincludes.h"
+#include "glpool.h"
+
+struct ngl_ctx;
+
+/*
+ * Renderbuffer whose content does not outlive the draw of a RenderToTexture
+ * node (depth and multisample attachments). The RenderToTexture nodes
+ * sharing the same storage characteristics alias the same renderbuffers:
+ * only RenderToTexture draws nested in each other overlap within a frame,
+ * so one renderbuffer per nesting level is allocated.
+ */
+struct transient {
+    struct glpool_key key;
+    int64_t pixel_size;
+    int refcount;
+    GLuint *ids;        // renderbuffer per nesting level, allocated on first use
+    int64_t *sizes;
+    int nb_ids;
+};
+
+struct transient *ngli_transient_acquire(struct ngl_ctx *ctx, GLenum format,
+                                         int width, int height, int samples,
+                                         int64_t pixel_size);
+GLuint ngli_transient_get(struct ngl_ctx *ctx, struct transient *s, int level);
+void ngli_transient_release(struct ngl_ctx *ctx, struct transient **sp);
+void ngli_transient_reset(struct ngl_ctx *ctx);
+
+#endif /* TRANSIENT_H */
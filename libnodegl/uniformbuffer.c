@@ -0,0 +1,261 @@
+/*
+ * Copyright 2018 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "glcontext.h"
+#include "log.h"
+#include "nodegl.h"
+#include "nodes.h"
+#include "uniformbuffer.h"
+#include "utils.h"
+
+static int write_field(uint8_t *dst, const void *src, int size)
+{
+    if (!memcmp(dst, src, size))
+        return 0;
+    memcpy(dst, src, size);
+    return 1;
+}
+
+static int write_matrix(uint8_t *dst, const float *matrix, int matrix_stride)
+{
+    int dirty = 0;
+    for (int i = 0; i < 4; i++)
+        dirty |= write_field(dst + i * matrix_stride, matrix + i * 4, 4 * sizeof(*matrix));
+    return dirty;
+}
+
+static int pack_field(uint8_t *data, const struct uniformbuffer_field *field)
+{
+    uint8_t *dst = data + field->offset;
+    const struct ngl_node *unode = field->node;
+
+    switch (unode->class->id) {
+    case NGL_NODE_UNIFORMFLOAT: {
+        const struct uniform *u = unode->priv_data;
+        const float scalar = u->scalar;
+        return write_field(dst, &scalar, sizeof(scalar));
+    }
+    case NGL_NODE_UNIFORMVEC2: {
+        const struct uniform *u = unode->priv_data;
+        return write_field(dst, u->vector, 2 * sizeof(*u->vector));
+    }
+    case NGL_NODE_UNIFORMVEC3: {
+        const struct uniform *u = unode->priv_data;
+        return write_field(dst, u->vector, 3 * sizeof(*u->vector));
+    }
+    case NGL_NODE_UNIFORMVEC4: {
+        const struct uniform *u = unode->priv_data;
+        return write_field(dst, u->vector, 4 * sizeof(*u->vector));
+    }
+    case NGL_NODE_UNIFORMINT: {
+        const struct uniform *u = unode->priv_data;
+        const GLint ival = u->ival;
+        return write_field(dst, &ival, sizeof(ival));
+    }
+    case NGL_NODE_UNIFORMQUAT: {
+        const struct uniform *u = unode->priv_data;
+        if (field->type == GL_FLOAT_MAT4)
+            return write_matrix(dst, u->matrix, field->matrix_stride);
+        return write_field(dst, u->vector, 4 * sizeof(*u->vector));
+    }
+    case NGL_NODE_UNIFORMMAT4: {
+        const struct uniform *u = unode->priv_data;
+        return write_matrix(dst, u->matrix, field->matrix_stride);
+    }
+    case NGL_NODE_BUFFERFLOAT:
+    case NGL_NODE_BUFFERVEC2:
+    case NGL_NODE_BUFFERVEC3:
+    case NGL_NODE_BUFFERVEC4: {
+        const struct buffer *buffer = unode->priv_data;
+        const int count = NGLI_MIN(buffer->count, field->size);
+        const int size = buffer->data_comp * sizeof(GLfloat);
+        int dirty = 0;
+        for (int i = 0; i < count; i++)
+            dirty |= write_field(dst + i * field->array_stride,
+                                 buffer->data_ptr + i * buffer->data_stride, size);
+        return dirty;
+    }
+    }
+
+    return 0;
+}
+
+static int pack_fields(struct uniformbuffer *s)
+{
+    int dirty = 0;
+    for (int i = 0; i < s->nb_fields; i++)
+        dirty |= pack_field(s->data, &s->fields[i]);
+    return dirty;
+}
+
+static int init_blocks(struct uniformbuffer *s, struct glcontext *glcontext,
+                       GLuint program_id, int nb_blocks)
+{
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    if (nb_blocks > glcontext->max_uniform_buffer_bindings) {
+        LOG(ERROR, "uniform blocks count (%d) exceeds driver limit (%d)",
+            nb_blocks, glcontext->max_uniform_buffer_bindings);
+        return -1;
+    }
+
+    s->blocks = calloc(nb_blocks, sizeof(*s->blocks));
+    if (!s->blocks)
+        return -1;
+
+    const int align = NGLI_MAX(glcontext->uniform_buffer_offset_alignment, 1);
+    for (int i = 0; i < nb_blocks; i++) {
+        struct uniformbuffer_block *block = &s->blocks[i];
+        GLint size = 0;
+
+        ngli_glGetActiveUniformBlockiv(gl, program_id, i, GL_UNIFORM_BLOCK_DATA_SIZE, &size);
+        ngli_glUniformBlockBinding(gl, program_id, i, i);
+
+        block->binding = i;
+        block->offset = s->data_size;
+        block->size = size;
+        s->data_size += (size + align - 1) / align * align;
+    }
+    s->nb_blocks = nb_blocks;
+
+    return 0;
+}
+
+static int init_fields(struct uniformbuffer *s, const struct glfunctions *gl,
+                       GLuint program_id, struct hmap *uniforms)
+{
+    GLint nb_active_uniforms = 0;
+    ngli_glGetProgramiv(gl, program_id, GL_ACTIVE_UNIFORMS, &nb_active_uniforms);
+    if (!uniforms || nb_active_uniforms <= 0)
+        return 0;
+
+    s->fields = calloc(nb_active_uniforms, sizeof(*s->fields));
+    if (!s->fields)
+        return -1;
+
+    for (GLuint i = 0; i < (GLuint)nb_active_uniforms; i++) {
+        GLint block_index = -1;
+        ngli_glGetActiveUniformsiv(gl, program_id, 1, &i, GL_UNIFORM_BLOCK_INDEX, &block_index);
+        if (block_index < 0 || block_index >= s->nb_blocks)
+            continue;
+
+        struct uniformbuffer_field *field = &s->fields[s->nb_fields];
+        char name[64];
+        ngli_glGetActiveUniform(gl, program_id, i, sizeof(name), NULL,
+                                &field->size, &field->type, name);
+
+        /* Remove [0] suffix from names of uniform arrays and the block
+         * instance name prefix */
+        name[strcspn(name, "[")] = 0;
+        const char *key = strrchr(name, '.');
+        key = key ? key + 1 : name;
+
+        struct ngl_node *unode = ngli_hmap_get(uniforms, key);
+        if (!unode)
+            continue;
+
+        int ret = ngli_node_init(unode);
+        if (ret < 0)
+            return ret;
+
+        GLint offset = 0;
+        ngli_glGetActiveUniformsiv(gl, program_id, 1, &i, GL_UNIFORM_OFFSET, &offset);
+        ngli_glGetActiveUniformsiv(gl, program_id, 1, &i, GL_UNIFORM_ARRAY_STRIDE, &field->array_stride);
+        ngli_glGetActiveUniformsiv(gl, program_id, 1, &i, GL_UNIFORM_MATRIX_STRIDE, &field->matrix_stride);
+
+        field->node = unode;
+        field->offset = s->blocks[block_index].offset + offset;
+        s->nb_fields++;
+    }
+
+    return 0;
+}
+
+int ngli_uniformbuffer_init(struct uniformbuffer *s, struct ngl_ctx *ctx,
+                            GLuint program_id, struct hmap *uniforms)
+{
+    struct glcontext *glcontext = ctx->glcontext;
+    const struct glfunctions *gl = &glcontext->funcs;
+
+    if (!(glcontext->features & NGLI_FEATURE_UNIFORM_BUFFER_OBJECT))
+        return 0;
+
+    GLint nb_blocks = 0;
+    ngli_glGetProgramiv(gl, program_id, GL_ACTIVE_UNIFORM_BLOCKS, &nb_blocks);
+    if (nb_blocks <= 0)
+        return 0;
+
+    int ret = init_blocks(s, glcontext, program_id, nb_blocks);
+    if (ret < 0)
+        return ret;
+
+    ret = init_fields(s, gl, program_id, uniforms);
+    if (ret < 0)
+        return ret;
+
+    s->data = calloc(1, s->data_size);
+    if (!s->data)
+        return -1;
+
+    pack_fields(s);
+
+    return ngli_bufstream_init(&s->stream, ctx, GL_UNIFORM_BUFFER,
+                               s->data, s->data_size, GL_DYNAMIC_DRAW);
+}
+
+/*
+ * The blocks are only written when a field changed. Until then, they remain
+ * in the region of the stream they were last written to, and the stream does
+ * not overwrite that region before the GPU is done reading it.
+ */
+void ngli_uniformbuffer_update(struct uniformbuffer *s)
+{
+    if (!s->nb_blocks)
+        return;
+
+    if (pack_fields(s))
+        ngli_bufstream_write(&s->stream, s->data);
+}
+
+void ngli_uniformbuffer_bind(struct uniformbuffer *s)
+{
+    if (!s->nb_blocks)
+        return;
+
+    const struct glfunctions *gl = &s->stream.ctx->glcontext->funcs;
+    for (int i = 0; i < s->nb_blocks; i++) {
+        const struct uniformbuffer_block *block = &s->blocks[i];
+        ngli_glBindBufferRange(gl, GL_UNIFORM_BUFFER, block->binding, s->stream.buffer_id,
+                               s->stream.offset + block->offset, block->size);
+    }
+}
+
+void ngli_uniformbuffer_reset(struct uniformbuffer *s)
+{
+    ngli_bufstream_reset(&s->stream);
+    free(s->fields);
+    free(s->blocks);
+    free(s->data);
+    memset(s, 0, sizeof(*s));
+}
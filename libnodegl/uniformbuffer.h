@@ -0,0 +1,69 @@
+/*
+ * Copyright 2018 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef UNIFORMBUFFER_H
+#define UNIFORMBUFFER_H
+
+#include <stdint.h>
+
+#include "bufstream.h"
+#include "glincludes.h"
+#include "hmap.h"
+
+struct ngl_ctx;
+struct ngl_node;
+
+struct uniformbuffer_field {
+    struct ngl_node *node;
+    GLenum type;
+    int size;           // number of array elements declared in the shader
+    int offset;         // offset of the field in the uniform buffer
+    int array_stride;
+    int matrix_stride;
+};
+
+struct uniformbuffer_block {
+    GLuint binding;
+    int offset;         // offset of the block in the uniform buffer
+    int size;
+};
+
+/*
+ * Uniform buffer holding all the uniform blocks of a program, packed
+ * following the layout reported by the GL (std140 or shared)
+ */
+struct uniformbuffer {
+    struct uniformbuffer_field *fields;
+    int nb_fields;
+    struct uniformbuffer_block *blocks;
+    int nb_blocks;
+    uint8_t *data;
+    int data_size;
+    struct bufstream stream;
+};
+
+int ngli_uniformbuffer_init(struct uniformbuffer *s, struct ngl_ctx *ctx,
+                            GLuint program_id, struct hmap *uniforms);
+void ngli_uniformbuffer_update(struct uniformbuffer *s);
+void ngli_uniformbuffer_bind(struct uniformbuffer *s);
+void ngli_uniformbuffer_reset(struct uniformbuffer *s);
+
+#endif /* UNIFORMBUFFER_H */
@@ -0,0 +1,439 @@
+/*
+ * Copyright 2018 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hmap.h"
+#include "log.h"
+#include "nodegl.h"
+#include "nodes.h"
+#include "updatequeue.h"
+#include "utils.h"
+
+extern const struct param_specs ngli_params_specs[];
+
+union param_value {
+    int64_t i64;        // int, bool, i64
+    double dbl;
+    char *str;          // str, select, flags
+    float vec[16];      // vec2, vec3, vec4, mat4
+    int r[2];
+};
+
+struct param_update {
+    struct ngl_node *node;
+    const struct node_param *par;
+    union param_value value;
+    void *data;         // data, or elements of a list addition
+    int size;           // size of data, or number of elements of a list addition
+    int coalescable;
+    struct param_update *next;
+};
+
+static void free_update(struct param_update *u)
+{
+    if (u->par->type == PARAM_TYPE_STR ||
+        u->par->type == PARAM_TYPE_SELECT ||
+        u->par->type == PARAM_TYPE_FLAGS)
+        free(u->value.str);
+    if (u->par->type == PARAM_TYPE_NODELIST) {
+        struct ngl_node **elems = u->data;
+        for (int i = 0; i < u->size; i++)
+            ngl_node_unrefp(&elems[i]);
+    }
+    free(u->data);
+    free(u);
+}
+
+static int read_value(struct param_update *u, va_list *ap)
+{
+    const struct node_param *par = u->par;
+
+    switch (par->type) {
+        case PARAM_TYPE_SELECT:
+        case PARAM_TYPE_FLAGS:
+        case PARAM_TYPE_STR:
+            u->value.str = ngli_strdup(va_arg(*ap, const char *));
+            if (!u->value.str)
+                return -1;
+            if (par->type != PARAM_TYPE_STR) {
+                /* Checked now since the update is applied asynchronously */
+                int v;
+                int ret = par->type == PARAM_TYPE_SELECT
+                        ? ngli_params_get_select_val(par->choices->consts, u->value.str, &v)
+                        : ngli_params_get_flags_val(par->choices->consts, u->value.str, &v);
+                if (ret < 0) {
+                    LOG(ERROR, "unrecognized constant \"%s\" for option %s", u->value.str, par->key);
+                    return ret;
+                }
+            }
+            break;
+        case PARAM_TYPE_BOOL:
+        case PARAM_TYPE_INT:
+            u->value.i64 = va_arg(*ap, int);
+            break;
+        case PARAM_TYPE_I64:
+            u->value.i64 = va_arg(*ap, int64_t);
+            break;
+        case PARAM_TYPE_DBL:
+            u->value.dbl = va_arg(*ap, double);
+            break;
+        case PARAM_TYPE_DATA: {
+            const int size = va_arg(*ap, int);
+            const void *data = va_arg(*ap, const void *);
+            if (data && size > 0) {
+                u->data = malloc(size);
+                if (!u->data)
+                    return -1;
+                memcpy(u->data, data, size);
+                u->size = size;
+            }
+            break;
+        }
+        case PARAM_TYPE_VEC2:
+        case PARAM_TYPE_VEC3:
+        case PARAM_TYPE_VEC4:
+        case PARAM_TYPE_MAT4: {
+            const float *v = va_arg(*ap, const float *);
+            memcpy(u->value.vec, v, ngli_params_specs[par->type].size);
+            break;
+        }
+        case PARAM_TYPE_RATIONAL:
+            u->value.r[0] = va_arg(*ap, int);
+            u->value.r[1] = va_arg(*ap, int);
+            break;
+        default:
+            LOG(ERROR, "%s of type %s can not be queued, "
+                "the graph topology must be changed with ngl_patch_scene()",
+                par->key, ngli_params_specs[par->type].name);
+            return -1;
+    }
+    return 0;
+}
+
+static int apply_update(struct param_update *u)
+{
+    struct ngl_node *node = u->node;
+    const struct node_param *par = u->par;
+    const union param_value *v = &u->value;
+
+    switch (par->type) {
+        case PARAM_TYPE_SELECT:
+        case PARAM_TYPE_FLAGS:
+        case PARAM_TYPE_STR:      return ngl_node_param_set(node, par->key, v->str);
+        case PARAM_TYPE_BOOL:
+        case PARAM_TYPE_INT:      return ngl_node_param_set(node, par->key, (int)v->i64);
+        case PARAM_TYPE_I64:      return ngl_node_param_set(node, par->key, v->i64);
+        case PARAM_TYPE_DBL:      return ngl_node_param_set(node, par->key, v->dbl);
+        case PARAM_TYPE_DATA:     return ngl_node_param_set(node, par->key, u->size, u->data);
+        case PARAM_TYPE_VEC2:
+        case PARAM_TYPE_VEC3:
+        case PARAM_TYPE_VEC4:
+        case PARAM_TYPE_MAT4:     return ngl_node_param_set(node, par->key, v->vec);
+        case PARAM_TYPE_RATIONAL: return ngl_node_param_set(node, par->key, v->r[0], v->r[1]);
+        case PARAM_TYPE_DBLLIST:  return ngl_node_param_add(node, par->key, u->size, u->data);
+        case PARAM_TYPE_NODELIST: {
+            int ret = ngl_node_param_add(node, par->key, u->size, u->data);
+            if (ret < 0)
+                return ret;
+            struct ngl_node **elems = u->data;
+            for (int i = 0; i < u->size; i++) {
+                ret = ngli_node_attach_ctx(elems[i], node->ctx);
+                if (ret < 0)
+                    return ret;
+            }
+            return 0;
+        }
+    }
+    return -1;
+}
+
+static int queue_update(struct ngl_ctx *s, struct param_update *u)
+{
+    struct updatequeue *q = &s->updatequeue;
+    char key[64];
+    int ret = 0;
+
+    if (u->coalescable)
+        snprintf(key, sizeof(key), "%p:%s", u->node, u->par->key);
+
+    pthread_mutex_lock(&q->lock);
+
+    if (u->coalescable) {
+        if (!q->pending) {
+            q->pending = ngli_hmap_create();
+            if (!q->pending) {
+                ret = -1;
+                goto end;
+            }
+        }
+
+        /* Overwrite the value of the pending update, keeping its position */
+        struct param_update *prev = ngli_hmap_get(q->pending, key);
+        if (prev) {
+            NGLI_SWAP(union param_value, prev->value, u->value);
+            NGLI_SWAP(void *, prev->data, u->data);
+            NGLI_SWAP(int, prev->size, u->size);
+            free_update(u);
+            goto end;
+        }
+
+        ret = ngli_hmap_set(q->pending, key, u);
+        if (ret < 0)
+            goto end;
+    }
+
+    if (q->tail)
+        q->tail->next = u;
+    else
+        q->head = u;
+    q->tail = u;
+
+end:
+    pthread_mutex_unlock(&q->lock);
+    return ret;
+}
+
+static struct param_update *create_update(struct ngl_ctx *s, struct ngl_node *node, const char *key)
+{
+    uint8_t *base_ptr;
+    const struct node_param *par = ngli_node_param_find(node, key, &base_ptr);
+    if (!par)
+        return NULL;
+
+    struct param_update *u = calloc(1, sizeof(*u));
+    if (!u)
+        return NULL;
+    u->node = node;
+    u->par = par;
+    return u;
+}
+
+int ngl_queue_param_set(struct ngl_ctx *s, struct ngl_node *node, const char *key, ...)
+{
+    struct param_update *u = create_update(s, node, key);
+    if (!u)
+        return -1;
+    u->coalescable = 1;
+
+    va_list ap;
+    va_start(ap, key);
+    int ret = read_value(u, &ap);
+    va_end(ap);
+    if (ret < 0) {
+        free_update(u);
+        return ret;
+    }
+
+    ret = queue_update(s, u);
+    if (ret < 0)
+        free_update(u);
+    return ret;
+}
+
+int ngl_queue_param_add(struct ngl_ctx *s, struct ngl_node *node, const char *key,
+                        int nb_elems, void *elems)
+{
+    struct param_update *u = create_update(s, node, key);
+    if (!u)
+        return -1;
+
+    int elem_size;
+    if (u->par->type == PARAM_TYPE_NODELIST) {
+        elem_size = sizeof(struct ngl_node *);
+    } else if (u->par->type == PARAM_TYPE_DBLLIST) {
+        elem_size = sizeof(double);
+    } else {
+        LOG(ERROR, "%s.%s is not a list", node->name, key);
+        free_update(u);
+        return -1;
+    }
+
+    if (u->par->type == PARAM_TYPE_NODELIST && u->par->node_types) {
+        struct ngl_node **nodes = elems;
+        for (int i = 0; i < nb_elems; i++) {
+            int j;
+            for (j = 0; u->par->node_types[j] != -1; j++)
+                if (nodes[i]->class->id == u->par->node_types[j])
+                    break;
+            if (u->par->node_types[j] == -1) {
+                LOG(ERROR, "%s (%s) is not an allowed type for %s list",
+                    nodes[i]->name, nodes[i]->class->name, key);
+                free_update(u);
+                return -1;
+            }
+        }
+    }
+
+    if (nb_elems > 0) {
+        u->data = malloc(nb_elems * elem_size);
+        if (!u->data) {
+            free_update(u);
+            return -1;
+        }
+        memcpy(u->data, elems, nb_elems * elem_size);
+        u->size = nb_elems;
+        if (u->par->type == PARAM_TYPE_NODELIST) {
+            struct ngl_node **nodes = u->data;
+            for (int i = 0; i < nb_elems; i++)
+                ngl_node_ref(nodes[i]);
+        }
+    }
+
+    int ret = queue_update(s, u);
+    if (ret < 0)
+        free_update(u);
+    return ret;
+}
+
+int ngli_updatequeue_init(struct updatequeue *q)
+{
+    q->nodes = ngli_hmap_create();
+    if (!q->nodes)
+        return -1;
+    if (pthread_mutex_init(&q->lock, NULL)) {
+        ngli_hmap_freep(&q->nodes);
+        return -1;
+    }
+    return 0;
+}
+
+int ngli_updatequeue_track(struct updatequeue *q, struct ngl_node *node)
+{
+    char key[32];
+    snprintf(key, sizeof(key), "%p", node);
+    return ngli_hmap_set(q->nodes, key, node);
+}
+
+void ngli_updatequeue_untrack(struct updatequeue *q, const struct ngl_node *node)
+{
+    char key[32];
+    snprintf(key, sizeof(key), "%p", node);
+    ngli_hmap_set(q->nodes, key, NULL);
+}
+
+/* The node pointer is only compared, the node may have been released */
+static int is_tracked(const struct updatequeue *q, const struct ngl_node *node)
+{
+    char key[32];
+    snprintf(key, sizeof(key), "%p", node);
+    return ngli_hmap_get(q->nodes, key) == node;
+}
+
+/* Drop the updates of the nodes not attached to the context anymore */
+static struct param_update *drop_untracked(struct updatequeue *q, struct param_update *u,
+                                           struct param_update **tailp)
+{
+    struct param_update *head = NULL, *tail = NULL;
+    int nb_dropped = 0;
+
+    while (u) {
+        struct param_update *next = u->next;
+        if (is_tracked(q, u->node)) {
+            u->next = NULL;
+            if (tail)
+                tail->next = u;
+            else
+                head = u;
+            tail = u;
+        } else {
+            if (u->coalescable && q->pending) {
+                char key[64];
+                snprintf(key, sizeof(key), "%p:%s", u->node, u->par->key);
+                ngli_hmap_set(q->pending, key, NULL);
+            }
+            free_update(u);
+            nb_dropped++;
+        }
+        u = next;
+    }
+    if (nb_dropped)
+        LOG(WARNING, "%d queued updates dropped, their nodes are not part of the scene", nb_dropped);
+    if (tailp)
+        *tailp = tail;
+    return head;
+}
+
+/*
+ * Must be called after nodes are detached from the context and before new
+ * ones are attached: a new node could otherwise get the address of a
+ * released one with a pending update.
+ */
+void ngli_updatequeue_purge(struct ngl_ctx *s)
+{
+    struct updatequeue *q = &s->updatequeue;
+
+    pthread_mutex_lock(&q->lock);
+    q->head = drop_untracked(q, q->head, &q->tail);
+    pthread_mutex_unlock(&q->lock);
+}
+
+int ngli_updatequeue_apply(struct ngl_ctx *s)
+{
+    struct updatequeue *q = &s->updatequeue;
+
+    /* Take the whole batch so the producers are never blocked while it is applied */
+    pthread_mutex_lock(&q->lock);
+    struct param_update *u = q->head;
+    q->head = q->tail = NULL;
+    ngli_hmap_freep(&q->pending);
+    pthread_mutex_unlock(&q->lock);
+
+    /* Validated before applying since list additions attach new nodes */
+    u = drop_untracked(q, u, NULL);
+
+    /*
+     * The values are validated when queued, an update can still fail here
+     * (allocation, initialization of added nodes) but it does not prevent
+     * the other ones from being applied
+     */
+    int nb_updates = 0;
+    while (u) {
+        struct param_update *next = u->next;
+        int ret = apply_update(u);
+        if (ret < 0)
+            LOG(ERROR, "unable to apply the queued update of %s.%s",
+                u->node->name, u->par->key);
+        nb_updates++;
+        free_update(u);
+        u = next;
+    }
+    if (nb_updates)
+        LOG(DEBUG, "%d queued parameter updates applied", nb_updates);
+    return nb_updates;
+}
+
+void ngli_updatequeue_reset(struct updatequeue *q)
+{
+    struct param_update *u = q->head;
+    while (u) {
+        struct param_update *next = u->next;
+        free_update(u);
+        u = next;
+    }
+    q->head = q->tail = NULL;
+    ngli_hmap_freep(&q->pending);
+    ngli_hmap_freep(&q->nodes);
+    pthread_mutex_destroy(&q->lock);
+}
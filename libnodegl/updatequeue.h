@@ -0,0 +1,58 @@
+/*
+ * Copyright 2018 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef UPDATEQUEUE_H
+#define UPDATEQUEUE_H
+
+#include <pthread.h>
+
+struct hmap;
+struct ngl_ctx;
+struct ngl_node;
+struct param_update;
+
+/*
+ * Parameter updates queued from any thread and applied by the rendering
+ * thread at the beginning of the next frame. Repeated writes to the same
+ * parameter before the queue is applied are coalesced into one update.
+ *
+ * The producers never access the state of the target node: the rendering
+ * thread checks it against the nodes attached to the context before applying
+ * an update, and drops the updates of the nodes detached in the meantime
+ * before attaching new ones.
+ */
+struct updatequeue {
+    pthread_mutex_t lock;
+    struct param_update *head;
+    struct param_update *tail;
+    struct hmap *pending;   // node pointer and parameter key -> pending update
+    struct hmap *nodes;     // node pointer -> node attached to the context (rendering thread only)
+};
+
+int ngli_updatequeue_init(struct updatequeue *q);
+int ngli_updatequeue_track(struct updatequeue *q, struct ngl_node *node);
+void ngli_updatequeue_untrack(struct updatequeue *q, const struct ngl_node *node);
+void ngli_updatequeue_purge(struct ngl_ctx *s);
+/* Return the number of updates applied, a failing update does not stop the others */
+int ngli_updatequeue_apply(struct ngl_ctx *s);
+void ngli_updatequeue_reset(struct updatequeue *q);
+
+#endif /* UPDATEQUEUE_H */
@@ -20,9 +20,13 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <sys/time.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 #include <GLFW/glfw3.h>
+#include <nodegl.h>
 
 #include "common.h"
 
@@ -69,3 +73,15 @@ GLFWwindow *get_window(const char *title, int width, int height)
     glfwMakeContextCurrent(window);
     return window;
 }
+
+struct ngl_node *load_scene(const char *filename)
+{
+    int fd = open(filename, O_RDONLY);
+    if (fd == -1)
+        return NULL;
+
+    struct ngl_node *scene = ngl_node_deserialize_fd(fd);
+
+    close(fd);
+    return scene;
+}
@@ -26,6 +26,7 @@
 #include <stdint.h>
 
 #include <GLFW/glfw3.h>
+#include <nodegl.h>
 
 int64_t gettime(void);
 double clipd(double v, double min, double max);
@@ -33,4 +34,6 @@ double clipd(double v, double min, double max);
 int init_glfw(void);
 GLFWwindow *get_window(const char *title, int width, int height);
 
+struct ngl_node *load_scene(const char *filename);
+
 #endif
@@ -0,0 +1,302 @@
+/*
+ * Copyright 2018 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include <nodegl.h>
+
+#include "common.h"
+
+struct bench {
+    int nb_frames;
+    int64_t frame_time;
+    int64_t frame_time_min;
+    int64_t frame_time_max;
+    int64_t visit_time;
+    int64_t prefetch_time;
+    int64_t update_time;
+    int64_t draw_time;
+    int64_t gpu_time;
+    int nb_gpu_frames;
+    int64_t nb_draw_calls;
+    int64_t nb_dispatches;
+    int has_gl_stats;
+    int64_t nb_gl_calls;
+    int64_t upload_bytes;
+    int64_t readback_bytes;
+    int nb_gl_funcs;
+    struct ngl_gl_call_stats gl_funcs[256];
+    struct ngl_memory_stats memory;
+};
+
+static void accumulate_stats(struct bench *b, const struct ngl_stats *stats)
+{
+    b->frame_time    += stats->frame_time;
+    b->visit_time    += stats->visit_time;
+    b->prefetch_time += stats->prefetch_time;
+    b->update_time   += stats->update_time;
+    b->draw_time     += stats->draw_time;
+
+    if (!b->nb_frames || stats->frame_time < b->frame_time_min)
+        b->frame_time_min = stats->frame_time;
+    if (!b->nb_frames || stats->frame_time > b->frame_time_max)
+        b->frame_time_max = stats->frame_time;
+
+    int64_t gpu_time = 0;
+    int has_gpu_time = 0;
+    for (int i = 0; i < stats->nb_nodes; i++) {
+        const struct ngl_node_stats *node = &stats->nodes[i];
+        if (node->type == NGL_NODE_RENDER)
+            b->nb_draw_calls += node->nb_draws;
+        else if (node->type == NGL_NODE_COMPUTE)
+            b->nb_dispatches += node->nb_draws;
+        if (node->gpu_time >= 0) {
+            gpu_time += node->gpu_time;
+            has_gpu_time = 1;
+        }
+    }
+    if (has_gpu_time) {
+        b->gpu_time += gpu_time;
+        b->nb_gpu_frames++;
+    }
+
+    b->nb_frames++;
+}
+
+static void accumulate_gl_stats(struct bench *b, const struct ngl_gl_stats *stats)
+{
+    b->has_gl_stats = 1;
+    b->nb_gl_calls    += stats->nb_calls;
+    b->upload_bytes   += stats->upload_bytes;
+    b->readback_bytes += stats->readback_bytes;
+
+    for (int i = 0; i < stats->nb_entries; i++) {
+        const struct ngl_gl_call_stats *entry = &stats->entries[i];
+        struct ngl_gl_call_stats *func = NULL;
+        for (int j = 0; j < b->nb_gl_funcs; j++) {
+            if (!strcmp(b->gl_funcs[j].name, entry->name)) {
+                func = &b->gl_funcs[j];
+                break;
+            }
+        }
+        if (!func) {
+            if (b->nb_gl_funcs == sizeof(b->gl_funcs) / sizeof(*b->gl_funcs))
+                continue;
+            func = &b->gl_funcs[b->nb_gl_funcs++];
+            func->name = entry->name;
+        }
+        func->nb_calls += entry->nb_calls;
+        func->nb_bytes += entry->nb_bytes;
+    }
+}
+
+static void print_json(const struct bench *b, const char *input,
+                       int width, int height, double wall_time)
+{
+    const int n = b->nb_frames ? b->nb_frames : 1;
+
+    printf("{\n");
+    printf("    \"scene\": \"%s\",\n", input);
+    printf("    \"width\": %d,\n", width);
+    printf("    \"height\": %d,\n", height);
+    printf("    \"frames\": %d,\n", b->nb_frames);
+    printf("    \"fps\": %g,\n", wall_time > 0 ? b->nb_frames / wall_time : 0);
+    printf("    \"cpu\": {\n");
+    printf("        \"frame\": %g,\n",     b->frame_time    / (double)n);
+    printf("        \"frame_min\": %" PRId64 ",\n", b->frame_time_min);
+    printf("        \"frame_max\": %" PRId64 ",\n", b->frame_time_max);
+    printf("        \"visit\": %g,\n",     b->visit_time    / (double)n);
+    printf("        \"prefetch\": %g,\n",  b->prefetch_time / (double)n);
+    printf("        \"update\": %g,\n",    b->update_time   / (double)n);
+    printf("        \"draw\": %g\n",       b->draw_time     / (double)n);
+    printf("    },\n");
+    if (b->nb_gpu_frames)
+        printf("    \"gpu\": %g,\n", b->gpu_time / 1000. / b->nb_gpu_frames);
+    else
+        printf("    \"gpu\": null,\n");
+    printf("    \"draw_calls\": %g,\n", b->nb_draw_calls / (double)n);
+    printf("    \"dispatches\": %g,\n", b->nb_dispatches / (double)n);
+    printf("    \"memory\": {\n");
+    printf("        \"budget\": %" PRId64 ",\n",    b->memory.budget);
+    printf("        \"total\": %" PRId64 ",\n",     b->memory.total);
+    printf("        \"peak\": %" PRId64 ",\n",      b->memory.peak);
+    printf("        \"evictions\": %" PRId64 ",\n", b->memory.nb_evictions);
+    printf("        \"pool_hits\": %" PRId64 ",\n", b->memory.pool_hits);
+    printf("        \"pool_misses\": %" PRId64 "\n", b->memory.pool_misses);
+    printf("    },\n");
+    if (b->has_gl_stats) {
+        printf("    \"gl\": {\n");
+        printf("        \"calls\": %g,\n",          b->nb_gl_calls    / (double)n);
+        printf("        \"upload_bytes\": %g,\n",   b->upload_bytes   / (double)n);
+        printf("        \"readback_bytes\": %g,\n", b->readback_bytes / (double)n);
+        printf("        \"functions\": {");
+        for (int i = 0; i < b->nb_gl_funcs; i++) {
+            const struct ngl_gl_call_stats *func = &b->gl_funcs[i];
+            printf("%s\n            \"%s\": {\"calls\": %g, \"bytes\": %g}",
+                   i ? "," : "", func->name,
+                   func->nb_calls / (double)n, func->nb_bytes / (double)n);
+        }
+        printf("\n        }\n");
+        printf("    }\n");
+    } else {
+        printf("    \"gl\": null\n");
+    }
+    printf("}\n");
+}
+
+int main(int argc, char *argv[])
+{
+    int ret = 0;
+    const char *input = NULL;
+    int width = 1280, height = 720;
+    float start = 0.f, duration = 5.f;
+    int freq = 60;
+    int nb_warmup = 30;
+    int64_t memory_budget = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (argv[i][0] == '-' && i < argc - 1) {
+            const char opt = argv[i][1];
+            const char *arg = argv[i + 1];
+            switch (opt) {
+                case 's':
+                    if (sscanf(arg, "%dx%d", &width, &height) != 2) {
+                        fprintf(stderr, "Invalid size format: \"%s\" "
+                                "is not following \"WxH\"\n", arg);
+                        return EXIT_FAILURE;
+                    }
+                    break;
+                case 't':
+                    if (sscanf(arg, "%f:%f:%d", &start, &duration, &freq) != 3 || freq <= 0) {
+                        fprintf(stderr, "Invalid range format: \"%s\" "
+                                "is not following \"start:duration:freq\"\n", arg);
+                        return EXIT_FAILURE;
+                    }
+                    break;
+                case 'w':
+                    nb_warmup = atoi(arg);
+                    break;
+                case 'm':
+                    memory_budget = strtoll(arg, NULL, 0);
+                    break;
+                default:
+                    fprintf(stderr, "Unknown option -%c\n", opt);
+                    return EXIT_FAILURE;
+            }
+            i++;
+        } else if (!input) {
+            input = argv[i];
+        } else {
+            fprintf(stderr, "Unexpected option \"%s\"\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (!input) {
+        fprintf(stderr, "Usage: %s [-s WxH] [-t start:duration:freq] [-w warmup_frames] [-m memory_budget] input.ngl\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (init_glfw() < 0)
+        return EXIT_FAILURE;
+
+    GLFWwindow *window = get_window("ngl-bench", width, height);
+    if (!window) {
+        glfwTerminate();
+        return EXIT_FAILURE;
+    }
+
+    glfwHideWindow(window);
+    glfwSwapInterval(0);
+
+    struct ngl_ctx *ctx = NULL;
+
+    struct ngl_node *scene = load_scene(input);
+    if (!scene) {
+        fprintf(stderr, "Unable to load %s\n", input);
+        ret = EXIT_FAILURE;
+        goto end;
+    }
+
+    ctx = ngl_create();
+    ngl_set_glcontext(ctx, NULL, NULL, NULL, NGL_GLPLATFORM_AUTO, NGL_GLAPI_AUTO);
+    glViewport(0, 0, width, height);
+
+    ret = ngl_set_scene(ctx, scene);
+    ngl_node_unrefp(&scene);
+    if (ret < 0)
+        goto end;
+
+    ngl_set_profiling(ctx, 1);
+    ngl_set_memory_budget(ctx, memory_budget);
+
+    struct ngl_gl_stats gl_stats;
+    const int has_gl_stats = ngl_get_gl_stats(ctx, &gl_stats) == 0;
+
+    struct bench b = {0};
+    const int nb_frames = duration * freq;
+    int64_t bench_start = 0;
+
+    /*
+     * The warmup frames are drawn at the beginning of the range and are not
+     * accounted, they absorb the initial prefetch and shader compilations.
+     */
+    for (int i = -nb_warmup; i < nb_frames; i++) {
+        if (i == 0)
+            bench_start = gettime();
+
+        const double t = start + (i < 0 ? 0 : i) / (double)freq;
+        ret = ngl_draw(ctx, t);
+        if (ret < 0) {
+            fprintf(stderr, "Unable to draw @ t=%g\n", t);
+            goto end;
+        }
+        glfwSwapBuffers(window);
+        glfwPollEvents();
+
+        if (i < 0)
+            continue;
+
+        struct ngl_stats stats;
+        ret = ngl_get_stats(ctx, &stats);
+        if (ret < 0)
+            goto end;
+        accumulate_stats(&b, &stats);
+
+        if (has_gl_stats && ngl_get_gl_stats(ctx, &gl_stats) == 0)
+            accumulate_gl_stats(&b, &gl_stats);
+    }
+
+    const double wall_time = (gettime() - bench_start) / 1000000.;
+    ngl_get_memory_stats(ctx, &b.memory);
+    print_json(&b, input, width, height, wall_time);
+
+end:
+    ngl_free(&ctx);
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+
+    return ret;
+}
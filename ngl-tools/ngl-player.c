@@ -20,6 +20,7 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 
 #include <nodegl.h>
 #include <sxplayer.h>
@@ -139,17 +140,30 @@ static void tick_callback(struct player *p)
 int main(int argc, char *argv[])
 {
     int ret;
+    const char *input = NULL;
+    const char *trace = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--trace") && i < argc - 1) {
+            trace = argv[++i];
+        } else if (!input) {
+            input = argv[i];
+        } else {
+            fprintf(stderr, "Unexpected option \"%s\"\n", argv[i]);
+            return -1;
+        }
+    }
 
-    if (argc < 2) {
-        fprintf(stderr, "Usage: %s <media>\n", argv[0]);
+    if (!input) {
+        fprintf(stderr, "Usage: %s [--trace out.json] <media>\n", argv[0]);
         return -1;
     }
 
-    ret = probe(argv[1]);
+    ret = probe(input);
     if (ret < 0)
         return ret;
 
-    struct ngl_node *scene = get_scene(argv[1]);
+    struct ngl_node *scene = get_scene(input);
     if (!scene)
         return -1;
 
@@ -161,8 +175,16 @@ int main(int argc, char *argv[])
     ngl_node_unrefp(&scene);
     p.tick_callback = tick_callback;
 
+    if (trace && ngl_trace_start() < 0) {
+        fprintf(stderr, "Unable to start tracing, continuing without trace\n");
+        trace = NULL;
+    }
+
     player_main_loop();
 
+    if (trace && ngl_trace_dump(trace) < 0)
+        fprintf(stderr, "Unable to write trace to %s\n", trace);
+
 end:
     player_uninit();
 
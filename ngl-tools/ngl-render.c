@@ -31,35 +31,6 @@
 
 #include "common.h"
 
-static struct ngl_node *get_scene(const char *filename)
-{
-    struct ngl_node *scene = NULL;
-    char *buf = NULL;
-    struct stat st;
-
-    int fd = open(filename, O_RDONLY);
-    if (fd == -1)
-        goto end;
-
-    if (fstat(fd, &st) == -1)
-        goto end;
-
-    buf = malloc(st.st_size + 1);
-    if (!buf)
-        goto end;
-
-    int n = read(fd, buf, st.st_size);
-    buf[n] = 0;
-
-    scene = ngl_node_deserialize(buf);
-
-end:
-    if (fd != -1)
-        close(fd);
-    free(buf);
-    return scene;
-}
-
 struct range {
     float start;
     float duration;
@@ -78,10 +49,13 @@ int main(int argc, char *argv[])
     int show_window = 0;
     int swap_interval = 0;
     int debug = 0;
+    const char *trace = NULL;
 
     for (int i = 1; i < argc; i++) {
         if (!strcmp(argv[i], "-d")) {
             debug = 1;
+        } else if (!strcmp(argv[i], "--trace") && i < argc - 1) {
+            trace = argv[++i];
         } else if (!strcmp(argv[i], "-w")) {
             show_window = 1;
         } else if (argv[i][0] == '-' && i < argc - 1) {
@@ -128,7 +102,7 @@ int main(int argc, char *argv[])
     }
 
     if (!input) {
-        fprintf(stderr, "Usage: %s [-o out.raw] [-s WxH] [-w] [-d] [-z swapinterval] input.ngl\n", argv[0]);
+        fprintf(stderr, "Usage: %s [-o out.raw] [-s WxH] [-w] [-d] [-z swapinterval] [--trace out.json] input.ngl\n", argv[0]);
         return EXIT_FAILURE;
     }
 
@@ -156,7 +130,7 @@ int main(int argc, char *argv[])
     int fd = -1;
     struct ngl_ctx *ctx = NULL;
 
-    struct ngl_node *scene = get_scene(input);
+    struct ngl_node *scene = load_scene(input);
     if (!scene) {
         ret = EXIT_FAILURE;
         goto end;
@@ -188,12 +162,35 @@ int main(int argc, char *argv[])
     if (ret < 0)
         goto end;
 
+    if (trace && ngl_trace_start() < 0) {
+        fprintf(stderr, "Unable to start tracing, continuing without trace\n");
+        trace = NULL;
+    }
+
     for (int i = 0; i < nb_ranges; i++) {
         int k = 0;
         const struct range *r = &ranges[i];
         const float t0 = r->start;
         const float t1 = r->start + r->duration;
 
+        /* Announce the times of the range so the frames are evaluated ahead */
+        int nb_times = 0;
+        while ((float)(t0 + nb_times*1./r->freq) < t1)
+            nb_times++;
+        if (nb_times > 0) {
+            double *times = malloc(nb_times * sizeof(*times));
+            if (!times) {
+                ret = EXIT_FAILURE;
+                goto end;
+            }
+            for (int j = 0; j < nb_times; j++)
+                times[j] = (float)(t0 + j*1./r->freq);
+            ret = ngl_set_draw_times(ctx, times, nb_times);
+            free(times);
+            if (ret < 0)
+                goto end;
+        }
+
         const int64_t start = gettime();
 
         for (;;) {
@@ -218,6 +215,9 @@ int main(int argc, char *argv[])
     }
 
 end:
+    if (trace && ngl_trace_dump(trace) < 0)
+        fprintf(stderr, "Unable to write trace to %s\n", trace);
+
     ngl_free(&ctx);
 
     if (fd != -1)
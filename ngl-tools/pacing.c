@@ -0,0 +1,126 @@
+/*
+ * Copyright 2018 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pacing.h"
+
+#define DEFAULT_REFRESH_RATE 60
+#define PERIOD_TOLERANCE 8      /* only the intervals within period/8 of the period refine it */
+
+void pacing_init(struct pacing *pc, int refresh_rate)
+{
+    memset(pc, 0, sizeof(*pc));
+    if (refresh_rate <= 0)
+        refresh_rate = DEFAULT_REFRESH_RATE;
+    pc->period = 1000000 / refresh_rate;
+    pc->last_vsync = -1;
+}
+
+int64_t pacing_begin_frame(struct pacing *pc, int64_t now)
+{
+    pc->frame_start = now;
+
+    if (pc->last_vsync < 0) {
+        pc->target = now + pc->period;
+        return pc->target;
+    }
+
+    /* Next vsync after now, or a later one if the frame can not make it */
+    const int64_t nb_periods = (now - pc->last_vsync) / pc->period + 1;
+    int64_t target = pc->last_vsync + nb_periods * pc->period;
+    while (now + pc->draw_cost > target)
+        target += pc->period;
+    pc->target = target;
+    return target;
+}
+
+void pacing_end_draw(struct pacing *pc, int64_t now)
+{
+    pc->draw_end = now;
+}
+
+void pacing_end_frame(struct pacing *pc, int64_t now)
+{
+    const int64_t draw_time = pc->draw_end - pc->frame_start;
+
+    pc->nb_frames++;
+    if (draw_time > pc->max_draw_time)
+        pc->max_draw_time = draw_time;
+    const int64_t bucket = draw_time / PACING_HIST_STEP;
+    pc->draw_hist[bucket < PACING_HIST_SIZE ? bucket : PACING_HIST_SIZE - 1]++;
+
+    /* The swap is not part of the cost since it waits for the vsync */
+    pc->draw_cost = pc->nb_frames == 1 ? draw_time : pc->draw_cost + (draw_time - pc->draw_cost) / 8;
+
+    if (pc->last_vsync >= 0) {
+        const int64_t interval = now - pc->last_vsync;
+        int64_t nb_vsyncs = (interval + pc->period / 2) / pc->period;
+        if (nb_vsyncs < 1)
+            nb_vsyncs = 1;
+
+        pc->interval_hist[nb_vsyncs < PACING_MAX_INTERVAL ? nb_vsyncs - 1 : PACING_MAX_INTERVAL - 1]++;
+        pc->nb_dropped += nb_vsyncs - 1;
+        if (now > pc->target + pc->period / 2)
+            pc->nb_late++;
+
+        /*
+         * Only the intervals close to a single vsync refine the period
+         * estimation: a swap returning early (not blocking on the vsync)
+         * would otherwise pull it toward the draw time.
+         */
+        const int64_t error = interval - pc->period;
+        if (llabs(error) <= pc->period / PERIOD_TOLERANCE)
+            pc->period += error / 16;
+    }
+
+    pc->last_vsync = now;
+}
+
+void pacing_print_stats(const struct pacing *pc, FILE *f)
+{
+    if (!pc->nb_frames)
+        return;
+
+    fprintf(f, "Frames: %" PRId64 ", late: %" PRId64 " (%.1f%%), dropped vsyncs: %" PRId64 "\n",
+            pc->nb_frames, pc->nb_late, pc->nb_late * 100. / pc->nb_frames, pc->nb_dropped);
+    fprintf(f, "Estimated refresh rate: %.2fHz, max draw time: %.1fms\n",
+            1000000. / pc->period, pc->max_draw_time / 1000.);
+
+    fprintf(f, "Present intervals:\n");
+    for (int i = 0; i < PACING_MAX_INTERVAL; i++)
+        fprintf(f, "  %d%s vsync%s: %" PRId64 "\n", i + 1,
+                i == PACING_MAX_INTERVAL - 1 ? "+" : "", i ? "s" : "", pc->interval_hist[i]);
+
+    int last = PACING_HIST_SIZE - 1;
+    while (last > 0 && !pc->draw_hist[last])
+        last--;
+    fprintf(f, "Draw time histogram:\n");
+    for (int i = 0; i <= last; i++) {
+        if (i == PACING_HIST_SIZE - 1)
+            fprintf(f, "  %2d+    ms: %" PRId64 "\n", i * PACING_HIST_STEP / 1000, pc->draw_hist[i]);
+        else
+            fprintf(f, "  %2d-%2d ms: %" PRId64 "\n", i * PACING_HIST_STEP / 1000,
+                    (i + 1) * PACING_HIST_STEP / 1000, pc->draw_hist[i]);
+    }
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2018 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef PACING_H
+#define PACING_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define PACING_HIST_STEP 2000   /* draw time histogram bucket size in microseconds */
+#define PACING_HIST_SIZE 17     /* the last bucket gathers the longer draws */
+#define PACING_MAX_INTERVAL 4   /* the last interval bucket gathers the longer intervals */
+
+/*
+ * Frame pacing based on the estimation of the display vsync: every frame is
+ * rendered for the time it is predicted to be presented at, on the vsync grid,
+ * so the content time advances by whole refresh periods. A frame which can
+ * not make it for the next vsync is rendered for the following one, the
+ * skipped vsync showing the previous frame again.
+ */
+struct pacing {
+    int64_t period;         /* estimated vsync period */
+    int64_t last_vsync;     /* estimated time of the last vsync, -1 if unknown */
+    int64_t draw_cost;      /* smoothed cost of a frame, from its start to its swap */
+    int64_t frame_start;
+    int64_t draw_end;
+    int64_t target;         /* predicted present time of the current frame */
+
+    /* jank statistics */
+    int64_t nb_frames;
+    int64_t nb_late;        /* frames presented after their predicted vsync */
+    int64_t nb_dropped;     /* vsyncs without a new frame */
+    int64_t max_draw_time;
+    int64_t draw_hist[PACING_HIST_SIZE];
+    int64_t interval_hist[PACING_MAX_INTERVAL];
+};
+
+void pacing_init(struct pacing *pc, int refresh_rate);
+
+/* Returns the predicted present time of the frame about to be drawn */
+int64_t pacing_begin_frame(struct pacing *pc, int64_t now);
+
+void pacing_end_draw(struct pacing *pc, int64_t now);
+
+/* Must be called as soon as the swap of the frame returns */
+void pacing_end_frame(struct pacing *pc, int64_t now);
+
+void pacing_print_stats(const struct pacing *pc, FILE *f);
+
+#endif
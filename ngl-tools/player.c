@@ -39,7 +39,6 @@ static void key_callback(GLFWwindow *window, int key, int scancode, int action,
             break;
         case GLFW_KEY_SPACE:
             p->paused ^= 1;
-            p->clock_off = gettime() - p->frame_ts;
             break;
         case GLFW_KEY_F: {
             p->fullscreen ^= 1;
@@ -83,19 +82,24 @@ static void size_callback(GLFWwindow *window, int width, int height)
     glViewport(p->view.x, p->view.y, p->view.width, p->view.height);
 }
 
-static void update_time(int64_t seek_at)
+/*
+ * now is the time the frame is going to be presented at: the clock offset is
+ * always based on it, so the pause and the seek are applied here as well
+ */
+static void update_time(int64_t now)
 {
     struct player *p = g_player;
 
-    if (seek_at >= 0) {
-        p->clock_off = gettime() - seek_at;
-        p->frame_ts = seek_at;
-        return;
+    if (p->seek_at >= 0) {
+        p->frame_ts = p->seek_at;
+        p->seek_at = -1;
+        p->clock_off = -1;
     }
 
-    if (!p->paused) {
-        const int64_t now = gettime();
-        if (p->clock_off < 0 || now - p->clock_off > p->duration)
+    if (p->paused || p->clock_off < 0) {
+        p->clock_off = now - p->frame_ts;
+    } else {
+        if (now - p->clock_off > p->duration)
             p->clock_off = now;
 
         p->frame_ts = now - p->clock_off;
@@ -118,7 +122,7 @@ static void mouse_button_callback(GLFWwindow *window, int button, int action, in
         const int64_t seek_at64 = p->duration * pos / p->view.width;
 
         p->lasthover = gettime();
-        update_time(seek_at64);
+        p->seek_at = seek_at64;
     }
 }
 
@@ -146,11 +150,16 @@ int player_init(struct player *p, const char *win_title, struct ngl_node *scene,
     }
 
     p->clock_off = -1;
+    p->seek_at = -1;
     p->lasthover = -1;
     p->width = width;
     p->height = height;
     p->duration = duration * 1000000;
 
+    glfwSwapInterval(1);
+    const GLFWvidmode *mode = glfwGetVideoMode(glfwGetPrimaryMonitor());
+    pacing_init(&p->pacing, mode ? mode->refreshRate : 0);
+
     glfwSetInputMode(p->window, GLFW_STICKY_KEYS, GL_TRUE);
     glfwSetKeyCallback(p->window, key_callback);
     glfwSetMouseButtonCallback(p->window, mouse_button_callback);
@@ -172,6 +181,7 @@ void player_uninit(void)
 {
     struct player *p = g_player;
 
+    pacing_print_stats(&p->pacing, stdout);
     ngl_free(&p->ngl);
     glfwDestroyWindow(p->window);
     glfwTerminate();
@@ -182,9 +192,12 @@ void player_main_loop(void)
     struct player *p = g_player;
 
     do {
-        update_time(-1);
+        const int64_t present_time = pacing_begin_frame(&p->pacing, gettime());
+        update_time(present_time);
         ngl_draw(p->ngl, p->frame_ts / 1000000.0);
+        pacing_end_draw(&p->pacing, gettime());
         glfwSwapBuffers(p->window);
+        pacing_end_frame(&p->pacing, gettime());
         glfwPollEvents();
     } while (glfwGetKey(p->window, GLFW_KEY_ESCAPE) != GLFW_PRESS &&
              glfwWindowShouldClose(p->window) == 0);
@@ -27,6 +27,8 @@
 #include <GLFW/glfw3.h>
 #include <nodegl.h>
 
+#include "pacing.h"
+
 struct player {
 
     GLFWwindow *window;
@@ -43,11 +45,13 @@ struct player {
     struct ngl_ctx *ngl;
     int64_t clock_off;
     int64_t frame_ts;
+    int64_t seek_at;        /* pending seek, applied to the next frame, -1 if none */
     int paused;
     int64_t lasthover;
     int fullscreen;
     int win_info_backup[4];
     void (*tick_callback)(struct player *p);
+    struct pacing pacing;
 };
 
 int player_init(struct player *p, const char *win_title, struct ngl_node *scene,
@@ -76,8 +76,9 @@ class Exporter(QtCore.QObject):
 
         # Draw every frame
         nb_frame = int(duration * fps[0] / fps[1])
-        for i in range(nb_frame):
-            time = i * fps[1] / float(fps[0])
+        times = [i * fps[1] / float(fps[0]) for i in range(nb_frame)]
+        ngl_viewer.set_draw_times(times)
+        for i, time in enumerate(times):
             # FIXME: due to the nature of Python threads, another widget can
             # make another GL context current once the GIL is released, thus we
             # need to make sure this rendering context is the current one
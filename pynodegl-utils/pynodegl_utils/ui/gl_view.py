@@ -63,7 +63,7 @@ class _GLWidget(QtWidgets.QOpenGLWidget):
 
     def set_scene(self, scene):
         self.makeCurrent()
-        self._viewer.set_scene_from_string(scene)
+        self._viewer.patch_scene_from_string(scene)
         self.doneCurrent()
         self.update()
 
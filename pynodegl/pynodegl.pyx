@@ -1,4 +1,8 @@
-from libc.stdlib cimport calloc
+from libc.stdlib cimport calloc, malloc
+from libc.stdint cimport int64_t
+from cpython cimport array
+from cpython.buffer cimport PyObject_CheckBuffer, PyObject_GetBuffer, PyBuffer_Release
+from cpython.buffer cimport PyBUF_ANY_CONTIGUOUS, PyBUF_WRITABLE
 
 cdef extern from "nodegl.h":
     cdef int NGL_LOG_VERBOSE
@@ -18,6 +22,8 @@ cdef extern from "nodegl.h":
     int ngl_node_param_add(ngl_node *node, const char *key,
                            int nb_elems, void *elems)
     int ngl_node_param_set(ngl_node *node, const char *key, ...)
+    int ngl_node_param_set_data(ngl_node *node, const char *key, int size, void *data,
+                                void (*release)(void *opaque), void *opaque)
     char *ngl_node_dot(const ngl_node *node)
     char *ngl_node_serialize(const ngl_node *node)
     ngl_node *ngl_node_deserialize(const char *s)
@@ -36,11 +42,80 @@ cdef extern from "nodegl.h":
 
     cdef struct ngl_ctx
 
+    cdef struct ngl_node_stats:
+        const char *name
+        int type
+        int64_t update_time
+        int64_t update_self_time
+        int64_t draw_time
+        int64_t draw_self_time
+        int64_t gpu_time
+        int nb_updates
+        int nb_draws
+
+    cdef struct ngl_stats:
+        int64_t frame_time
+        int64_t visit_time
+        int64_t prefetch_time
+        int64_t update_time
+        int64_t draw_time
+        int nb_nodes
+        const ngl_node_stats *nodes
+
+    cdef struct ngl_gl_call_stats:
+        const char *name
+        int64_t nb_calls
+        int64_t nb_bytes
+
+    cdef struct ngl_gl_stats:
+        int64_t nb_calls
+        int64_t upload_bytes
+        int64_t readback_bytes
+        int nb_entries
+        const ngl_gl_call_stats *entries
+
+    cdef struct ngl_memory_stats:
+        int64_t budget
+        int64_t total
+        int64_t peak
+        int64_t textures
+        int64_t buffers
+        int64_t renderbuffers
+        int nb_textures
+        int nb_buffers
+        int nb_renderbuffers
+        int64_t nb_evictions
+        int64_t pool_size
+        int nb_pooled
+        int64_t pool_hits
+        int64_t pool_misses
+
+    cdef struct ngl_frame_budget_stats:
+        int64_t budget
+        int nb_deferred
+        int nb_skipped
+        int64_t total_deferred
+        int64_t total_skipped
+        int64_t nb_frames
+        int64_t nb_late_frames
+        int64_t max_frame_time
+
     ngl_ctx *ngl_create()
     int ngl_set_glcontext(ngl_ctx *s, void *display, void *window, void *handle, int platform, int api)
     int ngl_set_scene(ngl_ctx *s, ngl_node *scene)
+    int ngl_patch_scene(ngl_ctx *s, ngl_node *scene)
     int ngl_draw(ngl_ctx *s, double t) nogil
+    int ngl_read_pixels(ngl_ctx *s, int x, int y, int width, int height, void *dst) nogil
+    int ngl_set_draw_times(ngl_ctx *s, const double *times, int nb_times)
     char *ngl_dot(ngl_ctx *s, double t) nogil
+    int ngl_set_profiling(ngl_ctx *s, int enable)
+    int ngl_get_stats(ngl_ctx *s, ngl_stats *stats)
+    int ngl_get_gl_stats(ngl_ctx *s, ngl_gl_stats *stats)
+    int ngl_set_memory_budget(ngl_ctx *s, int64_t budget)
+    int ngl_set_resource_pool_size(ngl_ctx *s, int64_t max_size)
+    int ngl_get_memory_stats(ngl_ctx *s, ngl_memory_stats *stats)
+    int ngl_set_frame_budget(ngl_ctx *s, int64_t budget, int skip)
+    int ngl_get_frame_budget_stats(ngl_ctx *s, ngl_frame_budget_stats *stats)
     void ngl_free(ngl_ctx **ss)
 
 GLPLATFORM_AUTO = NGL_GLPLATFORM_AUTO
@@ -66,6 +141,35 @@ cdef _ret_pystr(char *s):
         free(s)
     return pystr
 
+cdef void _release_buffer(void *opaque) with gil:
+    cdef Py_buffer *view = <Py_buffer *>opaque
+    PyBuffer_Release(view)
+    free(view)
+
+cdef _set_data(ngl_node *node, const char *key, data):
+    cdef array.array arr
+    cdef Py_buffer *view
+
+    # array.array does not implement the buffer protocol with Python 2, so
+    # its content is copied
+    if not PyObject_CheckBuffer(data):
+        arr = data
+        return ngl_node_param_set(node, key,
+                                  <int>(arr.buffer_info()[1] * arr.itemsize),
+                                  <void *>arr.data.as_voidptr)
+
+    # Any other object exposing a contiguous buffer (numpy array, memoryview,
+    # ...) is borrowed without copy until the nodes release it
+    view = <Py_buffer *>malloc(sizeof(Py_buffer))
+    if view is NULL:
+        raise MemoryError()
+    try:
+        PyObject_GetBuffer(data, view, PyBUF_ANY_CONTIGUOUS)
+    except:
+        free(view)
+        raise
+    return ngl_node_param_set_data(node, key, <int>view.len, view.buf, _release_buffer, view)
+
 include "nodes_def.pyx"
 
 def log_set_min_level(int level):
@@ -91,15 +195,142 @@ cdef class Viewer:
         ngl_node_unrefp(&scene)
         return ret
 
+    def patch_scene_from_string(self, s):
+        cdef ngl_node *scene = ngl_node_deserialize(s);
+        ret = ngl_patch_scene(self.ctx, scene)
+        ngl_node_unrefp(&scene)
+        return ret
+
     def draw(self, double t):
         with nogil:
             ngl_draw(self.ctx, t)
 
+    def read_pixels(self, dst, int width, int height, int x=0, int y=0):
+        cdef Py_buffer view
+        cdef int ret
+        PyObject_GetBuffer(dst, &view, PyBUF_ANY_CONTIGUOUS | PyBUF_WRITABLE)
+        try:
+            if view.len < width * height * 4:
+                raise ValueError('destination buffer too small for a %dx%d RGBA frame' % (width, height))
+            with nogil:
+                ret = ngl_read_pixels(self.ctx, x, y, width, height, view.buf)
+        finally:
+            PyBuffer_Release(&view)
+        return ret
+
+    def set_draw_times(self, times):
+        cdef int nb_times = len(times)
+        cdef double *c_times = <double *>malloc(nb_times * sizeof(double))
+        if c_times is NULL:
+            raise MemoryError()
+        for i, t in enumerate(times):
+            c_times[i] = t
+        ret = ngl_set_draw_times(self.ctx, c_times, nb_times)
+        free(c_times)
+        return ret
+
     def dot(self, double t):
         cdef char *s;
         with nogil:
             s = ngl_dot(self.ctx, t)
         return _ret_pystr(s) if s else None
 
+    def set_profiling(self, bint enable):
+        return ngl_set_profiling(self.ctx, enable)
+
+    def get_stats(self):
+        cdef ngl_stats stats
+        if ngl_get_stats(self.ctx, &stats) < 0:
+            return None
+        nodes = []
+        cdef const ngl_node_stats *entry
+        cdef int i
+        for i in range(stats.nb_nodes):
+            entry = &stats.nodes[i]
+            nodes.append({
+                'name': <bytes>entry.name if entry.name else None,
+                'type': entry.type,
+                'update_time': entry.update_time,
+                'update_self_time': entry.update_self_time,
+                'draw_time': entry.draw_time,
+                'draw_self_time': entry.draw_self_time,
+                'gpu_time': entry.gpu_time,
+                'nb_updates': entry.nb_updates,
+                'nb_draws': entry.nb_draws,
+            })
+        return {
+            'frame_time': stats.frame_time,
+            'visit_time': stats.visit_time,
+            'prefetch_time': stats.prefetch_time,
+            'update_time': stats.update_time,
+            'draw_time': stats.draw_time,
+            'nodes': nodes,
+        }
+
+    def get_gl_stats(self):
+        cdef ngl_gl_stats stats
+        if ngl_get_gl_stats(self.ctx, &stats) < 0:
+            return None
+        calls = {}
+        cdef const ngl_gl_call_stats *entry
+        cdef int i
+        for i in range(stats.nb_entries):
+            entry = &stats.entries[i]
+            calls[<bytes>entry.name] = {
+                'nb_calls': entry.nb_calls,
+                'nb_bytes': entry.nb_bytes,
+            }
+        return {
+            'nb_calls': stats.nb_calls,
+            'upload_bytes': stats.upload_bytes,
+            'readback_bytes': stats.readback_bytes,
+            'calls': calls,
+        }
+
+    def set_memory_budget(self, int64_t budget):
+        return ngl_set_memory_budget(self.ctx, budget)
+
+    def set_resource_pool_size(self, int64_t max_size):
+        return ngl_set_resource_pool_size(self.ctx, max_size)
+
+    def get_memory_stats(self):
+        cdef ngl_memory_stats stats
+        if ngl_get_memory_stats(self.ctx, &stats) < 0:
+            return None
+        return {
+            'budget': stats.budget,
+            'total': stats.total,
+            'peak': stats.peak,
+            'textures': stats.textures,
+            'buffers': stats.buffers,
+            'renderbuffers': stats.renderbuffers,
+            'nb_textures': stats.nb_textures,
+            'nb_buffers': stats.nb_buffers,
+            'nb_renderbuffers': stats.nb_renderbuffers,
+            'nb_evictions': stats.nb_evictions,
+            'pool_size': stats.pool_size,
+            'nb_pooled': stats.nb_pooled,
+            'pool_hits': stats.pool_hits,
+            'pool_misses': stats.pool_misses,
+        }
+
+    def set_frame_budget(self, int64_t budget, int skip=0):
+        return ngl_set_frame_budget(self.ctx, budget, skip)
+
+    def get_frame_budget_stats(self):
+        cdef ngl_frame_budget_stats stats
+        if ngl_get_frame_budget_stats(self.ctx, &stats) < 0:
+            return None
+        return {
+            'budget': stats.budget,
+            'nb_deferred': stats.nb_deferred,
+            'nb_skipped': stats.nb_skipped,
+            'total_deferred': stats.total_deferred,
+            'total_skipped': stats.total_skipped,
+            'nb_frames': stats.nb_frames,
+            'nb_late_frames': stats.nb_late_frames,
+            'max_frame_time': stats.max_frame_time,
+        }
+
     def __dealloc__(self):
         ngl_free(&self.ctx)
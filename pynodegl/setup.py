@@ -359,11 +359,8 @@ cdef class %(class_name)s(%(parent_node)s):
                         'field_type': 'const char *',
                     }
                     class_str += '''
-    def set_%(field_name)s(self, array.array %(field_name)s):
-        return ngl_node_param_set(self.ctx,
-                                  "%(field_name)s",
-                                  <int>(%(field_name)s.buffer_info()[1] * %(field_name)s.itemsize),
-                                  <void *>(%(field_name)s.data.as_voidptr))
+    def set_%(field_name)s(self, %(field_name)s):
+        return _set_data(self.ctx, "%(field_name)s", %(field_name)s)
 
 ''' % field_data
 
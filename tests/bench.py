@@ -0,0 +1,189 @@
+#!/usr/bin/env python
+#
+# Copyright 2018 GoPro Inc.
+#
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+#
+
+import array
+import json
+import math
+import os
+import os.path as op
+import random
+import subprocess
+
+from pynodegl import (
+        AnimKeyFrameBuffer,
+        AnimKeyFrameFloat,
+        AnimKeyFrameVec3,
+        AnimatedBufferVec3,
+        AnimatedFloat,
+        AnimatedVec3,
+        Geometry,
+        Group,
+        Program,
+        Quad,
+        Render,
+        RenderToTexture,
+        Rotate,
+        Texture2D,
+        Translate,
+        UniformFloat,
+        UniformVec4,
+)
+
+from pynodegl_utils.misc import get_frag
+from pynodegl_utils.examples.misc import particules
+
+
+DURATION = 5.
+
+
+def _color_program():
+    return Program(fragment=get_frag('color'))
+
+
+def bench_quads(n=2000):
+    random.seed(0)
+    prog = _color_program()
+    g = Group()
+    size = 2. / math.sqrt(n)
+    for i in range(n):
+        x = random.uniform(-1, 1 - size)
+        y = random.uniform(-1, 1 - size)
+        q = Quad((x, y, 0), (size, 0, 0), (0, size, 0))
+        r = Render(q, prog)
+        r.update_uniforms(color=UniformVec4(value=(random.random(), random.random(), random.random(), 1)))
+        g.add_children(r)
+    return g
+
+
+def bench_transform_chain(depth=500):
+    q = Quad((-.5, -.5, 0), (1, 0, 0), (0, 1, 0))
+    r = Render(q, _color_program())
+    r.update_uniforms(color=UniformVec4(value=(1, .5, 0, 1)))
+    node = r
+    for i in range(depth):
+        if i & 1:
+            animkf = [AnimKeyFrameFloat(0, 0),
+                      AnimKeyFrameFloat(DURATION, 360. / depth)]
+            node = Rotate(node, anim=AnimatedFloat(animkf))
+        else:
+            animkf = [AnimKeyFrameVec3(0, (0, 0, 0)),
+                      AnimKeyFrameVec3(DURATION, (.5 / depth, 0, 0))]
+            node = Translate(node, anim=AnimatedVec3(animkf))
+    return node
+
+
+def bench_uniforms(nb_renders=50, nb_uniforms=64):
+    frag = '#version 100\nprecision mediump float;\n'
+    frag += ''.join('uniform float u%d;\n' % i for i in range(nb_uniforms))
+    frag += 'void main(void)\n{\n    float v = 0.0;\n'
+    frag += ''.join('    v += u%d;\n' % i for i in range(nb_uniforms))
+    frag += '    gl_FragColor = vec4(v / %d.0, 0.0, 0.0, 1.0);\n}\n' % nb_uniforms
+    prog = Program(fragment=frag)
+
+    g = Group()
+    q = Quad((-1, -1, 0), (2, 0, 0), (0, 2, 0))
+    for i in range(nb_renders):
+        r = Render(q, prog)
+        for j in range(nb_uniforms):
+            animkf = [AnimKeyFrameFloat(0, 0),
+                      AnimKeyFrameFloat(DURATION, (i + j) / float(nb_renders + nb_uniforms))]
+            r.update_uniforms(**{'u%d' % j: UniformFloat(anim=AnimatedFloat(animkf))})
+        g.add_children(r)
+    return g
+
+
+def bench_animated_buffer(nb_vertices=300000):
+    random.seed(0)
+    animkf = []
+    for i in range(3):
+        vertices = array.array('f')
+        for j in range(nb_vertices * 3):
+            vertices.append(random.uniform(-1, 1) if j % 3 != 2 else 0)
+        animkf.append(AnimKeyFrameBuffer(i * DURATION / 2., vertices))
+    geom = Geometry(AnimatedBufferVec3(keyframes=animkf))
+    geom.set_draw_mode('points')
+    r = Render(geom, _color_program())
+    r.update_uniforms(color=UniformVec4(value=(1, 1, 1, 1)))
+    return r
+
+
+def bench_rtt_chain(n=16, size=1024):
+    q = Quad((-1, -1, 0), (2, 0, 0), (0, 2, 0))
+    r = Render(q, _color_program())
+    r.update_uniforms(color=UniformVec4(value=(0, .5, 1, 1)))
+    g = Group()
+    prev = r
+    for i in range(n):
+        texture = Texture2D(width=size, height=size)
+        g.add_children(RenderToTexture(prev, texture))
+        prev = Render(q, Program())
+        prev.update_textures(tex0=texture)
+    g.add_children(prev)
+    return g
+
+
+def bench_compute_particles():
+    return particules(particules=1023)['scene']
+
+
+BENCHES = (
+    ('quads', bench_quads),
+    ('transform_chain', bench_transform_chain),
+    ('uniforms', bench_uniforms),
+    ('animated_buffer', bench_animated_buffer),
+    ('rtt_chain', bench_rtt_chain),
+    ('compute_particles', bench_compute_particles),
+)
+
+
+def generate(dirname):
+    if not op.exists(dirname):
+        os.makedirs(dirname)
+    fnames = []
+    for name, func in BENCHES:
+        fname = op.join(dirname, name + '.ngl')
+        open(fname, 'w').write(func().serialize())
+        fnames.append((name, fname))
+    return fnames
+
+
+def run(dirname, output, bench_bin='ngl-bench', bench_args=None):
+    results = []
+    for name, fname in generate(dirname):
+        cmd = [bench_bin, '-t', '0:%g:60' % DURATION] + (bench_args or []) + [fname]
+        data = json.loads(subprocess.check_output(cmd).decode())
+        data['name'] = name
+        results.append(data)
+        print('%-20s cpu:%10.1fus gpu:%10s draws:%6g gl calls:%8s' % (
+              name, data['cpu']['frame'],
+              '%.1fus' % data['gpu'] if data['gpu'] is not None else '-',
+              data['draw_calls'],
+              '%g' % data['gl']['calls'] if data['gl'] is not None else '-'))
+    with open(output, 'w') as f:
+        json.dump({'benchmarks': results}, f, indent=4, sort_keys=True)
+
+
+if __name__ == '__main__':
+    import sys
+    run(sys.argv[1], sys.argv[2],
+        bench_bin=os.environ.get('NGL_BENCH', 'ngl-bench'),
+        bench_args=sys.argv[3:])